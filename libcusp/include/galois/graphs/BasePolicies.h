@@ -65,6 +65,27 @@ public:
   void saveGIDToHost(std::vector<std::pair<uint64_t, uint64_t>>& gid2host) {
     _gid2host = gid2host;
   }
+
+  //! Returns false by default; policies that need to see all of the edges
+  //! this host read before assigning any master should return true
+  bool needsReadSubgraph() const { return false; }
+
+  /**
+   * Called on every edge window of this host's read nodes before master
+   * assignment if needsReadSubgraph returns true. Does nothing by default.
+   *
+   * @param bufGraph Locally read graph; edges of [beginNode, endNode) are
+   * resident
+   * @param beginNode First GID of the window
+   * @param endNode One past the last GID of the window
+   */
+  template <typename EdgeTy>
+  void inspectReadEdges(galois::graphs::BufferedGraph<EdgeTy>&, uint64_t,
+                        uint64_t) {}
+
+  //! Called after all read edges have been inspected and before the first
+  //! getMaster call if needsReadSubgraph returns true. Does nothing by default.
+  void prepareMasters() {}
 };
 
 /**
@@ -66,6 +66,10 @@ using DistGraphPtr =
  * this argument assigns a weight to give each node.
  * @param edgeWeight When using a read policy that involves nodes and edges,
  * this argument assigns a weight to give each edge.
+ * @param cuspStreamEdgeChunk If non-zero, edges are streamed from disk in
+ * windows of at most this many edges instead of reading a host's whole edge
+ * range up front, bounding partitioning memory to the final partition plus
+ * two windows
  *
  * @tparam PartitionPolicy Partitioning policy object that specifies the
  * placement of nodes/edges during partitioning.
@@ -89,7 +93,8 @@ cuspPartitionGraph(std::string graphFile, CUSP_GRAPH_TYPE inputType,
                    uint32_t cuspStateRounds = 100,
                    galois::graphs::MASTERS_DISTRIBUTION readPolicy =
                        galois::graphs::BALANCED_EDGES_OF_MASTERS,
-                   uint32_t nodeWeight = 0, uint32_t edgeWeight = 0) {
+                   uint32_t nodeWeight = 0, uint32_t edgeWeight = 0,
+                   uint64_t cuspStreamEdgeChunk = 0) {
   auto& net = galois::runtime::getSystemNetworkInterface();
   using DistGraphConstructor =
       galois::graphs::NewDistGraphGeneric<NodeData, EdgeData, PartitionPolicy>;
@@ -127,13 +132,15 @@ cuspPartitionGraph(std::string graphFile, CUSP_GRAPH_TYPE inputType,
 
     return std::make_unique<DistGraphConstructor>(
         inputToUse, net.ID, net.Num, cuspAsync, cuspStateRounds, useTranspose,
-        readPolicy, nodeWeight, edgeWeight, masterBlockFile);
+        readPolicy, nodeWeight, edgeWeight, masterBlockFile, false,
+        "local_graph", 1, cuspStreamEdgeChunk);
   } else {
     // symmetric graph path: assume the passed in graphFile is a symmetric
     // graph; output is also symmetric
     return std::make_unique<DistGraphConstructor>(
         graphFile, net.ID, net.Num, cuspAsync, cuspStateRounds, false,
-        readPolicy, nodeWeight, edgeWeight, masterBlockFile);
+        readPolicy, nodeWeight, edgeWeight, masterBlockFile, false,
+        "local_graph", 1, cuspStreamEdgeChunk);
   }
 }
 } // end namespace galois
@@ -3,9 +3,11 @@
 
 #include "DistributedGraph.h"
 #include "BasePolicies.h"
+#include <algorithm>
 #include <utility>
 #include <cmath>
 #include <limits>
+#include <vector>
 
 class NoCommunication : public galois::graphs::ReadMasterAssignment {
 public:
@@ -905,4 +907,613 @@ public:
   }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Multi-level edge-cut policy. Unlike the streaming policies above, it first
+ * collects the subgraph this host read and partitions it METIS style:
+ * coarsen by heavy-edge matching, assign the coarsest graph greedily, then
+ * refine with parallel label propagation while uncoarsening. It costs an
+ * extra pass over the read edges and memory for the hierarchy in exchange
+ * for fewer cut edges (and therefore fewer mirrors).
+ *
+ * Edges to nodes read by other hosts become edges to fixed "anchor" vertices
+ * (one per host) so that nodes gravitate to the host holding their remote
+ * neighbors. A host keeps its nodes by default and gives away at most
+ * _imbalance / (numHosts - 1) of its load to each other host, so every host
+ * ends up within (1 + _imbalance) of the load it read.
+ */
+class MultilevelP : public galois::graphs::CustomMasterAssignment {
+  //! Graph of one level of the hierarchy. Destinations >= numNodes are
+  //! anchors: (dst - numNodes) is the host the anchor stands for.
+  struct LevelGraph {
+    uint32_t numNodes = 0;
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> dsts;
+    std::vector<uint32_t> edgeWeights;
+    std::vector<uint64_t> nodeWeights;
+    //! node on the next coarser level that each node of this level maps to
+    std::vector<uint32_t> toCoarse;
+  };
+
+  using PartWeights = std::vector<galois::CopyableAtomic<uint64_t>>;
+  using Parts       = std::vector<galois::CopyableAtomic<uint32_t>>;
+
+  //! fraction of this host's load it may give away to other hosts
+  double _imbalance;
+  //! coarsening stops once a level has at most this many nodes
+  uint32_t _coarsenTo;
+  //! max label propagation sweeps per level
+  uint32_t _refineIterations;
+
+  //! first node read by this host
+  uint64_t _readBegin = 0;
+  //! slot offsets of each read node into _readDsts/_readWeights
+  std::vector<uint64_t> _readOffsets;
+  //! local neighbors (ids relative to _readBegin) or anchors of read nodes
+  std::vector<uint32_t> _readDsts;
+  //! weights of _readDsts (anchor edges are aggregated per host)
+  std::vector<uint32_t> _readWeights;
+  //! number of used slots of each read node
+  std::vector<uint32_t> _readLengths;
+  //! master chosen for each read node
+  std::vector<uint32_t> _assignment;
+
+  //! Returns the host that read a node; read blocks are contiguous and in
+  //! host order so a binary search suffices
+  uint32_t readerOf(uint64_t gid) const {
+    auto it = std::upper_bound(
+        _gid2host.begin(), _gid2host.end(), gid,
+        [](uint64_t g, const std::pair<uint64_t, uint64_t>& block) {
+          return g < block.second;
+        });
+    assert(it != _gid2host.end());
+    return std::distance(_gid2host.begin(), it);
+  }
+
+  /**
+   * Builds the finest (symmetrized) level from the collected read edges.
+   */
+  void buildFinestLevel(LevelGraph& level) {
+    uint32_t numRead = _readLengths.size();
+    level.numNodes   = numRead;
+    level.nodeWeights.resize(numRead);
+
+    std::vector<galois::CopyableAtomic<uint64_t>> cursors(numRead);
+    galois::do_all(
+        galois::iterate(0u, numRead), [&](uint32_t n) { cursors[n] = 0; },
+        galois::no_stats());
+    galois::do_all(
+        galois::iterate(0u, numRead),
+        [&](uint32_t n) {
+          uint64_t slot = _readOffsets[n];
+          galois::atomicAdd(cursors[n], (uint64_t)_readLengths[n]);
+          for (uint32_t i = 0; i < _readLengths[n]; i++) {
+            uint32_t dst = _readDsts[slot + i];
+            if (dst < numRead) {
+              galois::atomicAdd(cursors[dst], (uint64_t)1);
+            }
+          }
+          // edge cut: a node brings itself and its out-edges to its master
+          level.nodeWeights[n] = 1 + _readOffsets[n + 1] - slot;
+        },
+        galois::steal(), galois::no_stats());
+
+    level.offsets.resize(numRead + 1);
+    level.offsets[0] = 0;
+    for (uint32_t n = 0; n < numRead; n++) {
+      level.offsets[n + 1] = level.offsets[n] + cursors[n];
+      cursors[n]           = level.offsets[n];
+    }
+    level.dsts.resize(level.offsets[numRead]);
+    level.edgeWeights.resize(level.offsets[numRead]);
+
+    galois::do_all(
+        galois::iterate(0u, numRead),
+        [&](uint32_t n) {
+          uint64_t slot = _readOffsets[n];
+          for (uint32_t i = 0; i < _readLengths[n]; i++) {
+            uint32_t dst = _readDsts[slot + i];
+            uint32_t w   = _readWeights[slot + i];
+            uint64_t pos = cursors[n].fetch_add(1);
+            level.dsts[pos]        = dst;
+            level.edgeWeights[pos] = w;
+            if (dst < numRead) {
+              pos                    = cursors[dst].fetch_add(1);
+              level.dsts[pos]        = n;
+              level.edgeWeights[pos] = w;
+            }
+          }
+        },
+        galois::steal(), galois::no_stats());
+  }
+
+  //! Orders edges by weight; ties are broken by a hash of the endpoints that
+  //! both endpoints agree on, so the heaviest edge around a node is unique
+  static uint64_t edgeRank(uint32_t weight, uint32_t a, uint32_t b) {
+    uint32_t lo = std::min(a, b);
+    uint32_t hi = std::max(a, b);
+    uint32_t h  = (lo * 2654435761u) ^ (hi * 0x9e3779b9u);
+    return ((uint64_t)weight << 32) | h;
+  }
+
+  //! Pull of part p on a node connected to it by conn edge weight. Pull
+  //! toward hosts with a higher id is halved: two hosts that each read half
+  //! of a cluster would otherwise both hand their half to the other.
+  uint64_t pull(uint64_t conn, uint32_t p) const {
+    return p > _hostID ? conn / 2 : conn;
+  }
+
+  /**
+   * Heavy-edge matching: every unmatched node proposes to the unmatched
+   * neighbor it shares its highest ranked edge with and mutual proposals are
+   * matched. Since the ranking is consistent on both endpoints, the highest
+   * ranked remaining edge is always matched, so every round makes progress.
+   *
+   * @returns partner of each node (itself if unmatched)
+   */
+  std::vector<uint32_t> matchHeavyEdges(const LevelGraph& fine,
+                                        uint64_t maxNodeWeight) {
+    constexpr uint32_t unmatched   = std::numeric_limits<uint32_t>::max();
+    constexpr unsigned matchRounds = 8;
+    uint32_t n                     = fine.numNodes;
+    std::vector<uint32_t> match(n, unmatched);
+    std::vector<uint32_t> proposal(n);
+
+    for (unsigned round = 0; round < matchRounds; round++) {
+      galois::GAccumulator<uint32_t> matched;
+      galois::do_all(
+          galois::iterate(0u, n),
+          [&](uint32_t v) {
+            proposal[v] = v;
+            if (match[v] != unmatched) {
+              return;
+            }
+            uint64_t bestRank = 0;
+            for (uint64_t e = fine.offsets[v]; e < fine.offsets[v + 1]; e++) {
+              uint32_t u = fine.dsts[e];
+              if (u >= n || u == v || match[u] != unmatched ||
+                  fine.nodeWeights[u] + fine.nodeWeights[v] > maxNodeWeight) {
+                continue;
+              }
+              uint64_t rank = edgeRank(fine.edgeWeights[e], u, v);
+              if (rank > bestRank) {
+                bestRank    = rank;
+                proposal[v] = u;
+              }
+            }
+          },
+          galois::steal(), galois::no_stats());
+      galois::do_all(
+          galois::iterate(0u, n),
+          [&](uint32_t v) {
+            uint32_t u = proposal[v];
+            if (match[v] == unmatched && u != v && proposal[u] == v) {
+              match[v] = u;
+              matched += 1;
+            }
+          },
+          galois::no_stats());
+      if (matched.reduce() == 0) {
+        break;
+      }
+    }
+
+    galois::do_all(
+        galois::iterate(0u, n),
+        [&](uint32_t v) {
+          if (match[v] == unmatched) {
+            match[v] = v;
+          }
+        },
+        galois::no_stats());
+    return match;
+  }
+
+  /**
+   * Contracts matched pairs of a level into the next coarser level.
+   */
+  void coarsen(LevelGraph& fine, LevelGraph& coarse, uint64_t maxNodeWeight) {
+    uint32_t n                  = fine.numNodes;
+    std::vector<uint32_t> match = matchHeavyEdges(fine, maxNodeWeight);
+
+    // the smaller id of a pair leads it; number leaders in order
+    fine.toCoarse.resize(n);
+    std::vector<uint32_t> leaders;
+    for (uint32_t v = 0; v < n; v++) {
+      if (match[v] >= v) {
+        fine.toCoarse[v]        = leaders.size();
+        fine.toCoarse[match[v]] = leaders.size();
+        leaders.push_back(v);
+      }
+    }
+
+    uint32_t nc     = leaders.size();
+    coarse.numNodes = nc;
+    coarse.nodeWeights.resize(nc);
+    coarse.offsets.assign(nc + 1, 0);
+
+    using EdgeList = std::vector<std::pair<uint32_t, uint32_t>>;
+    galois::substrate::PerThreadStorage<EdgeList> edgeLists;
+    // gathers the merged edges of a coarse node into a thread local list
+    auto gather = [&](uint32_t c) -> EdgeList& {
+      EdgeList& edges = *edgeLists.getLocal();
+      edges.clear();
+      uint32_t leader = leaders[c];
+      for (uint32_t v : {leader, match[leader]}) {
+        for (uint64_t e = fine.offsets[v]; e < fine.offsets[v + 1]; e++) {
+          uint32_t u  = fine.dsts[e];
+          uint32_t cu = u >= n ? nc + (u - n) : fine.toCoarse[u];
+          if (cu != c) {
+            edges.emplace_back(cu, fine.edgeWeights[e]);
+          }
+        }
+        if (match[leader] == leader) {
+          break;
+        }
+      }
+      std::sort(edges.begin(), edges.end());
+      size_t merged = 0;
+      for (size_t i = 0; i < edges.size(); i++) {
+        if (merged > 0 && edges[merged - 1].first == edges[i].first) {
+          edges[merged - 1].second += edges[i].second;
+        } else {
+          edges[merged++] = edges[i];
+        }
+      }
+      edges.resize(merged);
+      return edges;
+    };
+
+    galois::do_all(
+        galois::iterate(0u, nc),
+        [&](uint32_t c) {
+          uint32_t leader = leaders[c];
+          coarse.nodeWeights[c] =
+              fine.nodeWeights[leader] +
+              (match[leader] != leader ? fine.nodeWeights[match[leader]] : 0);
+          coarse.offsets[c + 1] = gather(c).size();
+        },
+        galois::steal(), galois::no_stats());
+    for (uint32_t c = 0; c < nc; c++) {
+      coarse.offsets[c + 1] += coarse.offsets[c];
+    }
+    coarse.dsts.resize(coarse.offsets[nc]);
+    coarse.edgeWeights.resize(coarse.offsets[nc]);
+    galois::do_all(
+        galois::iterate(0u, nc),
+        [&](uint32_t c) {
+          uint64_t pos = coarse.offsets[c];
+          for (auto& edge : gather(c)) {
+            coarse.dsts[pos]          = edge.first;
+            coarse.edgeWeights[pos++] = edge.second;
+          }
+        },
+        galois::steal(), galois::no_stats());
+  }
+
+  /**
+   * Label propagation refinement: nodes move to the part they are most
+   * connected to if it has room. Moves alternate direction between sweeps
+   * so neighbors do not swap back and forth.
+   */
+  void refine(const LevelGraph& level, Parts& parts, PartWeights& partWeights,
+              const std::vector<uint64_t>& capacities) {
+    uint32_t n = level.numNodes;
+    galois::substrate::PerThreadStorage<std::vector<uint64_t>> connections(
+        _numHosts, 0);
+
+    for (uint32_t sweep = 0; sweep < _refineIterations; sweep++) {
+      galois::GAccumulator<uint64_t> moved;
+      galois::do_all(
+          galois::iterate(0u, n),
+          [&](uint32_t v) {
+            std::vector<uint64_t>& conn = *connections.getLocal();
+            uint32_t current            = parts[v];
+            for (uint64_t e = level.offsets[v]; e < level.offsets[v + 1];
+                 e++) {
+              uint32_t u = level.dsts[e];
+              uint32_t p = u >= n ? u - n : parts[u].load();
+              conn[p] += level.edgeWeights[e];
+            }
+
+            uint32_t best     = current;
+            uint64_t bestPull = pull(conn[current], current);
+            uint64_t w        = level.nodeWeights[v];
+            for (uint32_t p = 0; p < _numHosts; p++) {
+              bool allowed = (sweep % 2 == 0) ? (p > current) : (p < current);
+              if (allowed && pull(conn[p], p) > bestPull &&
+                  partWeights[p] + w <= capacities[p]) {
+                best     = p;
+                bestPull = pull(conn[p], p);
+              }
+            }
+            std::fill(conn.begin(), conn.end(), 0);
+
+            if (best != current) {
+              // capacity may have been taken by a concurrent move
+              if (galois::atomicAdd(partWeights[best], w) + w >
+                  capacities[best]) {
+                galois::atomicSubtract(partWeights[best], w);
+                return;
+              }
+              galois::atomicSubtract(partWeights[current], w);
+              parts[v] = best;
+              moved += 1;
+            }
+          },
+          galois::steal(), galois::no_stats());
+
+      if (moved.reduce() == 0 && sweep % 2 == 1) {
+        break;
+      }
+    }
+  }
+
+  /**
+   * Greedy initial partition of the coarsest level: nodes are visited in
+   * order of how strongly they are pulled to another host and moved there if
+   * that host has room.
+   */
+  void initialPartition(const LevelGraph& level, Parts& parts,
+                        PartWeights& partWeights,
+                        const std::vector<uint64_t>& capacities) {
+    uint32_t n = level.numNodes;
+    std::vector<std::pair<int64_t, uint32_t>> order(n);
+    std::vector<uint64_t> conn(_numHosts, 0);
+    std::vector<uint32_t> bestRemote(n, _hostID);
+
+    for (uint32_t v = 0; v < n; v++) {
+      uint64_t local = 0;
+      for (uint64_t e = level.offsets[v]; e < level.offsets[v + 1]; e++) {
+        uint32_t u = level.dsts[e];
+        if (u >= n) {
+          conn[u - n] += level.edgeWeights[e];
+        } else {
+          local += level.edgeWeights[e];
+        }
+      }
+      uint64_t bestPull = 0;
+      for (uint32_t p = 0; p < _numHosts; p++) {
+        if (pull(conn[p], p) > bestPull) {
+          bestPull      = pull(conn[p], p);
+          bestRemote[v] = p;
+        }
+        conn[p] = 0;
+      }
+      order[v] = std::make_pair((int64_t)local - (int64_t)bestPull, v);
+    }
+    std::sort(order.begin(), order.end());
+
+    for (auto& candidate : order) {
+      uint32_t v = candidate.second;
+      uint32_t p = bestRemote[v];
+      // only nodes pulled harder by a remote host than locally move
+      if (candidate.first >= 0) {
+        break;
+      }
+      if (p != _hostID &&
+          partWeights[p] + level.nodeWeights[v] <= capacities[p]) {
+        partWeights[p] += level.nodeWeights[v];
+        partWeights[_hostID] -= level.nodeWeights[v];
+        parts[v] = p;
+      }
+    }
+  }
+
+  /**
+   * Runs the multi-level partitioner on the collected read subgraph and
+   * saves the resulting master of every read node.
+   */
+  void partitionReadSubgraph() {
+    uint32_t numRead = _readLengths.size();
+    _assignment.assign(numRead, _hostID);
+    if (_numHosts == 1 || numRead == 0) {
+      return;
+    }
+
+    std::vector<LevelGraph> levels(1);
+    buildFinestLevel(levels[0]);
+    // collected edges are in the finest level now
+    std::vector<uint64_t>().swap(_readOffsets);
+    std::vector<uint32_t>().swap(_readDsts);
+    std::vector<uint32_t>().swap(_readWeights);
+    std::vector<uint32_t>().swap(_readLengths);
+
+    uint64_t totalWeight = 0;
+    for (uint64_t w : levels[0].nodeWeights) {
+      totalWeight += w;
+    }
+    std::vector<uint64_t> capacities(
+        _numHosts, (uint64_t)(_imbalance * totalWeight / (_numHosts - 1)));
+    capacities[_hostID] = totalWeight;
+    // keep coarse nodes small enough to still fit in another host's quota
+    uint64_t maxNodeWeight = std::max(capacities[(_hostID + 1) % _numHosts] / 4,
+                                      (uint64_t)2);
+
+    galois::StatTimer coarsenTimer("MultilevelCoarsening", "dGraph_Generic");
+    coarsenTimer.start();
+    while (levels.back().numNodes > _coarsenTo) {
+      LevelGraph coarse;
+      coarsen(levels.back(), coarse, maxNodeWeight);
+      // stop once matching no longer shrinks the graph much
+      if (coarse.numNodes > 0.95 * levels.back().numNodes) {
+        break;
+      }
+      levels.emplace_back(std::move(coarse));
+    }
+    coarsenTimer.stop();
+    size_t numLevels = levels.size();
+
+    galois::StatTimer refineTimer("MultilevelRefinement", "dGraph_Generic");
+    refineTimer.start();
+    PartWeights partWeights(_numHosts);
+    for (uint32_t p = 0; p < _numHosts; p++) {
+      partWeights[p] = 0;
+    }
+    partWeights[_hostID] = totalWeight;
+
+    Parts parts(levels.back().numNodes);
+    for (auto& p : parts) {
+      p = _hostID;
+    }
+    initialPartition(levels.back(), parts, partWeights, capacities);
+    refine(levels.back(), parts, partWeights, capacities);
+
+    // project each level's parts to the finer level, then refine it
+    for (size_t l = levels.size() - 1; l > 0; l--) {
+      LevelGraph& fine = levels[l - 1];
+      Parts fineParts(fine.numNodes);
+      galois::do_all(
+          galois::iterate(0u, fine.numNodes),
+          [&](uint32_t v) { fineParts[v] = parts[fine.toCoarse[v]].load(); },
+          galois::no_stats());
+      parts = std::move(fineParts);
+      levels.pop_back();
+      refine(levels.back(), parts, partWeights, capacities);
+    }
+    refineTimer.stop();
+
+    LevelGraph& finest = levels[0];
+    galois::GAccumulator<uint64_t> cutWeight;
+    galois::GAccumulator<uint64_t> totalEdgeWeight;
+    galois::do_all(
+        galois::iterate(0u, numRead),
+        [&](uint32_t v) {
+          _assignment[v] = parts[v];
+          for (uint64_t e = finest.offsets[v]; e < finest.offsets[v + 1];
+               e++) {
+            uint32_t u = finest.dsts[e];
+            uint32_t p = u >= numRead ? u - numRead : parts[u].load();
+            totalEdgeWeight += finest.edgeWeights[e];
+            if (p != parts[v]) {
+              cutWeight += finest.edgeWeights[e];
+            }
+          }
+        },
+        galois::no_stats());
+
+    galois::gPrint("[", _hostID, "] Multilevel partitioning: ", numLevels,
+                   " levels, ", cutWeight.reduce(), " of ",
+                   totalEdgeWeight.reduce(), " read edge weight cut, ",
+                   partWeights[_hostID].load(), " of ", totalWeight,
+                   " read load kept\n");
+    galois::runtime::reportStat_Tsum("dGraph_Generic",
+                                     "MultilevelReadEdgeWeightCut",
+                                     cutWeight.reduce());
+    galois::runtime::reportStat_Tmax("dGraph_Generic", "MultilevelLevels",
+                                     numLevels);
+  }
+
+public:
+  MultilevelP(uint32_t hostID, uint32_t numHosts, uint64_t numNodes,
+              uint64_t numEdges)
+      : galois::graphs::CustomMasterAssignment(hostID, numHosts, numNodes,
+                                               numEdges) {
+    _imbalance        = 0.1;
+    _coarsenTo        = 64 * numHosts;
+    _refineIterations = 8;
+  }
+
+  //! Collecting the read subgraph is what makes this policy multi-level
+  bool needsReadSubgraph() const { return true; }
+
+  /**
+   * Saves the edges of read nodes [beginNode, endNode): edges to other read
+   * nodes as is, edges to other hosts' nodes aggregated per host.
+   */
+  template <typename EdgeTy>
+  void inspectReadEdges(galois::graphs::BufferedGraph<EdgeTy>& bufGraph,
+                        uint64_t beginNode, uint64_t endNode) {
+    uint64_t readBegin = _gid2host[_hostID].first;
+    uint64_t readEnd   = _gid2host[_hostID].second;
+    uint32_t numRead   = readEnd - readBegin;
+    if (numRead == 0) {
+      return;
+    }
+    // first window: size buffers for all read edges
+    if (_readLengths.empty()) {
+      _readBegin = readBegin;
+      _readOffsets.resize(numRead + 1);
+      uint64_t edgeBase = *bufGraph.edgeBegin(readBegin);
+      galois::do_all(
+          galois::iterate(readBegin, readEnd),
+          [&](uint64_t n) {
+            _readOffsets[n - readBegin + 1] = *bufGraph.edgeEnd(n) - edgeBase;
+          },
+          galois::no_stats());
+      _readOffsets[0] = 0;
+      _readDsts.resize(_readOffsets[numRead]);
+      _readWeights.resize(_readOffsets[numRead]);
+      _readLengths.resize(numRead);
+    }
+
+    galois::substrate::PerThreadStorage<std::vector<uint32_t>> remoteCounts(
+        _numHosts, 0);
+    galois::do_all(
+        galois::iterate(beginNode, endNode),
+        [&](uint64_t src) {
+          std::vector<uint32_t>& counts = *remoteCounts.getLocal();
+          uint32_t lsrc                 = src - readBegin;
+          uint64_t slot                 = _readOffsets[lsrc];
+          uint32_t length               = 0;
+          auto ee                       = bufGraph.edgeEnd(src);
+          for (auto ii = bufGraph.edgeBegin(src); ii < ee; ++ii) {
+            uint64_t dst = bufGraph.edgeDestination(*ii);
+            if (dst >= readBegin && dst < readEnd) {
+              if (dst != src) {
+                _readDsts[slot + length]      = dst - readBegin;
+                _readWeights[slot + length++] = 1;
+              }
+            } else {
+              counts[readerOf(dst)]++;
+            }
+          }
+          for (uint32_t h = 0; h < _numHosts; h++) {
+            if (counts[h]) {
+              _readDsts[slot + length]      = numRead + h;
+              _readWeights[slot + length++] = counts[h];
+              counts[h]                     = 0;
+            }
+          }
+          _readLengths[lsrc] = length;
+        },
+        galois::steal(), galois::no_stats());
+  }
+
+  //! Partitions the read subgraph once all of it has been inspected
+  void prepareMasters() { partitionReadSubgraph(); }
+
+  template <typename EdgeTy>
+  uint32_t getMaster(uint32_t src,
+                     galois::graphs::BufferedGraph<EdgeTy>& bufGraph,
+                     const std::vector<uint32_t>&,
+                     std::unordered_map<uint64_t, uint32_t>&,
+                     const std::vector<uint64_t>&,
+                     std::vector<galois::CopyableAtomic<uint64_t>>& nodeAccum,
+                     const std::vector<uint64_t>&,
+                     std::vector<galois::CopyableAtomic<uint64_t>>& edgeAccum) {
+    uint32_t assignedHost = _assignment[src - _readBegin];
+
+    uint64_t ne = std::distance(bufGraph.edgeBegin(src), bufGraph.edgeEnd(src));
+
+    galois::atomicAdd(nodeAccum[assignedHost], (uint64_t)1);
+    galois::atomicAdd(edgeAccum[assignedHost], ne);
+    return assignedHost;
+  }
+
+  // multi-level partitioning is an edge cut: all edges on source
+  uint32_t getEdgeOwner(uint32_t src, uint32_t, uint64_t) const {
+    return retrieveMaster(src);
+  }
+
+  bool noCommunication() { return false; }
+  bool isVertexCut() const { return false; }
+  void serializePartition(boost::archive::binary_oarchive&) {}
+  void deserializePartition(boost::archive::binary_iarchive&) {}
+  std::pair<unsigned, unsigned> cartesianGrid() {
+    return std::make_pair(0u, 0u);
+  }
+};
+
 #endif
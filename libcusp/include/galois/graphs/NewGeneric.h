@@ -52,6 +52,9 @@ class NewDistGraphGeneric : public DistGraph<NodeTy, EdgeTy> {
 
   //! How many rounds to sync state during edge assignment phase
   uint32_t _edgeStateRounds;
+  //! Max number of edges resident at once when streaming edges from disk;
+  //! 0 means the whole read range is loaded up front
+  uint64_t _streamEdgeChunk;
   std::vector<galois::DGAccumulator<uint64_t>> hostLoads;
   std::vector<uint64_t> old_hostLoads;
 
@@ -162,8 +165,9 @@ public:
       uint32_t nodeWeight = 0, uint32_t edgeWeight = 0,
       std::string masterBlockFile = "", bool readFromFile = false,
       std::string localGraphFileName = "local_graph",
-      uint32_t edgeStateRounds       = 1)
-      : base_DistGraph(host, _numHosts), _edgeStateRounds(edgeStateRounds) {
+      uint32_t edgeStateRounds = 1, uint64_t streamEdgeChunk = 0)
+      : base_DistGraph(host, _numHosts), _edgeStateRounds(edgeStateRounds),
+        _streamEdgeChunk(streamEdgeChunk) {
     galois::runtime::reportParam("dGraph", "GenericPartitioner", "0");
     galois::CondStatTimer<MORE_DIST_STATS> Tgraph_construct(
         "GraphPartitioningTime", GRNAME);
@@ -227,9 +231,17 @@ public:
     bufGraph.resetReadCounters();
     galois::StatTimer graphReadTimer("GraphReading", GRNAME);
     graphReadTimer.start();
-    bufGraph.loadPartialGraph(filename, nodeBegin, nodeEnd, *edgeBegin,
-                              *edgeEnd, base_DistGraph::numGlobalNodes,
-                              base_DistGraph::numGlobalEdges);
+    if (_streamEdgeChunk) {
+      // only the out indices are read here; edges are streamed in windows by
+      // each pass that needs them so the full edge range is never resident
+      bufGraph.loadPartialGraphIndex(filename, nodeBegin, nodeEnd, *edgeBegin,
+                                     *edgeEnd, base_DistGraph::numGlobalNodes,
+                                     base_DistGraph::numGlobalEdges);
+    } else {
+      bufGraph.loadPartialGraph(filename, nodeBegin, nodeEnd, *edgeBegin,
+                                *edgeEnd, base_DistGraph::numGlobalNodes,
+                                base_DistGraph::numGlobalEdges);
+    }
     graphReadTimer.stop();
     galois::gPrint("[", base_DistGraph::id, "] Reading graph complete.\n");
 
@@ -359,14 +371,98 @@ public:
     Tgraph_construct.stop();
     galois::gPrint("[", base_DistGraph::id, "] Graph construction complete.\n");
 
+    reportPartitionQuality();
+
     // report state rounds
     if (base_DistGraph::id == 0) {
       galois::runtime::reportStat_Single(GRNAME, "CuSPStateRounds",
                                          (uint32_t)stateRounds);
+      galois::runtime::reportStat_Single(GRNAME, "CuSPStreamEdgeChunk",
+                                         _streamEdgeChunk);
     }
   }
 
 private:
+  /**
+   * Reports how good the constructed partition is: the replication factor
+   * (proxies per global node) and the edge balance (edges on the most loaded
+   * host over the mean edges per host).
+   */
+  void reportPartitionQuality() {
+    galois::DGAccumulator<uint64_t> totalProxies;
+    galois::DGAccumulator<uint64_t> totalEdges;
+    galois::DGReduceMax<uint64_t> maxEdges;
+    totalProxies.reset();
+    totalEdges.reset();
+    maxEdges.reset();
+
+    totalProxies += base_DistGraph::numNodes;
+    totalEdges += base_DistGraph::numEdges;
+    maxEdges.update(base_DistGraph::numEdges);
+
+    uint64_t globalProxies = totalProxies.reduce();
+    uint64_t globalEdges   = totalEdges.reduce();
+    uint64_t globalMax     = maxEdges.reduce();
+
+    if (base_DistGraph::id == 0) {
+      double replicationFactor =
+          base_DistGraph::numGlobalNodes
+              ? globalProxies / (double)base_DistGraph::numGlobalNodes
+              : 0;
+      double edgeBalance =
+          globalEdges ? globalMax * base_DistGraph::numHosts /
+                            (double)globalEdges
+                      : 1;
+      galois::gPrint("Partition replication factor ", replicationFactor,
+                     ", edge balance ", edgeBalance, "\n");
+      galois::runtime::reportStat_Single(GRNAME, "PartitionReplicationFactor",
+                                         replicationFactor);
+      galois::runtime::reportStat_Single(GRNAME, "PartitionEdgeBalance",
+                                         edgeBalance);
+    }
+  }
+
+  /**
+   * Applies a function to the nodes [beginNode, endNode) read by this host
+   * one edge window at a time. If edges are not being streamed, the whole
+   * range is a single window since all edges are already resident.
+   * Otherwise, each window has at most _streamEdgeChunk edges (or a single
+   * node), and the next window is read from disk while the current one is
+   * processed.
+   *
+   * @param bufGraph Buffered graph to read edges from
+   * @param beginNode First global node id to process
+   * @param endNode One past the last global node id to process
+   * @param windowFunc Function taking the begin/end nodes of a window; edges
+   * of those nodes are resident in bufGraph for the duration of the call
+   */
+  template <typename WindowFunc>
+  void forEachEdgeWindow(galois::graphs::BufferedGraph<EdgeTy>& bufGraph,
+                         uint64_t beginNode, uint64_t endNode,
+                         WindowFunc windowFunc) {
+    if (!_streamEdgeChunk) {
+      windowFunc(beginNode, endNode);
+      return;
+    }
+
+    uint64_t windowBegin = beginNode;
+    uint64_t windowEnd =
+        bufGraph.edgeWindowEnd(windowBegin, endNode, _streamEdgeChunk);
+    while (windowBegin < endNode) {
+      bufGraph.loadEdgeWindow(windowBegin, windowEnd);
+      uint64_t nextEnd =
+          bufGraph.edgeWindowEnd(windowEnd, endNode, _streamEdgeChunk);
+      // overlap disk reads of the next window with work on this one
+      if (windowEnd < endNode) {
+        bufGraph.prefetchEdgeWindow(windowEnd, nextEnd);
+      }
+      windowFunc(windowBegin, windowEnd);
+      windowBegin = windowEnd;
+      windowEnd   = nextEnd;
+    }
+    bufGraph.freeEdgeWindow();
+  }
+
   galois::runtime::SpecificRange<boost::counting_iterator<size_t>>
   getSpecificThreadRange(galois::graphs::BufferedGraph<EdgeTy>& bufGraph,
                          std::vector<uint32_t>& assignedThreadRanges,
@@ -424,35 +520,32 @@ private:
     ghosts.resize(bufGraph.size());
     ghosts.reset();
 
-    std::vector<uint32_t> rangeVector;
     auto start = base_DistGraph::gid2host[base_DistGraph::id].first;
     auto end   = base_DistGraph::gid2host[base_DistGraph::id].second;
 
-    galois::runtime::SpecificRange<boost::counting_iterator<size_t>> work =
-        getSpecificThreadRange(bufGraph, rangeVector, start, end);
+    forEachEdgeWindow(bufGraph, start, end, [&](uint64_t wBegin,
+                                                uint64_t wEnd) {
+      std::vector<uint32_t> rangeVector;
+      galois::runtime::SpecificRange<boost::counting_iterator<size_t>> work =
+          getSpecificThreadRange(bufGraph, rangeVector, wBegin, wEnd);
 
-    // Step 2: loop over all local nodes, determine neighbor locations
-    galois::do_all(
-        galois::iterate(work),
-        // galois::iterate(base_DistGraph::gid2host[base_DistGraph::id].first,
-        //                base_DistGraph::gid2host[base_DistGraph::id].second),
-        [&](unsigned n) {
-          // ptt.start();
-          // galois::gPrint("[", base_DistGraph::id, " ",
-          // galois::substrate::getThreadPool().getTID(), "] ", n, "\n");
-          auto ii = bufGraph.edgeBegin(n);
-          auto ee = bufGraph.edgeEnd(n);
-          for (; ii < ee; ++ii) {
-            uint32_t dst = bufGraph.edgeDestination(*ii);
-            if ((dst < start) || (dst >= end)) { // not owned by this host
-              // set on bitset
-              ghosts.set(dst);
+      // Step 2: loop over all local nodes, determine neighbor locations
+      galois::do_all(
+          galois::iterate(work),
+          [&](unsigned n) {
+            auto ii = bufGraph.edgeBegin(n);
+            auto ee = bufGraph.edgeEnd(n);
+            for (; ii < ee; ++ii) {
+              uint32_t dst = bufGraph.edgeDestination(*ii);
+              if ((dst < start) || (dst >= end)) { // not owned by this host
+                // set on bitset
+                ghosts.set(dst);
+              }
             }
-          }
-          // ptt.stop();
-        },
-        galois::loopname("Phase0BitsetSetup_DetermineNeighborLocations"),
-        galois::steal(), galois::no_stats());
+          },
+          galois::loopname("Phase0BitsetSetup_DetermineNeighborLocations"),
+          galois::steal(), galois::no_stats());
+    });
 
     bitsetSetupTimer.stop();
   }
@@ -1313,6 +1406,21 @@ private:
                      stateRounds, "\n");
     }
 
+    // policies that partition the read subgraph as a whole get to see all of
+    // it before the first master is assigned
+    if (graphPartitioner->needsReadSubgraph()) {
+      galois::StatTimer inspectTimer("Phase0ReadSubgraphInspection", GRNAME);
+      inspectTimer.start();
+      forEachEdgeWindow(
+          bufGraph, globalOffset,
+          base_DistGraph::gid2host[base_DistGraph::id].second,
+          [&](uint64_t wBegin, uint64_t wEnd) {
+            graphPartitioner->inspectReadEdges(bufGraph, wBegin, wEnd);
+          });
+      graphPartitioner->prepareMasters();
+      inspectTimer.stop();
+    }
+
     // galois::PerThreadTimer<CUSP_PT_TIMER> ptt(
     //  GRNAME, "Phase0DetermineMaster_" + std::string(base_DistGraph::id)
     //);
@@ -1323,43 +1431,30 @@ private:
           globalOffset, base_DistGraph::gid2host[base_DistGraph::id].second,
           syncRound, stateRounds);
 
-      // create specific range for this block
-      std::vector<uint32_t> rangeVec;
-      auto work =
-          getSpecificThreadRange(bufGraph, rangeVec, beginNode, endNode);
+      forEachEdgeWindow(bufGraph, beginNode, endNode, [&](uint64_t wBegin,
+                                                          uint64_t wEnd) {
+        // create specific range for this block
+        std::vector<uint32_t> rangeVec;
+        auto work = getSpecificThreadRange(bufGraph, rangeVec, wBegin, wEnd);
 
-      // debug print
-      // galois::on_each([&] (unsigned i, unsigned j) {
-      //  galois::gDebug("[", base_DistGraph::id, " ", i, "] sync round ",
-      //  syncRound, " local range ",
-      //                 *work.local_begin(), " ", *work.local_end());
-      //});
-
-      galois::do_all(
-          // iterate over my read nodes
-          galois::iterate(work),
-          // galois::iterate(beginNode, endNode),
-          [&](uint32_t node) {
-            // ptt.start();
-            // determine master function takes source node, iterator of
-            // neighbors
-            uint32_t assignedHost = graphPartitioner->getMaster(
-                node, bufGraph, localNodeToMaster, gid2offsets, nodeLoads,
-                nodeAccum, edgeLoads, edgeAccum);
-            // != -1 means it was assigned a host
-            assert(assignedHost != (uint32_t)-1);
-            // update mapping; this is a local node, so can get position
-            // on map with subtraction
-            localNodeToMaster[node - globalOffset] = assignedHost;
-
-            // galois::gDebug("[", base_DistGraph::id, "] state round ",
-            // syncRound,
-            //               " set ", node, " ", node - globalOffset);
-
-            // ptt.stop();
-          },
-          galois::loopname("Phase0DetermineMasters"), galois::steal(),
-          galois::no_stats());
+        galois::do_all(
+            // iterate over my read nodes
+            galois::iterate(work),
+            [&](uint32_t node) {
+              // determine master function takes source node, iterator of
+              // neighbors
+              uint32_t assignedHost = graphPartitioner->getMaster(
+                  node, bufGraph, localNodeToMaster, gid2offsets, nodeLoads,
+                  nodeAccum, edgeLoads, edgeAccum);
+              // != -1 means it was assigned a host
+              assert(assignedHost != (uint32_t)-1);
+              // update mapping; this is a local node, so can get position
+              // on map with subtraction
+              localNodeToMaster[node - globalOffset] = assignedHost;
+            },
+            galois::loopname("Phase0DetermineMasters"), galois::steal(),
+            galois::no_stats());
+      });
 
       // do synchronization of master assignment of neighbors
       if (!async) {
@@ -1481,25 +1576,29 @@ private:
     prefixSumOfEdges.resize(base_DistGraph::numOwned);
 
     auto& ltgv = base_DistGraph::localToGlobalVector;
-    galois::do_all(
-        galois::iterate(base_DistGraph::gid2host[base_DistGraph::id].first,
-                        base_DistGraph::gid2host[base_DistGraph::id].second),
-        [&](size_t n) {
-          auto ii = bufGraph.edgeBegin(n);
-          auto ee = bufGraph.edgeEnd(n);
-          for (; ii < ee; ++ii) {
-            uint32_t dst = bufGraph.edgeDestination(*ii);
-            if (graphPartitioner->retrieveMaster(dst) != myID) {
-              incomingMirrors.set(dst);
-            }
-          }
-          prefixSumOfEdges[n - globalOffset] = (*ee) - edgeOffset;
-          ltgv[n - globalOffset]             = n;
-        },
+    forEachEdgeWindow(
+        bufGraph, base_DistGraph::gid2host[base_DistGraph::id].first,
+        base_DistGraph::gid2host[base_DistGraph::id].second,
+        [&](uint64_t wBegin, uint64_t wEnd) {
+          galois::do_all(
+              galois::iterate(wBegin, wEnd),
+              [&](size_t n) {
+                auto ii = bufGraph.edgeBegin(n);
+                auto ee = bufGraph.edgeEnd(n);
+                for (; ii < ee; ++ii) {
+                  uint32_t dst = bufGraph.edgeDestination(*ii);
+                  if (graphPartitioner->retrieveMaster(dst) != myID) {
+                    incomingMirrors.set(dst);
+                  }
+                }
+                prefixSumOfEdges[n - globalOffset] = (*ee) - edgeOffset;
+                ltgv[n - globalOffset]             = n;
+              },
 #if MORE_DIST_STATS
-        galois::loopname("EdgeInspectionLoop"),
+              galois::loopname("EdgeInspectionLoop"),
 #endif
-        galois::steal(), galois::no_stats());
+              galois::steal(), galois::no_stats());
+        });
     inspectionTimer.stop();
 
     uint64_t allBytesRead = bufGraph.getBytesRead();
@@ -1614,27 +1713,31 @@ private:
     galois::StatTimer timer("EdgeLoading", GRNAME);
     timer.start();
 
-    galois::do_all(
-        galois::iterate(base_DistGraph::gid2host[base_DistGraph::id].first,
-                        base_DistGraph::gid2host[base_DistGraph::id].second),
-        [&](size_t n) {
-          auto ii       = bGraph.edgeBegin(n);
-          auto ee       = bGraph.edgeEnd(n);
-          uint32_t lsrc = this->G2LEdgeCut(n, globalOffset);
-          uint64_t cur =
-              *graph.edge_begin(lsrc, galois::MethodFlag::UNPROTECTED);
-          for (; ii < ee; ++ii) {
-            auto gdst           = bGraph.edgeDestination(*ii);
-            decltype(gdst) ldst = this->G2LEdgeCut(gdst, globalOffset);
-            auto gdata          = bGraph.edgeData(*ii);
-            graph.constructEdge(cur++, ldst, gdata);
-          }
-          assert(cur == (*graph.edge_end(lsrc)));
-        },
+    forEachEdgeWindow(
+        bGraph, base_DistGraph::gid2host[base_DistGraph::id].first,
+        base_DistGraph::gid2host[base_DistGraph::id].second,
+        [&](uint64_t wBegin, uint64_t wEnd) {
+          galois::do_all(
+              galois::iterate(wBegin, wEnd),
+              [&](size_t n) {
+                auto ii       = bGraph.edgeBegin(n);
+                auto ee       = bGraph.edgeEnd(n);
+                uint32_t lsrc = this->G2LEdgeCut(n, globalOffset);
+                uint64_t cur =
+                    *graph.edge_begin(lsrc, galois::MethodFlag::UNPROTECTED);
+                for (; ii < ee; ++ii) {
+                  auto gdst           = bGraph.edgeDestination(*ii);
+                  decltype(gdst) ldst = this->G2LEdgeCut(gdst, globalOffset);
+                  auto gdata          = bGraph.edgeData(*ii);
+                  graph.constructEdge(cur++, ldst, gdata);
+                }
+                assert(cur == (*graph.edge_end(lsrc)));
+              },
 #if MORE_DIST_STATS
-        galois::loopname("EdgeLoadingLoop"),
+              galois::loopname("EdgeLoadingLoop"),
 #endif
-        galois::steal(), galois::no_stats());
+              galois::steal(), galois::no_stats());
+        });
 
     timer.stop();
     galois::gPrint("[", base_DistGraph::id,
@@ -1666,26 +1769,30 @@ private:
     galois::StatTimer timer("EdgeLoading", GRNAME);
     timer.start();
 
-    galois::do_all(
-        galois::iterate(base_DistGraph::gid2host[base_DistGraph::id].first,
-                        base_DistGraph::gid2host[base_DistGraph::id].second),
-        [&](size_t n) {
-          auto ii       = bGraph.edgeBegin(n);
-          auto ee       = bGraph.edgeEnd(n);
-          uint32_t lsrc = this->G2LEdgeCut(n, globalOffset);
-          uint64_t cur =
-              *graph.edge_begin(lsrc, galois::MethodFlag::UNPROTECTED);
-          for (; ii < ee; ++ii) {
-            auto gdst           = bGraph.edgeDestination(*ii);
-            decltype(gdst) ldst = this->G2LEdgeCut(gdst, globalOffset);
-            graph.constructEdge(cur++, ldst);
-          }
-          assert(cur == (*graph.edge_end(lsrc)));
-        },
+    forEachEdgeWindow(
+        bGraph, base_DistGraph::gid2host[base_DistGraph::id].first,
+        base_DistGraph::gid2host[base_DistGraph::id].second,
+        [&](uint64_t wBegin, uint64_t wEnd) {
+          galois::do_all(
+              galois::iterate(wBegin, wEnd),
+              [&](size_t n) {
+                auto ii       = bGraph.edgeBegin(n);
+                auto ee       = bGraph.edgeEnd(n);
+                uint32_t lsrc = this->G2LEdgeCut(n, globalOffset);
+                uint64_t cur =
+                    *graph.edge_begin(lsrc, galois::MethodFlag::UNPROTECTED);
+                for (; ii < ee; ++ii) {
+                  auto gdst           = bGraph.edgeDestination(*ii);
+                  decltype(gdst) ldst = this->G2LEdgeCut(gdst, globalOffset);
+                  graph.constructEdge(cur++, ldst);
+                }
+                assert(cur == (*graph.edge_end(lsrc)));
+              },
 #if MORE_DIST_STATS
-        galois::loopname("EdgeLoadingLoop"),
+              galois::loopname("EdgeLoadingLoop"),
 #endif
-        galois::steal(), galois::no_stats());
+              galois::steal(), galois::no_stats());
+        });
 
     timer.stop();
     galois::gPrint("[", base_DistGraph::id,
@@ -1779,57 +1886,59 @@ private:
       std::tie(beginNode, endNode) = galois::block_range(
           globalOffset, base_DistGraph::gid2host[base_DistGraph::id].second,
           syncRound, _edgeStateRounds);
-      // TODO maybe edge range this?
-
-      galois::do_all(
-          // iterate over my read nodes
-          galois::iterate(beginNode, endNode),
-          [&](size_t src) {
-            auto ee            = bufGraph.edgeBegin(src);
-            auto ee_end        = bufGraph.edgeEnd(src);
-            uint64_t numEdgesL = std::distance(ee, ee_end);
-
-            for (; ee != ee_end; ee++) {
-              uint32_t dst         = bufGraph.edgeDestination(*ee);
-              uint32_t hostBelongs = -1;
-              hostBelongs = graphPartitioner->getEdgeOwner(src, dst, numEdgesL);
-              if (_edgeStateRounds > 1) {
-                hostLoads[hostBelongs] += 1;
-              }
+      forEachEdgeWindow(bufGraph, beginNode, endNode, [&](uint64_t wBegin,
+                                                          uint64_t wEnd) {
+        galois::do_all(
+            // iterate over my read nodes
+            galois::iterate(wBegin, wEnd),
+            [&](size_t src) {
+              auto ee            = bufGraph.edgeBegin(src);
+              auto ee_end        = bufGraph.edgeEnd(src);
+              uint64_t numEdgesL = std::distance(ee, ee_end);
+
+              for (; ee != ee_end; ee++) {
+                uint32_t dst         = bufGraph.edgeDestination(*ee);
+                uint32_t hostBelongs = -1;
+                hostBelongs =
+                    graphPartitioner->getEdgeOwner(src, dst, numEdgesL);
+                if (_edgeStateRounds > 1) {
+                  hostLoads[hostBelongs] += 1;
+                }
 
-              numOutgoingEdges[hostBelongs][src - globalOffset] += 1;
-              hostHasOutgoing.set(hostBelongs);
-              bool hostIsMasterOfDest =
-                  (hostBelongs == graphPartitioner->retrieveMaster(dst));
-
-              // this means a mirror must be created for destination node on
-              // that host since it will not be created otherwise
-              if (!hostIsMasterOfDest) {
-                auto& bitsetStatus = indicatorVars[hostBelongs];
-
-                // initialize the bitset if necessary
-                if (bitsetStatus == 0) {
-                  char expected = 0;
-                  bool result =
-                      bitsetStatus.compare_exchange_strong(expected, 1);
-                  // i swapped successfully, therefore do allocation
-                  if (result) {
-                    hasIncomingEdge[hostBelongs].resize(globalNodes);
-                    hasIncomingEdge[hostBelongs].reset();
-                    bitsetStatus = 2;
+                numOutgoingEdges[hostBelongs][src - globalOffset] += 1;
+                hostHasOutgoing.set(hostBelongs);
+                bool hostIsMasterOfDest =
+                    (hostBelongs == graphPartitioner->retrieveMaster(dst));
+
+                // this means a mirror must be created for destination node on
+                // that host since it will not be created otherwise
+                if (!hostIsMasterOfDest) {
+                  auto& bitsetStatus = indicatorVars[hostBelongs];
+
+                  // initialize the bitset if necessary
+                  if (bitsetStatus == 0) {
+                    char expected = 0;
+                    bool result =
+                        bitsetStatus.compare_exchange_strong(expected, 1);
+                    // i swapped successfully, therefore do allocation
+                    if (result) {
+                      hasIncomingEdge[hostBelongs].resize(globalNodes);
+                      hasIncomingEdge[hostBelongs].reset();
+                      bitsetStatus = 2;
+                    }
                   }
+                  // until initialized, loop
+                  while (indicatorVars[hostBelongs] != 2)
+                    ;
+                  hasIncomingEdge[hostBelongs].set(dst);
                 }
-                // until initialized, loop
-                while (indicatorVars[hostBelongs] != 2)
-                  ;
-                hasIncomingEdge[hostBelongs].set(dst);
               }
-            }
-          },
+            },
 #if MORE_DIST_STATS
-          galois::loopname("AssignEdges"),
+            galois::loopname("AssignEdges"),
 #endif
-          galois::steal(), galois::no_stats());
+            galois::steal(), galois::no_stats());
+      });
       syncEdgeLoad();
     }
   }
@@ -2649,92 +2758,95 @@ private:
           _edgeStateRounds);
 
       // Go over assigned nodes and distribute edges.
-      galois::do_all(
-          galois::iterate(beginNode, endNode),
-          [&](uint64_t src) {
-            uint32_t lsrc    = 0;
-            uint64_t curEdge = 0;
-            if (base_DistGraph::isLocal(src)) {
-              lsrc = this->G2L(src);
-              curEdge =
-                  *graph.edge_begin(lsrc, galois::MethodFlag::UNPROTECTED);
-            }
+      forEachEdgeWindow(bufGraph, beginNode, endNode, [&](uint64_t wBegin,
+                                                          uint64_t wEnd) {
+        galois::do_all(
+            galois::iterate(wBegin, wEnd),
+            [&](uint64_t src) {
+              uint32_t lsrc    = 0;
+              uint64_t curEdge = 0;
+              if (base_DistGraph::isLocal(src)) {
+                lsrc = this->G2L(src);
+                curEdge =
+                    *graph.edge_begin(lsrc, galois::MethodFlag::UNPROTECTED);
+              }
 
-            auto ee            = bufGraph.edgeBegin(src);
-            auto ee_end        = bufGraph.edgeEnd(src);
-            uint64_t numEdgesL = std::distance(ee, ee_end);
-            auto& gdst_vec     = *gdst_vecs.getLocal();
-            auto& gdata_vec    = *gdata_vecs.getLocal();
-
-            for (unsigned i = 0; i < numHosts; ++i) {
-              gdst_vec[i].clear();
-              gdata_vec[i].clear();
-              gdst_vec[i].reserve(numEdgesL);
-              // gdata_vec[i].reserve(numEdgesL);
-            }
+              auto ee            = bufGraph.edgeBegin(src);
+              auto ee_end        = bufGraph.edgeEnd(src);
+              uint64_t numEdgesL = std::distance(ee, ee_end);
+              auto& gdst_vec     = *gdst_vecs.getLocal();
+              auto& gdata_vec    = *gdata_vecs.getLocal();
+
+              for (unsigned i = 0; i < numHosts; ++i) {
+                gdst_vec[i].clear();
+                gdata_vec[i].clear();
+                gdst_vec[i].reserve(numEdgesL);
+                // gdata_vec[i].reserve(numEdgesL);
+              }
 
-            for (; ee != ee_end; ++ee) {
-              uint32_t gdst = bufGraph.edgeDestination(*ee);
-              auto gdata    = bufGraph.edgeData(*ee);
+              for (; ee != ee_end; ++ee) {
+                uint32_t gdst = bufGraph.edgeDestination(*ee);
+                auto gdata    = bufGraph.edgeData(*ee);
 
-              uint32_t hostBelongs =
-                  graphPartitioner->getEdgeOwner(src, gdst, numEdgesL);
-              if (_edgeStateRounds > 1) {
-                hostLoads[hostBelongs] += 1;
-              }
+                uint32_t hostBelongs =
+                    graphPartitioner->getEdgeOwner(src, gdst, numEdgesL);
+                if (_edgeStateRounds > 1) {
+                  hostLoads[hostBelongs] += 1;
+                }
 
-              if (hostBelongs == id) {
-                // edge belongs here, construct on self
-                assert(base_DistGraph::isLocal(src));
-                uint32_t ldst = this->G2L(gdst);
-                graph.constructEdge(curEdge++, ldst, gdata);
-                // TODO
-                // if ldst is an outgoing mirror, this is vertex cut
-              } else {
-                // add to host vector to send out later
-                gdst_vec[hostBelongs].push_back(gdst);
-                gdata_vec[hostBelongs].push_back(gdata);
+                if (hostBelongs == id) {
+                  // edge belongs here, construct on self
+                  assert(base_DistGraph::isLocal(src));
+                  uint32_t ldst = this->G2L(gdst);
+                  graph.constructEdge(curEdge++, ldst, gdata);
+                  // TODO
+                  // if ldst is an outgoing mirror, this is vertex cut
+                } else {
+                  // add to host vector to send out later
+                  gdst_vec[hostBelongs].push_back(gdst);
+                  gdata_vec[hostBelongs].push_back(gdata);
+                }
               }
-            }
 
-            // make sure all edges accounted for if local
-            if (base_DistGraph::isLocal(src)) {
-              assert(curEdge == (*graph.edge_end(lsrc)));
-            }
+              // make sure all edges accounted for if local
+              if (base_DistGraph::isLocal(src)) {
+                assert(curEdge == (*graph.edge_end(lsrc)));
+              }
 
-            // send
-            for (uint32_t h = 0; h < numHosts; ++h) {
-              if (h == id)
-                continue;
-
-              if (gdst_vec[h].size() > 0) {
-                auto& b = (*sendBuffers.getLocal())[h];
-                galois::runtime::gSerialize(b, src);
-                galois::runtime::gSerialize(b, gdst_vec[h]);
-                galois::runtime::gSerialize(b, gdata_vec[h]);
-
-                // send if over limit
-                if (b.size() > edgePartitionSendBufSize) {
-                  messagesSent += 1;
-                  bytesSent.update(b.size());
-                  maxBytesSent.update(b.size());
-
-                  net.sendTagged(h, galois::runtime::evilPhase, b);
-                  b.getVec().clear();
-                  b.getVec().reserve(edgePartitionSendBufSize * 1.25);
+              // send
+              for (uint32_t h = 0; h < numHosts; ++h) {
+                if (h == id)
+                  continue;
+
+                if (gdst_vec[h].size() > 0) {
+                  auto& b = (*sendBuffers.getLocal())[h];
+                  galois::runtime::gSerialize(b, src);
+                  galois::runtime::gSerialize(b, gdst_vec[h]);
+                  galois::runtime::gSerialize(b, gdata_vec[h]);
+
+                  // send if over limit
+                  if (b.size() > edgePartitionSendBufSize) {
+                    messagesSent += 1;
+                    bytesSent.update(b.size());
+                    maxBytesSent.update(b.size());
+
+                    net.sendTagged(h, galois::runtime::evilPhase, b);
+                    b.getVec().clear();
+                    b.getVec().reserve(edgePartitionSendBufSize * 1.25);
+                  }
                 }
               }
-            }
 
-            // overlap receives
-            auto buffer =
-                net.recieveTagged(galois::runtime::evilPhase, nullptr);
-            this->processReceivedEdgeBuffer(buffer, graph, receivedNodes);
-          },
+              // overlap receives
+              auto buffer =
+                  net.recieveTagged(galois::runtime::evilPhase, nullptr);
+              this->processReceivedEdgeBuffer(buffer, graph, receivedNodes);
+            },
 #if MORE_DIST_STATS
-          galois::loopname("EdgeLoadingLoop"),
+            galois::loopname("EdgeLoadingLoop"),
 #endif
-          galois::steal(), galois::no_stats());
+            galois::steal(), galois::no_stats());
+      });
       syncEdgeLoad();
       // printEdgeLoad();
     }
@@ -2802,85 +2914,88 @@ private:
           _edgeStateRounds);
 
       // Go over assigned nodes and distribute edges.
-      galois::do_all(
-          galois::iterate(beginNode, endNode),
-          [&](uint64_t src) {
-            uint32_t lsrc    = 0;
-            uint64_t curEdge = 0;
-            if (base_DistGraph::isLocal(src)) {
-              lsrc = this->G2L(src);
-              curEdge =
-                  *graph.edge_begin(lsrc, galois::MethodFlag::UNPROTECTED);
-            }
-
-            auto ee            = bufGraph.edgeBegin(src);
-            auto ee_end        = bufGraph.edgeEnd(src);
-            uint64_t numEdgesL = std::distance(ee, ee_end);
-            auto& gdst_vec     = *gdst_vecs.getLocal();
+      forEachEdgeWindow(bufGraph, beginNode, endNode, [&](uint64_t wBegin,
+                                                          uint64_t wEnd) {
+        galois::do_all(
+            galois::iterate(wBegin, wEnd),
+            [&](uint64_t src) {
+              uint32_t lsrc    = 0;
+              uint64_t curEdge = 0;
+              if (base_DistGraph::isLocal(src)) {
+                lsrc = this->G2L(src);
+                curEdge =
+                    *graph.edge_begin(lsrc, galois::MethodFlag::UNPROTECTED);
+              }
 
-            for (unsigned i = 0; i < numHosts; ++i) {
-              gdst_vec[i].clear();
-              // gdst_vec[i].reserve(numEdgesL);
-            }
+              auto ee            = bufGraph.edgeBegin(src);
+              auto ee_end        = bufGraph.edgeEnd(src);
+              uint64_t numEdgesL = std::distance(ee, ee_end);
+              auto& gdst_vec     = *gdst_vecs.getLocal();
 
-            for (; ee != ee_end; ++ee) {
-              uint32_t gdst = bufGraph.edgeDestination(*ee);
-              uint32_t hostBelongs =
-                  graphPartitioner->getEdgeOwner(src, gdst, numEdgesL);
-              if (_edgeStateRounds > 1) {
-                hostLoads[hostBelongs] += 1;
+              for (unsigned i = 0; i < numHosts; ++i) {
+                gdst_vec[i].clear();
+                // gdst_vec[i].reserve(numEdgesL);
               }
 
-              if (hostBelongs == id) {
-                // edge belongs here, construct on self
-                assert(base_DistGraph::isLocal(src));
-                uint32_t ldst = this->G2L(gdst);
-                graph.constructEdge(curEdge++, ldst);
-                // TODO
-                // if ldst is an outgoing mirror, this is vertex cut
-              } else {
-                // add to host vector to send out later
-                gdst_vec[hostBelongs].push_back(gdst);
+              for (; ee != ee_end; ++ee) {
+                uint32_t gdst = bufGraph.edgeDestination(*ee);
+                uint32_t hostBelongs =
+                    graphPartitioner->getEdgeOwner(src, gdst, numEdgesL);
+                if (_edgeStateRounds > 1) {
+                  hostLoads[hostBelongs] += 1;
+                }
+
+                if (hostBelongs == id) {
+                  // edge belongs here, construct on self
+                  assert(base_DistGraph::isLocal(src));
+                  uint32_t ldst = this->G2L(gdst);
+                  graph.constructEdge(curEdge++, ldst);
+                  // TODO
+                  // if ldst is an outgoing mirror, this is vertex cut
+                } else {
+                  // add to host vector to send out later
+                  gdst_vec[hostBelongs].push_back(gdst);
+                }
               }
-            }
 
-            // make sure all edges accounted for if local
-            if (base_DistGraph::isLocal(src)) {
-              assert(curEdge == (*graph.edge_end(lsrc)));
-            }
+              // make sure all edges accounted for if local
+              if (base_DistGraph::isLocal(src)) {
+                assert(curEdge == (*graph.edge_end(lsrc)));
+              }
 
-            // send
-            for (uint32_t h = 0; h < numHosts; ++h) {
-              if (h == id)
-                continue;
-
-              if (gdst_vec[h].size() > 0) {
-                auto& b = (*sendBuffers.getLocal())[h];
-                galois::runtime::gSerialize(b, src);
-                galois::runtime::gSerialize(b, gdst_vec[h]);
-
-                // send if over limit
-                if (b.size() > edgePartitionSendBufSize) {
-                  messagesSent += 1;
-                  bytesSent.update(b.size());
-                  maxBytesSent.update(b.size());
-
-                  net.sendTagged(h, galois::runtime::evilPhase, b);
-                  b.getVec().clear();
-                  b.getVec().reserve(edgePartitionSendBufSize * 1.25);
+              // send
+              for (uint32_t h = 0; h < numHosts; ++h) {
+                if (h == id)
+                  continue;
+
+                if (gdst_vec[h].size() > 0) {
+                  auto& b = (*sendBuffers.getLocal())[h];
+                  galois::runtime::gSerialize(b, src);
+                  galois::runtime::gSerialize(b, gdst_vec[h]);
+
+                  // send if over limit
+                  if (b.size() > edgePartitionSendBufSize) {
+                    messagesSent += 1;
+                    bytesSent.update(b.size());
+                    maxBytesSent.update(b.size());
+
+                    net.sendTagged(h, galois::runtime::evilPhase, b);
+                    b.getVec().clear();
+                    b.getVec().reserve(edgePartitionSendBufSize * 1.25);
+                  }
                 }
               }
-            }
 
-            // overlap receives
-            auto buffer =
-                net.recieveTagged(galois::runtime::evilPhase, nullptr);
-            this->processReceivedEdgeBuffer(buffer, graph, receivedNodes);
-          },
+              // overlap receives
+              auto buffer =
+                  net.recieveTagged(galois::runtime::evilPhase, nullptr);
+              this->processReceivedEdgeBuffer(buffer, graph, receivedNodes);
+            },
 #if MORE_DIST_STATS
-          galois::loopname("EdgeLoading"),
+            galois::loopname("EdgeLoading"),
 #endif
-          galois::steal(), galois::no_stats());
+            galois::steal(), galois::no_stats());
+      });
       syncEdgeLoad();
       // printEdgeLoad();
     }
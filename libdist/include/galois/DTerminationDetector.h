@@ -26,6 +26,7 @@
 #ifndef GALOIS_DISTTERMINATOR_H
 #define GALOIS_DISTTERMINATOR_H
 
+#include <algorithm>
 #include <limits>
 #include "galois/Galois.h"
 #include "galois/Reduction.h"
@@ -59,6 +60,48 @@ class DGTerminator {
   lc_colreq snapshot_request;
 #endif
 
+  //! Max number of rounds this host may be ahead of the slowest host; 0 if
+  //! unbounded
+  unsigned staleness_bound = 0;
+  //! Number of rounds (calls to reduce) this host has done
+  uint64_t local_round = 0;
+#ifndef GALOIS_USE_LCI
+  //! Window holding the latest round published by every host
+  MPI_Win round_window;
+#endif
+
+  //! Publishes this host's round to every other host's window
+  void publish_round() {
+#ifndef GALOIS_USE_LCI
+    for (unsigned h = 0; h < net.Num; ++h) {
+      if (h == net.ID)
+        continue;
+      MPI_Accumulate(&local_round, 1, MPI_UINT64_T, h, net.ID, 1, MPI_UINT64_T,
+                     MPI_MAX, round_window);
+    }
+    MPI_Win_flush_all(round_window);
+#endif
+  }
+
+  //! Returns true if this host is more rounds ahead of some host than the
+  //! staleness bound allows
+  bool ahead_of_bound() {
+#ifndef GALOIS_USE_LCI
+    for (unsigned h = 0; h < net.Num; ++h) {
+      if (h == net.ID)
+        continue;
+      uint64_t peer_round;
+      MPI_Fetch_and_op(nullptr, &peer_round, MPI_UINT64_T, net.ID, h,
+                       MPI_NO_OP, round_window);
+      MPI_Win_flush_local(net.ID, round_window);
+      if (local_round > peer_round + staleness_bound) {
+        return true;
+      }
+    }
+#endif
+    return false;
+  }
+
 public:
   //! Default constructor
   DGTerminator() {
@@ -67,6 +110,44 @@ public:
     reset();
   }
 
+  DGTerminator(const DGTerminator&) = delete;
+  DGTerminator& operator=(const DGTerminator&) = delete;
+
+  ~DGTerminator() {
+#ifndef GALOIS_USE_LCI
+    if (staleness_bound != 0) {
+      MPI_Win_unlock_all(round_window);
+      MPI_Win_free(&round_window);
+    }
+#endif
+  }
+
+  /**
+   * Bounds how far ahead of the slowest host this host may run: reduce
+   * blocks while this host has done more than bound rounds more than some
+   * other host (stale synchronous parallel). Hosts publish their round
+   * with one-sided writes, so no host waits on a host it is not ahead of.
+   * Must be called by all hosts.
+   *
+   * @param bound Max number of rounds ahead; 0 for unbounded
+   */
+  void setStalenessBound(unsigned bound) {
+    if (bound == 0 || staleness_bound != 0) {
+      return;
+    }
+#ifndef GALOIS_USE_LCI
+    staleness_bound = bound;
+    uint64_t* rounds;
+    MPI_Win_allocate(net.Num * sizeof(uint64_t), sizeof(uint64_t),
+                     MPI_INFO_NULL, MPI_COMM_WORLD, &rounds, &round_window);
+    std::fill(rounds, rounds + net.Num, 0);
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Win_lock_all(0, round_window);
+#else
+    galois::gWarn("staleness bound is not supported with LCI; ignoring it");
+#endif
+  }
+
   void reinitialize() {
     prev_snapshot   = 0;
     snapshot        = 1;
@@ -218,7 +299,31 @@ public:
     if (local_mdata == 0)
       local_mdata = mdata.reduce();
 
-    bool halt    = terminate();
+    bool halt = terminate();
+    if (!halt && staleness_bound != 0) {
+      ++local_round;
+      // publish often enough that the slowest host never has to wait
+      if (local_round % std::max(1u, staleness_bound / 2) == 0) {
+        publish_round();
+      }
+
+      std::string stale_timer_str("StalenessWait_" + runID);
+      galois::CondStatTimer<GALOIS_COMM_STATS> staleTimer(
+          stale_timer_str.c_str(), "DGReducible");
+      staleTimer.start();
+      while (ahead_of_bound()) {
+        // keep detecting termination while idle; once there is work (or
+        // updates to apply that arrived while waiting), stop so that this
+        // host is not considered done before it has applied them
+        if (!work_done) {
+          halt = terminate();
+          if (halt) {
+            break;
+          }
+        }
+      }
+      staleTimer.stop();
+    }
     global_mdata = !halt;
     if (halt) {
       galois::runtime::evilPhase += 2; // one for reduce and one for broadcast
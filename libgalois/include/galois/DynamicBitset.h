@@ -41,6 +41,21 @@
 #include "galois/Galois.h"
 
 namespace galois {
+/**
+ * Interface to be told how the bits of a DynamicBitSet change, so that the
+ * changes can be tracked without scanning the bitset.
+ */
+class DynamicBitSetObserver {
+public:
+  virtual ~DynamicBitSetObserver() = default;
+  //! Called by set() when it turns on a bit that was off; may be concurrent
+  virtual void bitSet(size_t index) = 0;
+  //! Called when any bit may have been turned on other than by set()
+  virtual void anySet() = 0;
+  //! Called when the inclusive range of bits [begin, end] has been reset
+  virtual void rangeReset(size_t begin, size_t end) = 0;
+};
+
 /**
  * Concurrent dynamically allocated bitset
  **/
@@ -48,11 +63,24 @@ class DynamicBitSet {
 protected:
   galois::PODResizeableArray<galois::CopyableAtomic<uint64_t>> bitvec;
   size_t num_bits;
+  //! Told of changes to the bits if not null
+  DynamicBitSetObserver* observer;
   static constexpr uint32_t bits_uint64 = sizeof(uint64_t) * CHAR_BIT;
 
 public:
   //! Constructor which initializes to an empty bitset.
-  DynamicBitSet() : num_bits(0) {}
+  DynamicBitSet() : num_bits(0), observer(nullptr) {}
+
+  /**
+   * Sets the observer told of changes to the bits from now on; null removes
+   * it. Bits written directly through get_vec() are not reported.
+   *
+   * @param o Observer to set
+   */
+  void setObserver(DynamicBitSetObserver* o) { observer = o; }
+
+  //! Returns the observer of this bitset, null if there is none
+  DynamicBitSetObserver* getObserver() const { return observer; }
 
   /**
    * Returns the underlying bitset representation to the user
@@ -107,7 +135,11 @@ public:
   /**
    * Unset every bit in the bitset.
    */
-  void reset() { std::fill(bitvec.begin(), bitvec.end(), 0); }
+  void reset() {
+    std::fill(bitvec.begin(), bitvec.end(), 0);
+    if (observer && num_bits > 0)
+      observer->rangeReset(0, num_bits - 1);
+  }
 
   /**
    * Unset a range of bits given an inclusive range
@@ -179,6 +211,9 @@ public:
         bitvec[bit_index] &= ~mask;
       }
     }
+
+    if (observer)
+      observer->rangeReset(begin, end);
   }
 
   /**
@@ -214,6 +249,8 @@ public:
            !bitvec[bit_index].compare_exchange_weak(
                old_val, old_val | bit_offset, std::memory_order_relaxed))
       ;
+    if (observer && !(old_val & bit_offset))
+      observer->bitSet(index);
     return (old_val & bit_offset);
   }
 
@@ -244,6 +281,8 @@ public:
     galois::do_all(
         galois::iterate(size_t{0}, bitvec.size()),
         [&](size_t i) { bitvec[i] |= other_bitvec[i]; }, galois::no_stats());
+    if (observer)
+      observer->anySet();
   }
 
   // assumes bit_vector is not updated (set) in parallel
@@ -278,6 +317,8 @@ public:
         galois::iterate(size_t{0}, bitvec.size()),
         [&](size_t i) { bitvec[i] = other_bitvec1[i] & other_bitvec2[i]; },
         galois::no_stats());
+    if (observer)
+      observer->anySet();
   }
 
   /**
@@ -291,6 +332,8 @@ public:
     galois::do_all(
         galois::iterate(size_t{0}, bitvec.size()),
         [&](size_t i) { bitvec[i] ^= other_bitvec[i]; }, galois::no_stats());
+    if (observer)
+      observer->anySet();
   }
 
   /**
@@ -310,6 +353,8 @@ public:
         galois::iterate(size_t{0}, bitvec.size()),
         [&](size_t i) { bitvec[i] = other_bitvec1[i] ^ other_bitvec2[i]; },
         galois::no_stats());
+    if (observer)
+      observer->anySet();
   }
 
   /**
@@ -0,0 +1,163 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_EDGETILES_H
+#define GALOIS_EDGETILES_H
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+
+#include "galois/config.h"
+#include "galois/Bag.h"
+#include "galois/Loops.h"
+#include "galois/Traits.h"
+
+namespace galois {
+
+/**
+ * Part [beg, end) of the out-edges of src. Loops over tiles instead of
+ * nodes keep a high-degree node from holding up a single thread.
+ */
+template <typename GraphTy>
+struct EdgeTile {
+  typename GraphTy::GraphNode src;
+  typename GraphTy::edge_iterator beg;
+  typename GraphTy::edge_iterator end;
+};
+
+/**
+ * Splits [beg, end) into tiles of at most tileSize edges and calls
+ * fn(tileBegin, tileEnd) on each of them. Nothing is called for an empty
+ * range.
+ */
+template <typename EdgeIter, typename TileFn>
+void splitEdgeTiles(EdgeIter beg, const EdgeIter end, size_t tileSize,
+                    const TileFn& fn) {
+  assert(beg <= end);
+  assert(tileSize > 0);
+
+  while (size_t(end - beg) > tileSize) {
+    auto ne = beg + tileSize;
+    fn(beg, ne);
+    beg = ne;
+  }
+
+  if (beg != end) {
+    fn(beg, end);
+  }
+}
+
+/**
+ * Tile size picked from the degrees of graph for the active threads. Tiles
+ * are small enough that no tile is more than 1/16 of the edges of one
+ * thread, but at most 4096 edges so that a stolen tile is not too coarse,
+ * and never so small that nodes of average degree get split.
+ */
+template <typename GraphTy>
+size_t edgeTileSize(const GraphTy& graph) {
+  size_t numNodes = std::max<size_t>(graph.size(), 1);
+  size_t numEdges = graph.sizeEdges();
+  size_t minSize  = std::max<size_t>(64, 2 * (numEdges / numNodes + 1));
+  size_t balanced = numEdges / (16 * size_t(getActiveThreads()));
+  return std::max(minSize, std::min<size_t>(balanced, 4096));
+}
+
+namespace internal {
+
+//! Range over tiles that owns them, so that it can be made by a range maker
+template <typename GraphTy>
+class EdgeTileRange {
+  typedef InsertBag<EdgeTile<GraphTy>> Tiles;
+  std::shared_ptr<Tiles> tiles;
+
+public:
+  typedef typename Tiles::iterator iterator;
+  typedef typename Tiles::local_iterator local_iterator;
+  typedef typename Tiles::value_type value_type;
+
+  explicit EdgeTileRange(std::shared_ptr<Tiles> t) : tiles(std::move(t)) {}
+
+  iterator begin() const { return tiles->begin(); }
+  iterator end() const { return tiles->end(); }
+
+  std::pair<local_iterator, local_iterator> local_pair() const {
+    return std::make_pair(tiles->local_begin(), tiles->local_end());
+  }
+
+  local_iterator local_begin() const { return tiles->local_begin(); }
+  local_iterator local_end() const { return tiles->local_end(); }
+};
+
+template <typename GraphTy, typename NodesTy>
+class EdgeTileRangeMaker {
+  GraphTy& graph;
+  NodesTy& nodes;
+
+public:
+  EdgeTileRangeMaker(GraphTy& g, NodesTy& n) : graph(g), nodes(n) {}
+
+  template <typename ArgsTy>
+  auto operator()(const ArgsTy& argsTuple) const {
+    auto argsT = std::tuple_cat(
+        argsTuple,
+        get_default_trait_values(argsTuple, std::make_tuple(edge_tile_tag{}),
+                                 std::make_tuple(edge_tile<>{})));
+    size_t tileSize = get_trait_value<edge_tile_tag>(argsT).value;
+    if (!tileSize) {
+      tileSize = edgeTileSize(graph);
+    }
+
+    auto tiles = std::make_shared<InsertBag<EdgeTile<GraphTy>>>();
+    galois::do_all(
+        galois::iterate(nodes),
+        [&](const typename GraphTy::GraphNode& src) {
+          splitEdgeTiles(graph.edge_begin(src, MethodFlag::UNPROTECTED),
+                         graph.edge_end(src, MethodFlag::UNPROTECTED),
+                         tileSize, [&](auto beg, auto end) {
+                           tiles->push(EdgeTile<GraphTy>{src, beg, end});
+                         });
+        },
+        galois::steal());
+    return EdgeTileRange<GraphTy>(tiles);
+  }
+};
+
+} // namespace internal
+
+/**
+ * Iterates over the out-edges of the nodes in nodes, split into tiles of at
+ * most as many edges as given by the galois::edge_tile() argument of the
+ * loop, or by galois::edgeTileSize() if there is none. The operator gets
+ * an EdgeTile.
+ */
+template <typename GraphTy, typename NodesTy>
+auto iterate_edge_tiles(GraphTy& graph, NodesTy& nodes) {
+  return internal::EdgeTileRangeMaker<GraphTy, NodesTy>(graph, nodes);
+}
+
+//! Iterates over all the out-edges of graph, split into tiles
+template <typename GraphTy>
+auto iterate_edge_tiles(GraphTy& graph) {
+  return internal::EdgeTileRangeMaker<GraphTy, GraphTy>(graph, graph);
+}
+
+} // namespace galois
+
+#endif
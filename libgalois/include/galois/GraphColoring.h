@@ -0,0 +1,191 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_GRAPHCOLORING_H
+#define GALOIS_GRAPHCOLORING_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "galois/config.h"
+#include "galois/Bag.h"
+#include "galois/LargeArray.h"
+#include "galois/Loops.h"
+#include "galois/MethodFlags.h"
+#include "galois/Reduction.h"
+#include "galois/substrate/PerThreadStorage.h"
+
+namespace galois {
+
+/**
+ * Jones-Plassmann coloring of the nodes of a symmetric graph: nodes of the
+ * same color are more than distance hops apart. With distance 2, operators
+ * whose neighborhood is a node and its neighbors do not conflict within a
+ * color; with distance 1, it is enough for operators that write only their
+ * node and read its neighbors. Distance 2 needs at least as many colors as
+ * the maximum degree plus one.
+ *
+ * Pass the coloring to galois::worklists::Colored to run a for_each by
+ * color without conflict detection. Computing it takes a few passes over
+ * the graph, so keep it for as long as the graph does not change.
+ */
+template <typename GraphTy>
+class GraphColoring {
+public:
+  typedef typename GraphTy::GraphNode GraphNode;
+
+private:
+  static constexpr unsigned UNCOLORED = ~0u;
+
+  LargeArray<unsigned> colors;
+  //! Last round of worklists::Colored that scheduled each node
+  LargeArray<unsigned> rounds;
+  unsigned m_numColors;
+  unsigned m_distance;
+  unsigned m_round;
+
+  //! Random but fixed priority; distinct nodes never tie
+  static uint64_t priority(GraphNode n) {
+    uint64_t x = n;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+  }
+
+  //! Calls fn on the nodes within m_distance hops of n, some of them more
+  //! than once, until fn returns false
+  template <typename Fn>
+  bool forNear(GraphTy& graph, GraphNode n, const Fn& fn) const {
+    for (auto e : graph.edges(n, MethodFlag::UNPROTECTED)) {
+      GraphNode m = graph.getEdgeDst(e);
+      if (m == n)
+        continue;
+      if (!fn(m))
+        return false;
+      if (m_distance < 2)
+        continue;
+      for (auto f : graph.edges(m, MethodFlag::UNPROTECTED)) {
+        GraphNode k = graph.getEdgeDst(f);
+        if (k != n && !fn(k))
+          return false;
+      }
+    }
+    return true;
+  }
+
+  void compute(GraphTy& graph) {
+    InsertBag<GraphNode> bags[2];
+    InsertBag<GraphNode>* curr = &bags[0];
+    InsertBag<GraphNode>* next = &bags[1];
+    InsertBag<GraphNode> ready;
+    substrate::PerThreadStorage<std::vector<unsigned>> used;
+    GReduceMax<unsigned> maxColor;
+
+    do_all(galois::iterate(graph), [&](GraphNode n) {
+      colors[n] = UNCOLORED;
+      rounds[n] = 0;
+      curr->push(n);
+    });
+
+    while (!curr->empty()) {
+      // Nodes that come first among the uncolored nodes near them can all be
+      // colored at once, since none of them is near another
+      do_all(
+          galois::iterate(*curr),
+          [&](GraphNode n) {
+            uint64_t p = priority(n);
+            bool first = forNear(graph, n, [&](GraphNode m) {
+              return colors[m] != UNCOLORED || priority(m) < p;
+            });
+            if (first)
+              ready.push(n);
+            else
+              next->push(n);
+          },
+          galois::steal());
+
+      do_all(
+          galois::iterate(ready),
+          [&](GraphNode n) {
+            std::vector<unsigned>& u = *used.getLocal();
+            u.clear();
+            forNear(graph, n, [&](GraphNode m) {
+              if (colors[m] != UNCOLORED)
+                u.push_back(colors[m]);
+              return true;
+            });
+            std::sort(u.begin(), u.end());
+            unsigned c = 0;
+            for (unsigned x : u) {
+              if (x > c)
+                break;
+              if (x == c)
+                ++c;
+            }
+            colors[n] = c;
+            maxColor.update(c);
+          },
+          galois::steal());
+
+      ready.clear();
+      curr->clear();
+      std::swap(curr, next);
+    }
+
+    m_numColors = graph.size() ? maxColor.reduce() + 1 : 0;
+  }
+
+public:
+  explicit GraphColoring(GraphTy& graph, unsigned distance = 2)
+      : m_numColors(0), m_distance(distance), m_round(0) {
+    assert(distance == 1 || distance == 2);
+    colors.allocateInterleaved(graph.size());
+    rounds.allocateInterleaved(graph.size());
+    compute(graph);
+  }
+
+  unsigned numColors() const { return m_numColors; }
+  unsigned distance() const { return m_distance; }
+  size_t size() const { return colors.size(); }
+  unsigned color(GraphNode n) const { return colors[n]; }
+
+  //! Starts a round of worklists::Colored
+  unsigned beginRound() {
+    if (++m_round == 0) {
+      do_all(galois::iterate(size_t(0), size()),
+             [&](size_t n) { rounds[n] = 0; });
+      m_round = 1;
+    }
+    return m_round;
+  }
+
+  //! Returns whether n is not yet scheduled in round and schedules it
+  bool claim(GraphNode n, unsigned round) {
+    return __atomic_exchange_n(&rounds[n], round, __ATOMIC_RELAXED) != round;
+  }
+};
+
+} // namespace galois
+
+#endif
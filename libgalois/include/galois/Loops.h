@@ -20,7 +20,10 @@
 #ifndef GALOIS_LOOPS_H
 #define GALOIS_LOOPS_H
 
+#include <functional>
+
 #include "galois/config.h"
+#include "galois/runtime/Executor_Colored.h"
 #include "galois/runtime/Executor_Deterministic.h"
 #include "galois/runtime/Executor_DoAll.h"
 #include "galois/runtime/Executor_ForEach.h"
@@ -60,6 +63,12 @@ void for_each(const RangeFunc& rangeMaker, FunctionTy&& fn,
  * Operator should conform to <code>fn(item)</code> where item is a value from
  * the iteration range.
  *
+ * A do_all may be called from the operator of another loop. It then runs
+ * on the calling thread, which hands halves of what is left of the range to
+ * the threads of the enclosing loop that run out of work. The nested
+ * operator is part of the enclosing iteration: it must not acquire anything
+ * the enclosing operator has not acquired, nor use its UserContext.
+ *
  * @param rangeMaker an iterate range maker typically returned by
  * <code>galois::iterate(...)</code>
  * (@see galois::iterate()). rangeMaker is a functor which when called returns a
@@ -87,6 +96,22 @@ void on_each(FunctionTy&& fn, const Args&... args) {
   runtime::on_each_gen(std::forward<FunctionTy>(fn), std::make_tuple(args...));
 }
 
+/**
+ * Runs the given functions in parallel and returns once all of them have
+ * finished. Like a do_all, it may be called from the operator of another
+ * loop, where the functions are taken by threads of that loop that run out
+ * of work.
+ *
+ * @param fns functions conforming to <code>fn()</code>
+ */
+template <typename... FunctionTy>
+void parallel_invoke(FunctionTy&&... fns) {
+  std::function<void()> tasks[] = {std::function<void()>(std::ref(fns))...};
+  do_all(
+      iterate(size_t(0), sizeof...(fns)), [&](size_t i) { tasks[i](); },
+      chunk_size<1>(), steal());
+}
+
 /**
  * Preallocates hugepages on each thread.
  *
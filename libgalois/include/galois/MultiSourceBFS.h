@@ -0,0 +1,272 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_MULTISOURCEBFS_H
+#define GALOIS_MULTISOURCEBFS_H
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "galois/config.h"
+#include "galois/Bag.h"
+#include "galois/LargeArray.h"
+#include "galois/Loops.h"
+#include "galois/MethodFlags.h"
+
+namespace galois {
+
+/**
+ * Set of up to 64 * Words sources, one bit per source. The loops over the
+ * words have a fixed trip count, so the compiler unrolls and vectorizes
+ * them.
+ */
+template <unsigned Words>
+struct SourceSet {
+  static_assert(Words > 0, "a source set needs at least one word");
+
+  uint64_t words[Words];
+
+  void clear() {
+    for (unsigned i = 0; i < Words; ++i)
+      words[i] = 0;
+  }
+
+  void set(unsigned s) { words[s / 64] |= uint64_t(1) << (s % 64); }
+
+  bool test(unsigned s) const { return (words[s / 64] >> (s % 64)) & 1; }
+
+  bool any() const {
+    uint64_t x = 0;
+    for (unsigned i = 0; i < Words; ++i)
+      x |= words[i];
+    return x;
+  }
+
+  unsigned count() const {
+    unsigned c = 0;
+    for (unsigned i = 0; i < Words; ++i)
+      c += __builtin_popcountll(words[i]);
+    return c;
+  }
+
+  SourceSet operator&(const SourceSet& o) const {
+    SourceSet r;
+    for (unsigned i = 0; i < Words; ++i)
+      r.words[i] = words[i] & o.words[i];
+    return r;
+  }
+
+  //! The sources of this set that are not in o
+  SourceSet without(const SourceSet& o) const {
+    SourceSet r;
+    for (unsigned i = 0; i < Words; ++i)
+      r.words[i] = words[i] & ~o.words[i];
+    return r;
+  }
+
+  SourceSet& operator|=(const SourceSet& o) {
+    for (unsigned i = 0; i < Words; ++i)
+      words[i] |= o.words[i];
+    return *this;
+  }
+
+  //! Adds the sources of o, which other threads may be adding to as well
+  void atomicOr(const SourceSet& o) {
+    for (unsigned i = 0; i < Words; ++i) {
+      if (o.words[i] & ~__atomic_load_n(&words[i], __ATOMIC_RELAXED))
+        __atomic_fetch_or(&words[i], o.words[i], __ATOMIC_RELAXED);
+    }
+  }
+
+  //! Calls fn(s) on each source s of the set, in increasing order
+  template <typename Fn>
+  void forEach(const Fn& fn) const {
+    for (unsigned i = 0; i < Words; ++i) {
+      for (uint64_t x = words[i]; x; x &= x - 1)
+        fn(64 * i + __builtin_ctzll(x));
+    }
+  }
+};
+
+/**
+ * Bit-parallel breadth-first search from up to 64 * Words sources at once
+ * (MS-BFS). Each node keeps the set of sources that have reached it, and
+ * each level is a list of nodes with the set of sources that first reached
+ * them at that level. A node reached by many sources at the same level is
+ * expanded once for all of them, so the graph is read once per level rather
+ * than once per source and level.
+ *
+ * After run(), level(d) holds the nodes at distance d from some sources
+ * along with those sources, until the next run. It needs two source sets
+ * per node, 16 * Words bytes, plus the levels.
+ */
+template <typename GraphTy, unsigned Words = 1>
+class MultiSourceBFS {
+public:
+  typedef typename GraphTy::GraphNode GraphNode;
+  typedef SourceSet<Words> Sources;
+
+  static constexpr unsigned MAX_SOURCES = 64 * Words;
+
+  //! A node along with the sources that first reached it at a level
+  struct Visit {
+    GraphNode node;
+    Sources sources;
+  };
+
+  typedef InsertBag<Visit> Level;
+
+private:
+  static constexpr unsigned CHUNK_SIZE = 64;
+
+  GraphTy& graph;
+  //! Sources that have reached each node in previous levels
+  LargeArray<Sources> seen;
+  //! Sources that reach each node at the next level
+  LargeArray<Sources> next;
+  //! Last level stamp that queued each node for the next level
+  LargeArray<unsigned> queued;
+  unsigned stamp;
+
+  std::deque<Level> levels;
+  size_t m_numLevels;
+  InsertBag<GraphNode> reached;
+
+  unsigned nextStamp() {
+    if (++stamp == 0) {
+      galois::do_all(
+          galois::iterate(size_t(0), queued.size()),
+          [&](size_t n) { queued[n] = 0; }, galois::no_stats());
+      stamp = 1;
+    }
+    return stamp;
+  }
+
+  //! Turns the nodes reached from the last level into a new level
+  void commitLevel() {
+    if (levels.size() == m_numLevels)
+      levels.emplace_back();
+    Level& level = levels[m_numLevels++];
+    galois::do_all(
+        galois::iterate(reached),
+        [&](GraphNode n) {
+          Sources s = next[n];
+          next[n].clear();
+          seen[n] |= s;
+          level.push(Visit{n, s});
+        },
+        galois::steal(), galois::no_stats(),
+        galois::loopname("MultiSourceBFSCommit"));
+    reached.clear();
+  }
+
+  //! Forgets the sources of the previous run
+  void reset() {
+    for (size_t d = 0; d < m_numLevels; ++d) {
+      galois::do_all(
+          galois::iterate(levels[d]),
+          [&](const Visit& v) { seen[v.node].clear(); }, galois::steal(),
+          galois::no_stats());
+      levels[d].clear();
+    }
+    m_numLevels = 0;
+  }
+
+public:
+  explicit MultiSourceBFS(GraphTy& g) : graph(g), stamp(0), m_numLevels(0) {
+    seen.allocateInterleaved(graph.size());
+    next.allocateInterleaved(graph.size());
+    queued.allocateInterleaved(graph.size());
+    galois::do_all(
+        galois::iterate(size_t(0), graph.size()),
+        [&](size_t n) {
+          seen[n].clear();
+          next[n].clear();
+          queued[n] = 0;
+        },
+        galois::no_stats());
+  }
+
+  /**
+   * Runs the BFS of sources[i] as source i, for up to MAX_SOURCES sources.
+   * For each edge src -> dst such that dst is first reached at the next
+   * level by some sources that reached src at this level, edgeFn(src, dst,
+   * fresh) is called in parallel with those sources. Its calls for the
+   * edges out of a level all happen before those out of the next level.
+   */
+  template <typename EdgeFn>
+  void run(const std::vector<GraphNode>& sources, const EdgeFn& edgeFn) {
+    assert(sources.size() <= MAX_SOURCES);
+    reset();
+
+    for (unsigned i = 0; i < sources.size(); ++i) {
+      if (!next[sources[i]].any())
+        reached.push(sources[i]);
+      next[sources[i]].set(i);
+    }
+    commitLevel();
+
+    while (!levels[m_numLevels - 1].empty()) {
+      unsigned mark = nextStamp();
+      galois::do_all(
+          galois::iterate(levels[m_numLevels - 1]),
+          [&](const Visit& v) {
+            for (auto e : graph.edges(v.node, MethodFlag::UNPROTECTED)) {
+              GraphNode dst = graph.getEdgeDst(e);
+              Sources fresh = v.sources.without(seen[dst]);
+              if (!fresh.any())
+                continue;
+              edgeFn(v.node, dst, fresh);
+              next[dst].atomicOr(fresh);
+              unsigned old = queued[dst];
+              if (old != mark &&
+                  __sync_bool_compare_and_swap(&queued[dst], old, mark))
+                reached.push(dst);
+            }
+          },
+          galois::steal(), galois::chunk_size<CHUNK_SIZE>(),
+          galois::no_stats(), galois::loopname("MultiSourceBFS"));
+      commitLevel();
+    }
+    // The last level is empty
+    --m_numLevels;
+  }
+
+  void run(const std::vector<GraphNode>& sources) {
+    run(sources, [](GraphNode, GraphNode, const Sources&) {});
+  }
+
+  //! Number of non-empty levels of the last run
+  size_t numLevels() const { return m_numLevels; }
+
+  //! Nodes at distance d from some sources of the last run
+  Level& level(size_t d) {
+    assert(d < m_numLevels);
+    return levels[d];
+  }
+
+  //! Sources of the last run that reach n
+  const Sources& reachedBy(GraphNode n) const { return seen[n]; }
+};
+
+} // namespace galois
+
+#endif
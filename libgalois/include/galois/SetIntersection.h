@@ -0,0 +1,149 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file galois/SetIntersection.h
+ *
+ * Intersection kernels for sorted sets of vertex ids (e.g., adjacency lists
+ * of a CSR graph) shared by triangle counting and the graph miners. Every
+ * kernel has a count-only and a materializing variant. Merge kernels use
+ * AVX-512 or AVX2 block compares when the CPU supports them (checked at
+ * runtime); galloping handles sets of very different sizes; bitmap kernels
+ * intersect with a hub vertex whose neighbors are kept as a bitmap.
+ *
+ * All sets must be sorted in strictly increasing order.
+ */
+
+#ifndef GALOIS_SETINTERSECTION_H
+#define GALOIS_SETINTERSECTION_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "galois/config.h"
+
+namespace galois {
+namespace intersection {
+
+//! Instruction set used by the merge kernels
+enum class Kernel { Scalar, AVX2, AVX512 };
+
+//! Returns the widest merge kernel the running CPU supports
+Kernel bestKernel();
+
+//! Returns true if the running CPU supports kernel k
+bool isSupported(Kernel k);
+
+//! Galloping is used instead of merging when one set is this many times
+//! larger than the other
+constexpr size_t GALLOP_RATIO = 32;
+
+/**
+ * Counts the elements common to a and b with a merge.
+ *
+ * @param a First set
+ * @param na Size of a
+ * @param b Second set
+ * @param nb Size of b
+ * @param k Kernel to use; must be supported by the CPU
+ * @returns Number of common elements
+ */
+size_t countMerge(const uint32_t* a, size_t na, const uint32_t* b, size_t nb,
+                  Kernel k = bestKernel());
+
+/**
+ * Writes the elements common to a and b to out with a merge.
+ *
+ * @param out Output with room for min(na, nb) elements
+ * @returns Number of elements written
+ */
+size_t collectMerge(const uint32_t* a, size_t na, const uint32_t* b,
+                    size_t nb, uint32_t* out, Kernel k = bestKernel());
+
+/**
+ * Counts the elements common to a small and a large set by galloping
+ * (exponential then binary search) through the large set.
+ *
+ * @param small Smaller set
+ * @param ns Size of small
+ * @param large Larger set
+ * @param nl Size of large
+ * @returns Number of common elements
+ */
+size_t countGallop(const uint32_t* small, size_t ns, const uint32_t* large,
+                   size_t nl);
+
+//! Materializing variant of countGallop; out needs room for ns elements
+size_t collectGallop(const uint32_t* small, size_t ns, const uint32_t* large,
+                     size_t nl, uint32_t* out);
+
+/**
+ * Counts the elements of b whose bit is set in bitmap (e.g., the neighbors
+ * of a hub vertex).
+ *
+ * @param bitmap Bitmap with a bit for every possible element of b
+ * @param b Set to intersect with the bitmap
+ * @param nb Size of b
+ * @returns Number of common elements
+ */
+size_t countBitmap(const uint64_t* bitmap, const uint32_t* b, size_t nb);
+
+//! Materializing variant of countBitmap; out needs room for nb elements
+size_t collectBitmap(const uint64_t* bitmap, const uint32_t* b, size_t nb,
+                     uint32_t* out);
+
+/**
+ * Counts the elements common to a and b, galloping if their sizes are skewed
+ * and merging with the best kernel otherwise.
+ *
+ * @returns Number of common elements
+ */
+inline size_t count(const uint32_t* a, size_t na, const uint32_t* b,
+                    size_t nb) {
+  if (na * GALLOP_RATIO < nb) {
+    return countGallop(a, na, b, nb);
+  }
+  if (nb * GALLOP_RATIO < na) {
+    return countGallop(b, nb, a, na);
+  }
+  return countMerge(a, na, b, nb);
+}
+
+/**
+ * Writes the elements common to a and b to out, galloping if their sizes are
+ * skewed and merging with the best kernel otherwise.
+ *
+ * @param out Output with room for min(na, nb) elements
+ * @returns Number of elements written
+ */
+inline size_t collect(const uint32_t* a, size_t na, const uint32_t* b,
+                      size_t nb, uint32_t* out) {
+  if (na * GALLOP_RATIO < nb) {
+    return collectGallop(a, na, b, nb, out);
+  }
+  if (nb * GALLOP_RATIO < na) {
+    return collectGallop(b, nb, a, na, out);
+  }
+  return collectMerge(a, na, b, nb, out);
+}
+
+} // namespace intersection
+} // namespace galois
+
+#endif
@@ -277,6 +277,60 @@ struct fixed_neighborhood : public trait_has_type<bool>,
 struct intent_to_read_tag {};
 struct intent_to_read : public trait_has_type<bool>, intent_to_read_tag {};
 
+/**
+ * Indicates that the operator doesn't lock what it acquires with
+ * MethodFlag::READ. The reads are validated when the operator calls
+ * UserContext::cautiousPoint(), and the iteration aborts if another one
+ * changed what it read. The operator must call it after its last acquire
+ * and before its first write; an iteration that read without reaching it
+ * is a fatal error. Only used by the non-deterministic executor; see
+ * galois::runtime::OptimisticRuntimeContext.
+ */
+struct optimistic_reads_tag {};
+struct optimistic_reads : public trait_has_type<bool>, optimistic_reads_tag {};
+
+/**
+ * Indicates that the loop should adapt to its abort rate: past one abort in
+ * four iterations, threads back off after each abort, and if aborts stay
+ * that frequent, aborted work runs on one thread once the parallel phase
+ * runs out of work. Suits loops whose conflicts concentrate on a few items;
+ * a loop with many scattered conflicts may run mostly serially. Only used
+ * by the non-deterministic executor; see galois::runtime::ContentionManager.
+ */
+struct contention_manager_tag {};
+struct contention_manager : public trait_has_type<bool>,
+                            contention_manager_tag {};
+
+/**
+ * Indicates the operator is bound by memory latency and has a function that
+ * prefetches the data the operator touches for an item, e.g., the data of
+ * the neighbors of a node with __builtin_prefetch. The loop calls it on the
+ * item Distance items ahead of the one it runs the operator on, so that the
+ * cache misses of that many items overlap.
+ *
+ * The function should have the signature <code>void (A)</code> where A is
+ * the type of active elements and must not change anything. Used by
+ * galois::do_all and by galois::for_each when it does not detect conflicts.
+ */
+struct interleave_tag {};
+template <unsigned Distance, typename T>
+struct s_interleave : public trait_has_value<T>, interleave_tag {
+  static_assert(Distance > 0, "prefetch distance must be positive");
+  static constexpr unsigned distance = Distance;
+  s_interleave(const T& t) : trait_has_value<T>(t) {}
+  s_interleave(T&& t) : trait_has_value<T>(std::move(t)) {}
+
+  template <typename A>
+  void prefetch(const A& a) const {
+    this->value(a);
+  }
+};
+
+template <unsigned Distance = 8, typename T>
+s_interleave<Distance, std::decay_t<T>> interleave(T&& prefetch) {
+  return s_interleave<Distance, std::decay_t<T>>(std::forward<T>(prefetch));
+}
+
 /**
  * Indicates the operator has a function that visits the neighborhood of the
  * operator without modifying it.
@@ -331,6 +385,20 @@ struct local_state_tag {};
 template <typename T>
 struct local_state : public trait_has_type<T>, local_state_tag {};
 
+/**
+ * Lets the deterministic scheduler inspect round k+1 of an operator while
+ * round k commits, which saves a barrier per round. Only for operators
+ * without a fixed neighborhood or intent to read.
+ *
+ * The schedule, and hence the result, is the same for any number of
+ * threads, as without this trait. The cost is that an iteration of round
+ * k+1 that needs a lock of round k is deferred to a later round, so rounds
+ * may commit fewer iterations, and a round that commits nothing makes the
+ * next round wait for a full barrier before it is inspected.
+ */
+struct det_pipeline_tag {};
+struct det_pipeline : public trait_has_type<bool>, det_pipeline_tag {};
+
 // TODO: separate to libdist
 /** For distributed Galois **/
 struct op_tag {};
@@ -366,6 +434,17 @@ public:
   chunk_size(unsigned cs = SZ) : trait_has_value(clamp(cs)) {}
 };
 
+/**
+ * Maximum number of edges per tile for ranges made by
+ * galois::iterate_edge_tiles(). The default of 0 lets the range pick the
+ * size from the degrees of the graph.
+ */
+struct edge_tile_tag {};
+template <unsigned SZ = 0>
+struct edge_tile : public trait_has_value<unsigned>, edge_tile_tag {
+  edge_tile(unsigned sz = SZ) : trait_has_value(sz) {}
+};
+
 typedef worklists::PerSocketChunkFIFO<chunk_size<>::value> defaultWL;
 
 namespace internal {
@@ -0,0 +1,191 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_UPDATECOMBINER_H
+#define GALOIS_UPDATECOMBINER_H
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "galois/config.h"
+#include "galois/gstl.h"
+#include "galois/Loops.h"
+#include "galois/Reduction.h"
+#include "galois/Threads.h"
+#include "galois/substrate/PerThreadStorage.h"
+
+namespace galois {
+
+/**
+ * Combines scattered updates to destinations 0..numDsts-1 before applying
+ * them. Instead of updating a destination right away, push(dst, value)
+ * appends the update to a buffer of the calling thread for the block of
+ * destinations dst falls in. flush() then hands each block to one thread,
+ * which merges the values of each destination of the block with ReduceFn
+ * and then calls ApplyFn(dst, value) once per destination, in order of
+ * destination. Hubs that would get an atomic update per in-edge get one per
+ * flush, and the destinations of a block stay in cache while it is applied.
+ *
+ * When updates are sparse they rarely collide and going through the
+ * buffers costs more than it saves, so if a round between two flushes has
+ * fewer than minDensity updates per destination, push() calls ApplyFn
+ * directly in the next round. ApplyFn must thus be safe to call
+ * concurrently on the same destination, typically by updating it
+ * atomically; when combining, two threads never apply to the same block at
+ * once, so those atomics are uncontended. A minDensity of 0 always combines.
+ *
+ * ReduceFn is a merge function as for galois::Reducible and must be
+ * associative and commutative, since updates are merged in no particular
+ * order. Updates pushed in a round are only visible after the flush that
+ * ends it, or right away in rounds that apply directly, so the combiner
+ * suits round-based operators that can tolerate either.
+ */
+template <typename T, typename ReduceFn, typename ApplyFn>
+class UpdateCombiner : public ReduceFn, public ApplyFn {
+public:
+  typedef T value_type;
+
+private:
+  struct Update {
+    uint32_t dst;
+    T value;
+  };
+
+  typedef gstl::Vector<Update> Buffer;
+
+  //! Values merged per destination of the block being applied
+  struct Scratch {
+    std::vector<T> values;
+    std::vector<uint8_t> seen;
+  };
+
+  size_t numDsts;
+  unsigned blockShift;
+  size_t numBlocks;
+  double minDensity;
+  bool direct;
+
+  substrate::PerThreadStorage<std::vector<Buffer>> buffers;
+  substrate::PerThreadStorage<Scratch> scratch;
+  GAccumulator<size_t> numUpdates;
+
+  //! Blocks of up to 64K destinations, but at least 4 per thread
+  static unsigned pickBlockShift(size_t numDsts) {
+    unsigned shift = 16;
+    while (shift > 6 && (numDsts >> shift) < 4 * size_t(getActiveThreads()))
+      --shift;
+    return shift;
+  }
+
+  void applyBlock(size_t block) {
+    Scratch& s = *scratch.getLocal();
+    if (s.seen.empty()) {
+      s.values.resize(size_t(1) << blockShift);
+      s.seen.resize(size_t(1) << blockShift);
+    }
+
+    bool any            = false;
+    const uint32_t mask = (uint32_t(1) << blockShift) - 1;
+    for (unsigned t = 0; t < buffers.size(); ++t) {
+      Buffer& buf = (*buffers.getRemote(t))[block];
+      for (const Update& u : buf) {
+        uint32_t i = u.dst & mask;
+        if (s.seen[i]) {
+          s.values[i] = ReduceFn::operator()(s.values[i], u.value);
+        } else {
+          s.values[i] = u.value;
+          s.seen[i]   = 1;
+        }
+      }
+      any |= !buf.empty();
+      buf.clear();
+    }
+    if (!any)
+      return;
+
+    // In order of destination
+    size_t base = block << blockShift;
+    for (uint32_t i = 0; i <= mask; ++i) {
+      if (s.seen[i]) {
+        s.seen[i] = 0;
+        ApplyFn::operator()(base + i, s.values[i]);
+      }
+    }
+  }
+
+public:
+  UpdateCombiner(size_t numDsts, ReduceFn reduceFn, ApplyFn applyFn,
+                 double minDensity = 1.0 / 16)
+      : ReduceFn(reduceFn), ApplyFn(applyFn), numDsts(numDsts),
+        blockShift(pickBlockShift(numDsts)),
+        numBlocks((numDsts >> blockShift) + 1), minDensity(minDensity),
+        direct(false) {
+    assert(numDsts <= UINT32_MAX);
+    for (unsigned t = 0; t < buffers.size(); ++t)
+      buffers.getRemote(t)->resize(numBlocks);
+  }
+
+  //! Updates dst with value, now or at the next flush
+  void push(size_t dst, const T& value) {
+    assert(dst < numDsts);
+    numUpdates += 1;
+    if (direct) {
+      ApplyFn::operator()(dst, value);
+    } else {
+      (*buffers.getLocal())[dst >> blockShift].push_back(
+          Update{uint32_t(dst), value});
+    }
+  }
+
+  //! Whether push() currently applies updates right away
+  bool isDirect() const { return direct; }
+
+  /**
+   * Applies the buffered updates and picks how to apply the updates of the
+   * next round. Only valid outside the parallel region.
+   */
+  void flush() {
+    if (!direct) {
+      galois::do_all(
+          galois::iterate(size_t(0), numBlocks),
+          [&](size_t block) { applyBlock(block); }, galois::steal(),
+          galois::chunk_size<1>(), galois::no_stats(),
+          galois::loopname("UpdateCombinerFlush"));
+    }
+    direct = numUpdates.reduce() < minDensity * numDsts;
+    numUpdates.reset();
+  }
+};
+
+/**
+ * make_update_combiner creates an UpdateCombiner for numDsts destinations
+ * from a merge function and an apply function.
+ */
+template <typename T, typename ReduceFn, typename ApplyFn>
+auto make_update_combiner(size_t numDsts, const ReduceFn& reduceFn,
+                          const ApplyFn& applyFn,
+                          double minDensity = 1.0 / 16) {
+  return UpdateCombiner<T, ReduceFn, ApplyFn>(numDsts, reduceFn, applyFn,
+                                              minDensity);
+}
+
+} // namespace galois
+
+#endif
@@ -54,6 +54,9 @@ protected:
   bool firstPassFlag = false;
   void* localState   = nullptr;
 
+  //! validates optimistic reads at the cautious point
+  runtime::OptimisticRuntimeContext* optimisticContext = nullptr;
+
   void __resetAlloc() { IterationAllocatorBase.clear(); }
 
   void __setFirstPass(void) { firstPassFlag = true; }
@@ -68,6 +71,10 @@ protected:
 
   void __setFastPushBack(FastPushBack f) { fastPushBack = f; }
 
+  void __setOptimisticContext(runtime::OptimisticRuntimeContext* c) {
+    optimisticContext = c;
+  }
+
 public:
   UserContext()
       : IterationAllocatorBase(),
@@ -128,6 +135,8 @@ public:
   void cautiousPoint() {
     if (isFirstPass()) {
       galois::runtime::signalFailSafe();
+    } else if (optimisticContext) {
+      optimisticContext->validate();
     }
   }
 };
@@ -27,6 +27,8 @@
 #define GALOIS_GRAPHS_BUFGRAPH_H
 
 #include <fstream>
+#include <future>
+#include <string>
 
 #include <boost/iterator/counting_iterator.hpp>
 
@@ -75,6 +77,26 @@ private:
   //! specifies whether or not the graph is loaded
   bool graphLoaded = false;
 
+  // edge window: range of edges currently resident in the edge buffers
+  //! first global edge id resident in the edge buffers
+  uint64_t windowEdgeBegin = 0;
+  //! one past the last global edge id resident in the edge buffers
+  uint64_t windowEdgeEnd = 0;
+  //! name of the file loaded; needed to stream in edge windows
+  std::string graphFileName;
+
+  // staging buffers for an edge window being prefetched
+  //! staging buffer for edge destinations of the prefetched window
+  uint32_t* nextEdgeDestBuffer = nullptr;
+  //! staging buffer for edge data of the prefetched window
+  EdgeDataType* nextEdgeDataBuffer = nullptr;
+  //! first global edge of the prefetched window
+  uint64_t nextWindowBegin = 0;
+  //! one past the last global edge of the prefetched window
+  uint64_t nextWindowEnd = 0;
+  //! handle on the read of the prefetched window (if any)
+  std::future<void> pendingWindow;
+
   // accumulators for tracking bytes read
   //! number of bytes read related to the out index buffer
   galois::GAccumulator<uint64_t> numBytesReadOutIndex;
@@ -122,6 +144,36 @@ private:
     nodeOffset = nodeStart;
   }
 
+  /**
+   * Read edge destinations from the file into a provided buffer.
+   *
+   * @param graphFile loaded file for the graph
+   * @param edgeStart the first edge to read
+   * @param numEdgesToLoad number of edges to read
+   * @param numGlobalNodes total number of nodes in the graph file; needed
+   * to determine offset into the file
+   * @param destBuffer buffer to read into; must fit numEdgesToLoad edges
+   */
+  void readEdgeDest(std::ifstream& graphFile, uint64_t edgeStart,
+                    uint64_t numEdgesToLoad, uint64_t numGlobalNodes,
+                    uint32_t* destBuffer) {
+    // position to start of contiguous chunk of edges to read
+    uint64_t readPosition = (4 + numGlobalNodes) * sizeof(uint64_t) +
+                            (sizeof(uint32_t) * edgeStart);
+    graphFile.seekg(readPosition);
+
+    uint64_t numBytesToLoad = numEdgesToLoad * sizeof(uint32_t);
+    uint64_t bytesRead      = 0;
+    while (numBytesToLoad > 0) {
+      graphFile.read(((char*)destBuffer) + bytesRead, numBytesToLoad);
+      size_t numRead = graphFile.gcount();
+      numBytesToLoad -= numRead;
+      bytesRead += numRead;
+    }
+
+    assert(numBytesToLoad == 0);
+  }
+
   /**
    * Load the edge destination information from the file.
    *
@@ -144,25 +196,71 @@ private:
       GALOIS_DIE("Failed to allocate memory for edge dest buffer.");
     }
 
-    // position to start of contiguous chunk of edges to read
-    uint64_t readPosition = (4 + numGlobalNodes) * sizeof(uint64_t) +
-                            (sizeof(uint32_t) * edgeStart);
-    graphFile.seekg(readPosition);
+    readEdgeDest(graphFile, edgeStart, numEdgesToLoad, numGlobalNodes,
+                 edgeDestBuffer);
+    // save edge offset of this graph for later use
+    edgeOffset      = edgeStart;
+    windowEdgeBegin = edgeStart;
+    windowEdgeEnd   = edgeStart + numEdgesToLoad;
+  }
 
-    uint64_t numBytesToLoad = numEdgesToLoad * sizeof(uint32_t);
+  /**
+   * Read edge data from the file into a provided buffer.
+   *
+   * @tparam EdgeType must be non-void in order to call this function
+   *
+   * @param edgeStart the first edge to read
+   * @param numEdgesToLoad number of edges to read
+   * @param numGlobalNodes total number of nodes in the graph file; needed
+   * to determine offset into the file
+   * @param numGlobalEdges total number of edges in the graph file; needed
+   * to determine offset into the file
+   * @param dataBuffer buffer to read into; must fit numEdgesToLoad edges
+   */
+  template <
+      typename EdgeType,
+      typename std::enable_if<!std::is_void<EdgeType>::value>::type* = nullptr>
+  void readEdgeData(std::ifstream& graphFile, uint64_t edgeStart,
+                    uint64_t numEdgesToLoad, uint64_t numGlobalNodes,
+                    uint64_t numGlobalEdges, EdgeDataType* dataBuffer) {
+    // position after nodes + edges
+    uint64_t baseReadPosition = (4 + numGlobalNodes) * sizeof(uint64_t) +
+                                (sizeof(uint32_t) * numGlobalEdges);
+
+    // version 1 padding TODO make version agnostic
+    if (numGlobalEdges % 2) {
+      baseReadPosition += sizeof(uint32_t);
+    }
+
+    // jump to first byte of edge data
+    uint64_t readPosition =
+        baseReadPosition + (sizeof(EdgeDataType) * edgeStart);
+    graphFile.seekg(readPosition);
+    uint64_t numBytesToLoad = numEdgesToLoad * sizeof(EdgeDataType);
     uint64_t bytesRead      = 0;
+
     while (numBytesToLoad > 0) {
-      graphFile.read(((char*)this->edgeDestBuffer) + bytesRead, numBytesToLoad);
+      graphFile.read(((char*)dataBuffer) + bytesRead, numBytesToLoad);
       size_t numRead = graphFile.gcount();
       numBytesToLoad -= numRead;
       bytesRead += numRead;
     }
 
     assert(numBytesToLoad == 0);
-    // save edge offset of this graph for later use
-    edgeOffset = edgeStart;
   }
 
+  /**
+   * Read edge data function for when the edge data type is void, i.e.
+   * no edge data to read.
+   *
+   * @tparam EdgeType if EdgeType is void, this function will be used
+   */
+  template <
+      typename EdgeType,
+      typename std::enable_if<std::is_void<EdgeType>::value>::type* = nullptr>
+  void readEdgeData(std::ifstream&, uint64_t, uint64_t, uint64_t, uint64_t,
+                    EdgeDataType*) {}
+
   /**
    * Load the edge data information from the file.
    *
@@ -195,30 +293,8 @@ private:
       GALOIS_DIE("Failed to allocate memory for edge data buffer.");
     }
 
-    // position after nodes + edges
-    uint64_t baseReadPosition = (4 + numGlobalNodes) * sizeof(uint64_t) +
-                                (sizeof(uint32_t) * numGlobalEdges);
-
-    // version 1 padding TODO make version agnostic
-    if (numGlobalEdges % 2) {
-      baseReadPosition += sizeof(uint32_t);
-    }
-
-    // jump to first byte of edge data
-    uint64_t readPosition =
-        baseReadPosition + (sizeof(EdgeDataType) * edgeStart);
-    graphFile.seekg(readPosition);
-    uint64_t numBytesToLoad = numEdgesToLoad * sizeof(EdgeDataType);
-    uint64_t bytesRead      = 0;
-
-    while (numBytesToLoad > 0) {
-      graphFile.read(((char*)this->edgeDataBuffer) + bytesRead, numBytesToLoad);
-      size_t numRead = graphFile.gcount();
-      numBytesToLoad -= numRead;
-      bytesRead += numRead;
-    }
-
-    assert(numBytesToLoad == 0);
+    readEdgeData<EdgeType>(graphFile, edgeStart, numEdgesToLoad,
+                           numGlobalNodes, numGlobalEdges, edgeDataBuffer);
   }
 
   /**
@@ -248,6 +324,9 @@ private:
     edgeOffset     = 0;
     numLocalNodes  = 0;
     numLocalEdges  = 0;
+    windowEdgeBegin = 0;
+    windowEdgeEnd   = 0;
+    graphFileName.clear();
     resetReadCounters();
   }
 
@@ -255,6 +334,7 @@ private:
    * Free all of the buffers in memory.
    */
   void freeMemory() {
+    discardPrefetch();
     free(outIndexBuffer);
     outIndexBuffer = nullptr;
     free(edgeDestBuffer);
@@ -263,6 +343,58 @@ private:
     edgeDataBuffer = nullptr;
   }
 
+  /**
+   * Allocates a pair of edge destination/data buffers for a window.
+   *
+   * @param numEdges number of edges the buffers need to fit
+   * @param destBuffer set to the allocated edge destination buffer
+   * @param dataBuffer set to the allocated edge data buffer (untouched if
+   * there is no edge data)
+   */
+  void allocateWindow(uint64_t numEdges, uint32_t*& destBuffer,
+                      EdgeDataType*& dataBuffer) {
+    destBuffer = (uint32_t*)malloc(sizeof(uint32_t) * numEdges);
+    if (destBuffer == nullptr) {
+      GALOIS_DIE("Failed to allocate memory for edge window buffer.");
+    }
+    if constexpr (!std::is_void<EdgeDataType>::value) {
+      dataBuffer = (EdgeDataType*)malloc(sizeof(EdgeDataType) * numEdges);
+      if (dataBuffer == nullptr) {
+        GALOIS_DIE("Failed to allocate memory for edge data window buffer.");
+      }
+    }
+  }
+
+  /**
+   * Reads the edges [windowBegin, windowEnd) from the graph file into the
+   * provided buffers. Opens its own stream so it is safe to call from a
+   * thread other than the one using the graph.
+   */
+  void readWindow(uint64_t windowBegin, uint64_t windowEnd,
+                  uint32_t* destBuffer, EdgeDataType* dataBuffer) {
+    std::ifstream graphFile(graphFileName.c_str());
+    readEdgeDest(graphFile, windowBegin, windowEnd - windowBegin, globalSize,
+                 destBuffer);
+    readEdgeData<EdgeDataType>(graphFile, windowBegin, windowEnd - windowBegin,
+                               globalSize, globalEdgeSize, dataBuffer);
+    graphFile.close();
+  }
+
+  /**
+   * Waits on an outstanding prefetch (if any) and frees its staging buffers.
+   */
+  void discardPrefetch() {
+    if (pendingWindow.valid()) {
+      pendingWindow.wait();
+    }
+    free(nextEdgeDestBuffer);
+    nextEdgeDestBuffer = nullptr;
+    free(nextEdgeDataBuffer);
+    nextEdgeDataBuffer = nullptr;
+    nextWindowBegin    = 0;
+    nextWindowEnd      = 0;
+  }
+
 public:
   /**
    * Class vars should be initialized by in-class initialization; all
@@ -373,6 +505,158 @@ public:
     graphFile.close();
   }
 
+  /**
+   * Given a node/edge range to load, loads only the out indices of the
+   * specified portion of the graph. Edges are brought into memory in bounded
+   * windows with loadEdgeWindow, so the edge array of the range is never
+   * resident all at once.
+   *
+   * @param filename name of graph to load; should be in Galois binary graph
+   * format
+   * @param nodeStart First node to load
+   * @param nodeEnd Last node to load, non-inclusive
+   * @param edgeStart First edge of the range; should correspond to first edge
+   * of first node
+   * @param edgeEnd Last edge of the range, non-inclusive
+   * @param numGlobalNodes Total number of nodes in the graph
+   * @param numGlobalEdges Total number of edges in the graph
+   */
+  void loadPartialGraphIndex(const std::string& filename, uint64_t nodeStart,
+                             uint64_t nodeEnd, uint64_t edgeStart,
+                             uint64_t edgeEnd, uint64_t numGlobalNodes,
+                             uint64_t numGlobalEdges) {
+    if (graphLoaded) {
+      GALOIS_DIE("Cannot load an buffered graph more than once.");
+    }
+
+    std::ifstream graphFile(filename.c_str());
+
+    globalSize     = numGlobalNodes;
+    globalEdgeSize = numGlobalEdges;
+    graphFileName  = filename;
+
+    assert(nodeEnd >= nodeStart);
+    numLocalNodes = nodeEnd - nodeStart;
+    loadOutIndex(graphFile, nodeStart, numLocalNodes);
+
+    assert(edgeEnd >= edgeStart);
+    numLocalEdges   = edgeEnd - edgeStart;
+    edgeOffset      = edgeStart;
+    windowEdgeBegin = edgeStart;
+    windowEdgeEnd   = edgeStart;
+    graphLoaded     = true;
+
+    graphFile.close();
+  }
+
+  /**
+   * Determines the end of an edge window starting at some node such that
+   * the window has at most maxEdges edges (but always at least one node).
+   *
+   * @param beginNode global id of first node of the window
+   * @param endNode global id of the node to not go past (non-inclusive)
+   * @param maxEdges soft cap on number of edges in the window
+   * @returns global id one past the last node of the window
+   */
+  uint64_t edgeWindowEnd(uint64_t beginNode, uint64_t endNode,
+                         uint64_t maxEdges) {
+    if (beginNode >= endNode) {
+      return endNode;
+    }
+    uint64_t firstEdge = *edgeBegin(beginNode);
+    // out indices are a prefix sum, so binary search for the last node that
+    // still fits
+    uint64_t lo = beginNode + 1;
+    uint64_t hi = endNode;
+    while (lo < hi) {
+      uint64_t mid = lo + (hi - lo + 1) / 2;
+      if (outIndexBuffer[mid - 1 - nodeOffset] - firstEdge <= maxEdges) {
+        lo = mid;
+      } else {
+        hi = mid - 1;
+      }
+    }
+    return lo;
+  }
+
+  /**
+   * Makes the edges of the nodes [beginNode, endNode) resident in memory,
+   * replacing whatever edge window was loaded before. If the window was
+   * prefetched, the prefetched buffers are used.
+   *
+   * @param beginNode global id of first node of the window
+   * @param endNode global id one past the last node of the window
+   */
+  void loadEdgeWindow(uint64_t beginNode, uint64_t endNode) {
+    if (!graphLoaded) {
+      GALOIS_DIE("Graph hasn't been loaded yet.");
+    }
+    uint64_t windowBegin = beginNode < endNode ? *edgeBegin(beginNode) : 0;
+    uint64_t windowEnd   = beginNode < endNode ? *edgeEnd(endNode - 1) : 0;
+
+    free(edgeDestBuffer);
+    edgeDestBuffer = nullptr;
+    free(edgeDataBuffer);
+    edgeDataBuffer = nullptr;
+
+    if (pendingWindow.valid() && nextWindowBegin == windowBegin &&
+        nextWindowEnd == windowEnd) {
+      pendingWindow.get();
+      std::swap(edgeDestBuffer, nextEdgeDestBuffer);
+      std::swap(edgeDataBuffer, nextEdgeDataBuffer);
+      nextWindowBegin = 0;
+      nextWindowEnd   = 0;
+    } else {
+      discardPrefetch();
+      if (windowEnd > windowBegin) {
+        allocateWindow(windowEnd - windowBegin, edgeDestBuffer,
+                       edgeDataBuffer);
+        readWindow(windowBegin, windowEnd, edgeDestBuffer, edgeDataBuffer);
+      }
+    }
+
+    windowEdgeBegin = windowBegin;
+    windowEdgeEnd   = windowEnd;
+  }
+
+  /**
+   * Starts reading the edges of the nodes [beginNode, endNode) in the
+   * background so that a later loadEdgeWindow on the same range does not
+   * have to wait on disk. At most one window is prefetched at a time.
+   *
+   * @param beginNode global id of first node of the window
+   * @param endNode global id one past the last node of the window
+   */
+  void prefetchEdgeWindow(uint64_t beginNode, uint64_t endNode) {
+    discardPrefetch();
+    if (beginNode >= endNode) {
+      return;
+    }
+    nextWindowBegin = *edgeBegin(beginNode);
+    nextWindowEnd   = *edgeEnd(endNode - 1);
+    if (nextWindowEnd == nextWindowBegin) {
+      return;
+    }
+    allocateWindow(nextWindowEnd - nextWindowBegin, nextEdgeDestBuffer,
+                   nextEdgeDataBuffer);
+    pendingWindow = std::async(std::launch::async, [this]() {
+      readWindow(nextWindowBegin, nextWindowEnd, nextEdgeDestBuffer,
+                 nextEdgeDataBuffer);
+    });
+  }
+
+  /**
+   * Frees the resident and prefetched edge windows, keeping the out indices.
+   */
+  void freeEdgeWindow() {
+    discardPrefetch();
+    free(edgeDestBuffer);
+    edgeDestBuffer = nullptr;
+    free(edgeDataBuffer);
+    edgeDataBuffer  = nullptr;
+    windowEdgeBegin = windowEdgeEnd;
+  }
+
   //! Edge iterator typedef
   using EdgeIterator = boost::counting_iterator<uint64_t>;
   /**
@@ -442,12 +726,12 @@ public:
     if (numLocalEdges == 0) {
       return 0;
     }
-    assert(edgeOffset <= globalEdgeID);
-    assert(globalEdgeID < (edgeOffset + numLocalEdges));
+    assert(windowEdgeBegin <= globalEdgeID);
+    assert(globalEdgeID < windowEdgeEnd);
 
     numBytesReadEdgeDest += sizeof(uint32_t);
 
-    uint64_t localEdgeID = globalEdgeID - edgeOffset;
+    uint64_t localEdgeID = globalEdgeID - windowEdgeBegin;
     return edgeDestBuffer[localEdgeID];
   }
 
@@ -471,12 +755,12 @@ public:
       return 0;
     }
 
-    assert(edgeOffset <= globalEdgeID);
-    assert(globalEdgeID < (edgeOffset + numLocalEdges));
+    assert(windowEdgeBegin <= globalEdgeID);
+    assert(globalEdgeID < windowEdgeEnd);
 
     numBytesReadEdgeData += sizeof(EdgeDataType);
 
-    uint64_t localEdgeID = globalEdgeID - edgeOffset;
+    uint64_t localEdgeID = globalEdgeID - windowEdgeBegin;
     return edgeDataBuffer[localEdgeID];
   }
 
@@ -402,6 +402,26 @@ public:
 
   GraphNode getEdgeDst(edge_iterator ni) { return edgeDst[*ni]; }
 
+  /**
+   * Returns a pointer to the destination of an edge. The destinations of the
+   * edges of a node are stored contiguously, so this gives array access to
+   * them (e.g., for the kernels in galois/SetIntersection.h).
+   */
+  const GraphNode* getEdgeDstPtr(edge_iterator ni) const {
+    return edgeDst.data() + *ni;
+  }
+
+  /**
+   * Prefetches the data of the destinations of the edges of N, for reading
+   * or, if RW is 1, for writing. Meant for the prefetch function of
+   * galois::interleave.
+   */
+  template <int RW = 0>
+  void prefetchNeighborData(GraphNode N) const {
+    for (auto ii = *raw_begin(N), ee = *raw_end(N); ii != ee; ++ii)
+      __builtin_prefetch(&nodeData[edgeDst[ii]], RW);
+  }
+
   size_t size() const { return numNodes; }
   size_t sizeEdges() const { return numEdges; }
 
@@ -22,6 +22,7 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <vector>
 
 #include <boost/utility.hpp>
 
@@ -88,6 +89,7 @@ class Lockable {
   Lockable* next;
   friend class LockManagerBase;
   friend class SimpleRuntimeContext;
+  friend class OptimisticRuntimeContext;
 
 public:
   Lockable() : next(0) {}
@@ -130,14 +132,20 @@ protected:
     assert(lockable != nullptr);
     return lockable->owner.getValue();
   }
+
+  inline static bool isLocked(Lockable* lockable) {
+    assert(lockable != nullptr);
+    return lockable->owner.is_locked();
+  }
 };
 
 class SimpleRuntimeContext : public LockManagerBase {
-  //! The locks we hold
-  Lockable* locks;
   bool customAcquire;
 
 protected:
+  //! The locks we hold
+  Lockable* locks;
+
   friend void doAcquire(Lockable*, galois::MethodFlag);
 
   static SimpleRuntimeContext* getOwner(Lockable* lockable) {
@@ -169,13 +177,109 @@ protected:
   void release(Lockable* lockable);
 
 public:
-  SimpleRuntimeContext(bool child = false) : locks(0), customAcquire(child) {}
+  SimpleRuntimeContext(bool child = false) : customAcquire(child), locks(0) {}
   virtual ~SimpleRuntimeContext() {}
 
   void startIteration() { assert(!locks); }
 
   unsigned cancelIteration();
   unsigned commitIteration();
+
+  /**
+   * Releases the locks of the neighborhood whose current owner satisfies
+   * pred and keeps the others. The owner of a lock is not necessarily the
+   * context that added it to its neighborhood, as locks may be stolen.
+   */
+  template <typename Pred>
+  unsigned releaseIf(Pred pred) {
+    unsigned numLocks = 0;
+    Lockable** prev   = &locks;
+    while (*prev) {
+      Lockable* lockable = *prev;
+      if (!pred(getOwner(lockable))) {
+        prev = &lockable->next;
+        continue;
+      }
+      // ORDER MATTERS!
+      *prev          = lockable->next;
+      lockable->next = 0;
+      substrate::compilerBarrier();
+      release(lockable);
+      ++numLocks;
+    }
+
+    return numLocks;
+  }
+};
+
+/**
+ * Conflict detection with optimistic reads. Lockables acquired for writing
+ * are locked as usual, while lockables acquired with MethodFlag::READ are
+ * not: the iteration only records their versions. At the cautious point of
+ * the operator, validate() locks the lockables it read and aborts the
+ * iteration if any of them has changed in the meantime; from then on, reads
+ * lock like writes. Reading a lockable that another iteration holds aborts
+ * right away.
+ *
+ * Versions are kept in a table indexed by a hash of the address of the
+ * lockable, so that Lockable stays the same size for loops that do not use
+ * optimistic reads. Committing an iteration increments the versions of the
+ * lockables it acquired for writing only. Lockables that share an entry of
+ * the table may abort each other's readers, which is safe but needless.
+ *
+ * Aborting does not undo writes, so the operator must not write before its
+ * cautious point, and an iteration that read optimistically must reach it
+ * before it commits. The operator must also tolerate reading data that
+ * another iteration is changing until then, since that iteration will be
+ * aborted.
+ */
+class OptimisticRuntimeContext : public SimpleRuntimeContext {
+  struct Read {
+    Lockable* lockable;
+    unsigned version;
+    bool locked; // locked by validate()
+  };
+
+  //! Reads recorded before validation, and reads locked after it
+  std::vector<Read> reads;
+  bool validated;
+  bool readConflict;
+
+  [[noreturn]] void signalReadConflict(Lockable* lockable) {
+    readConflict = true;
+    signalConflict(lockable);
+  }
+
+  //! Moves a lockable locked for reading to the written neighborhood
+  void promoteRead(Lockable* lockable);
+
+  void releaseReads();
+
+protected:
+  virtual void subAcquire(Lockable* lockable, galois::MethodFlag m);
+
+public:
+  OptimisticRuntimeContext()
+      : SimpleRuntimeContext(true), validated(false), readConflict(false) {}
+
+  void startIteration() {
+    SimpleRuntimeContext::startIteration();
+    assert(reads.empty());
+    validated    = false;
+    readConflict = false;
+  }
+
+  //! Aborts the iteration if a lockable it read has changed
+  void validate();
+
+  //! Whether the iteration read optimistically and was not validated yet
+  bool hasUnvalidatedReads() const { return !validated && !reads.empty(); }
+
+  unsigned cancelIteration();
+  unsigned commitIteration();
+
+  //! Whether the last abort was caused by a read rather than a write
+  bool abortedOnRead() const { return readConflict; }
 };
 
 //! get the current conflict detection class, may be null if not in parallel
@@ -0,0 +1,254 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_RUNTIME_EXECUTOR_COLORED_H
+#define GALOIS_RUNTIME_EXECUTOR_COLORED_H
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "galois/config.h"
+#include "galois/PerThreadContainer.h"
+#include "galois/runtime/Executor_DoAll.h"
+#include "galois/runtime/Executor_ForEach.h"
+#include "galois/runtime/Executor_OnEach.h"
+#include "galois/runtime/Range.h"
+#include "galois/runtime/Statistics.h"
+#include "galois/runtime/UserContextAccess.h"
+#include "galois/substrate/PerThreadStorage.h"
+#include "galois/Traits.h"
+
+namespace galois {
+namespace worklists {
+
+/**
+ * Runs a for_each by the color classes of a coloring of its items, such as
+ * a galois::GraphColoring of the graph whose nodes it iterates over. Items of
+ * the same color must not conflict, so no locks are taken. The coloring is
+ * the argument of the worklist:
+ *
+ * galois::for_each(galois::iterate(graph), fn,
+ *                  galois::wl<galois::worklists::Colored<>>(coloring));
+ *
+ * Loops have to ask for it: the contention manager of the speculative
+ * for_each does not move highly contended loops to it.
+ */
+template <typename T = int>
+class Colored {
+public:
+  template <bool _concurrent>
+  using rethread = Colored<T>;
+
+  template <typename _T>
+  using retype = Colored<_T>;
+
+  using value_type = T;
+};
+
+} // namespace worklists
+
+namespace runtime {
+
+/**
+ * Executes a for_each in rounds. A round buckets the items of the previous
+ * round (initially the range) by color and runs one color class after the
+ * other with do_all. Work pushed during a round is run in the next one, and
+ * so is an item that is already in the current round, since the two copies
+ * would conflict with each other.
+ *
+ * The coloring provides numColors(), color(item), and beginRound() and
+ * claim(item, round) to detect items scheduled twice in a round.
+ */
+template <typename T, typename FunctionTy, typename ArgsTy>
+class ColoredExecutor {
+  using value_type = T;
+  using ColoringTy = std::remove_reference_t<std::tuple_element_t<
+      0, decltype(get_trait_value<wl_tag>(std::declval<ArgsTy>()).args)>>;
+  using Items = galois::PerThreadVector<T>;
+
+  static constexpr bool needStats  = galois::internal::NeedStats<ArgsTy>::value;
+  static constexpr bool needsPush  = !has_trait<no_pushes_tag, ArgsTy>();
+  static constexpr bool needsPia   = has_trait<per_iter_alloc_tag, ArgsTy>();
+  static constexpr bool needsBreak = has_trait<parallel_break_tag, ArgsTy>();
+
+  struct ThreadLocalData {
+    UserContextAccess<value_type> facing;
+    size_t iterations = 0;
+    size_t pushes     = 0;
+    //! Number of items of each color this thread scheduled in this round
+    std::vector<size_t> counts;
+  };
+
+  FunctionTy func;
+  ColoringTy& coloring;
+  const char* loopname;
+  Items items[2];
+  Items* curr;
+  Items* next;
+  substrate::PerThreadStorage<ThreadLocalData> tlds;
+  std::vector<T> sorted;
+  std::vector<size_t> colorBegin;
+  bool broke;
+
+  //! Keeps the items of this thread that are new to the round and counts
+  //! them by color; the others go to the next round
+  void schedule(unsigned round, unsigned numColors) {
+    ThreadLocalData& tld = *tlds.getLocal();
+    auto& mine           = curr->get();
+    tld.counts.assign(numColors, 0);
+    size_t kept = 0;
+    for (size_t i = 0; i < mine.size(); ++i) {
+      if (coloring.claim(mine[i], round)) {
+        ++tld.counts[coloring.color(mine[i])];
+        mine[kept++] = mine[i];
+      } else {
+        next->get().push_back(mine[i]);
+      }
+    }
+    mine.resize(kept);
+  }
+
+  //! Turns counts into the positions where each thread writes its items of
+  //! each color: by color, then by thread
+  void computeOffsets(unsigned numColors, unsigned numThreads) {
+    colorBegin.assign(numColors + 1, 0);
+    size_t pos = 0;
+    for (unsigned c = 0; c < numColors; ++c) {
+      colorBegin[c] = pos;
+      for (unsigned t = 0; t < numThreads; ++t) {
+        size_t& count = tlds.getRemote(t)->counts[c];
+        size_t n      = count;
+        count         = pos;
+        pos += n;
+      }
+    }
+    colorBegin[numColors] = pos;
+    if (sorted.size() < pos)
+      sorted.resize(pos);
+  }
+
+  void scatter() {
+    ThreadLocalData& tld = *tlds.getLocal();
+    for (const T& item : curr->get())
+      sorted[tld.counts[coloring.color(item)]++] = item;
+  }
+
+  void runColor(unsigned c) {
+    galois::runtime::do_all_gen(
+        makeStandardRange(sorted.begin() + colorBegin[c],
+                          sorted.begin() + colorBegin[c + 1]),
+        [&, this](T& item) {
+          ThreadLocalData& tld = *tlds.getLocal();
+          ++tld.iterations;
+          func(item, tld.facing.data());
+          if (needsPush) {
+            auto& pb = tld.facing.getPushBuffer();
+            if (pb.size()) {
+              auto& nv = next->get();
+              nv.insert(nv.end(), pb.begin(), pb.end());
+              tld.pushes += pb.size();
+              pb.clear();
+            }
+          }
+          if (needsPia)
+            tld.facing.resetAlloc();
+        },
+        std::make_tuple(galois::steal()));
+  }
+
+public:
+  ColoredExecutor(const FunctionTy& f, const ArgsTy& args)
+      : func(f),
+        coloring(std::get<0>(get_trait_value<wl_tag>(args).args)),
+        loopname(galois::internal::getLoopName(args)), curr(&items[0]),
+        next(&items[1]), broke(false) {}
+
+  template <typename RangeTy>
+  void execute(const RangeTy& range) {
+    on_each_gen(
+        [&, this](unsigned, unsigned) {
+          if (needsBreak)
+            tlds.getLocal()->facing.setBreakFlag(&broke);
+          auto p = range.local_pair();
+          next->get().insert(next->get().end(), p.first, p.second);
+        },
+        std::make_tuple());
+
+    unsigned numThreads = galois::getActiveThreads();
+    unsigned numColors  = coloring.numColors();
+    size_t rounds       = 0;
+
+    while (!next->empty_all() && !(needsBreak && broke)) {
+      std::swap(curr, next);
+      unsigned round = coloring.beginRound();
+      on_each_gen([&, this](unsigned,
+                            unsigned) { schedule(round, numColors); },
+                  std::make_tuple());
+      computeOffsets(numColors, numThreads);
+      on_each_gen([&, this](unsigned, unsigned) { scatter(); },
+                  std::make_tuple());
+
+      for (unsigned c = 0; c < numColors && !(needsBreak && broke); ++c)
+        runColor(c);
+
+      curr->clear_all_parallel();
+      ++rounds;
+    }
+
+    if (needStats) {
+      size_t iterations = 0;
+      size_t pushes     = 0;
+      for (unsigned t = 0; t < numThreads; ++t) {
+        iterations += tlds.getRemote(t)->iterations;
+        pushes += tlds.getRemote(t)->pushes;
+      }
+      reportStat_Single(loopname, "Iterations", iterations);
+      reportStat_Single(loopname, "Pushes", pushes);
+      reportStat_Single(loopname, "Rounds", rounds);
+      reportStat_Single(loopname, "Colors", numColors);
+    }
+  }
+
+  // called serially once
+  template <typename RangeTy>
+  void init(const RangeTy& range) {
+    execute(range);
+  }
+
+  // called once on each thread followed by a barrier
+  template <typename RangeTy>
+  void initThread(const RangeTy&) const {}
+
+  void operator()(void) {}
+};
+
+// hookup into galois::for_each. Invoke galois::for_each with
+// wl<galois::worklists::Colored<>>(coloring)
+template <class T, class FunctionTy, class ArgsTy>
+struct ForEachExecutor<galois::worklists::Colored<T>, FunctionTy, ArgsTy>
+    : public ColoredExecutor<T, FunctionTy, ArgsTy> {
+  using SuperTy = ColoredExecutor<T, FunctionTy, ArgsTy>;
+  ForEachExecutor(const FunctionTy& f, const ArgsTy& args) : SuperTy(f, args) {}
+};
+
+} // namespace runtime
+} // namespace galois
+#endif
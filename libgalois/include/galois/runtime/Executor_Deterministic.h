@@ -30,6 +30,7 @@
 
 #include "galois/Bag.h"
 #include "galois/config.h"
+#include "galois/gdeque.h"
 #include "galois/gIO.h"
 #include "galois/gslist.h"
 #include "galois/ParallelSTL.h"
@@ -44,7 +45,6 @@
 #include "galois/substrate/ThreadPool.h"
 #include "galois/Threads.h"
 #include "galois/TwoLevelIteratorA.h"
-#include "galois/UnionFind.h"
 #include "galois/worklists/WorkList.h"
 
 // TODO deterministic hash
@@ -60,6 +60,7 @@ namespace runtime {
 namespace internal {
 
 extern thread_local SizedHeapFactory::SizedHeap* dagListHeap;
+extern thread_local SizedHeapFactory::SizedHeap* readListHeap;
 
 template <typename T, bool UseLocalState>
 class DItemBase {
@@ -124,10 +125,12 @@ public:
 
 private:
   bool notReady;
+  //! Round whose commit phase runs this iteration
+  size_t round;
 
 public:
-  DeterministicContextBase(const Item& _item)
-      : FirstPassBase(true), item(_item), notReady(false) {}
+  DeterministicContextBase(const Item& _item, size_t r = 0)
+      : FirstPassBase(true), item(_item), notReady(false), round(r) {}
 
   void clear() {}
 
@@ -144,6 +147,14 @@ public:
       if (other == this)
         return;
       if (other) {
+        if (other->round != round) {
+          // Pipelined rounds: the owner belongs to the previous round, which
+          // may be committing right now, so stop before reading anything
+          // under the lock. Locks of the previous round are released only
+          // after its commit phase, so they can't be stolen either.
+          notReady = true;
+          signalConflict(lockable);
+        }
         bool conflict = other->item.id < this->item.id;
         if (conflict) {
           // A lock that I want but can't get
@@ -163,93 +174,39 @@ public:
   static void initialize() {}
 };
 
-class HasIntentToReadContext : public FirstPassBase {
-public:
-  unsigned long id;
-  bool notReady;
-  bool isWriter;
-
-  HasIntentToReadContext(unsigned long id, bool w)
-      : FirstPassBase(true), id(id), notReady(false), isWriter(w) {}
-
-  bool isReady() { return !notReady; }
-};
-
-class ReaderContext : public galois::UnionFindNode<ReaderContext>,
-                      public HasIntentToReadContext {
-  template <typename, bool, bool>
-  friend class DeterministicContextBase;
-
-public:
-  ReaderContext(unsigned long id)
-      : galois::UnionFindNode<ReaderContext>(const_cast<ReaderContext*>(this)),
-        HasIntentToReadContext(id, false) {}
-
-  void build() {
-    if (this->isReady())
-      return;
-    ReaderContext* r = this->find();
-    if (r->isReady())
-      r->notReady = true;
-  }
-
-  bool propagate() { return this->find()->isReady(); }
-
-  virtual void alwaysAcquire(Lockable*, galois::MethodFlag) {
-    GALOIS_DIE("unreachable");
-  }
-};
-
+/**
+ * Context of an operator that declares which locks it only reads. Writes are
+ * acquired like in the general case: the iteration with the smallest id
+ * wins. Reads only record the lock; once every iteration of the round has
+ * been inspected, each read is checked against the final writer of the lock
+ * and the later of the two iterations is deferred. Readers of the same lock
+ * never wait for each other, and no lock word is written on a read.
+ */
 template <typename OptionsTy>
-class DeterministicContextBase<OptionsTy, false, true>
-    : public HasIntentToReadContext {
+class DeterministicContextBase<OptionsTy, false, true> : public FirstPassBase {
 public:
   typedef DItem<OptionsTy> Item;
+  typedef galois::gslist<Lockable*, 8> ReadList;
   Item item;
 
 private:
-  ReaderContext readerCtx;
-
-  void acquireRead(Lockable* lockable) {
-    HasIntentToReadContext* other;
-    do {
-      other = static_cast<HasIntentToReadContext*>(this->getOwner(lockable));
-      if (other == this || other == &readerCtx)
-        return;
-      if (other) {
-        bool conflict = other->id < this->id;
-        if (conflict) {
-          if (other->isWriter)
-            readerCtx.notReady = true;
-          else
-            readerCtx.merge(static_cast<ReaderContext*>(other));
-          return;
-        }
-      }
-    } while (!readerCtx.stealByCAS(lockable, other));
-
-    // Disable loser
-    if (other) {
-      if (other->isWriter) {
-        // Only need atomic write
-        other->notReady = true;
-      } else {
-        static_cast<ReaderContext*>(other)->merge(&readerCtx);
-      }
-    }
-  }
+  bool notReady;
+  ReadList reads;
 
   void acquireWrite(Lockable* lockable) {
-    HasIntentToReadContext* other;
+    if (this->tryLock(lockable))
+      this->addToNhood(lockable);
+
+    DeterministicContextBase* other;
     do {
-      other = static_cast<HasIntentToReadContext*>(this->getOwner(lockable));
-      if (other == this || other == &readerCtx)
+      other = static_cast<DeterministicContextBase*>(this->getOwner(lockable));
+      if (other == this)
         return;
       if (other) {
-        bool conflict = other->id < this->id;
+        bool conflict = other->item.id < this->item.id;
         if (conflict) {
           // A lock that I want but can't get
-          this->notReady = true;
+          notReady = true;
           return;
         }
       }
@@ -264,32 +221,43 @@ private:
 
 public:
   DeterministicContextBase(const Item& i)
-      : HasIntentToReadContext(i.id, true), item(i), readerCtx(i.id) {}
+      : FirstPassBase(true), item(i), notReady(false) {}
 
-  void clear() {}
+  void clear() { reads.clear(*readListHeap); }
 
-  void build() { readerCtx.build(); }
+  bool isReady() { return !notReady; }
 
-  void propagate() {
-    if (this->isReady() && !readerCtx.propagate())
-      this->notReady = true;
+  //! Checks the reads of this iteration against the writers of the round
+  void build() {
+    for (Lockable* lockable : reads) {
+      DeterministicContextBase* other =
+          static_cast<DeterministicContextBase*>(this->getOwner(lockable));
+      if (!other || other == this)
+        continue;
+      // Only need atomic writes
+      if (other->item.id < this->item.id)
+        notReady = true;
+      else
+        other->notReady = true;
+    }
   }
 
   virtual void alwaysAcquire(Lockable* lockable, galois::MethodFlag m) {
     assert(m == MethodFlag::READ || m == MethodFlag::WRITE);
 
-    if (this->tryLock(lockable))
-      this->addToNhood(lockable);
-
     if (m == MethodFlag::READ) {
-      acquireRead(lockable);
+      reads.push_front(*readListHeap, lockable);
     } else {
       assert(m == MethodFlag::WRITE);
       acquireWrite(lockable);
     }
   }
 
-  static void initialize() {}
+  static void initialize() {
+    if (!readListHeap)
+      readListHeap = SizedHeapFactory::getHeapForSize(
+          sizeof(typename ReadList::block_type));
+  }
 };
 
 template <typename OptionsTy>
@@ -473,14 +441,22 @@ struct OptionsCommon {
       has_trait<fixed_neighborhood_tag, ArgsTy>();
   constexpr static bool hasIntentToRead =
       has_trait<intent_to_read_tag, ArgsTy>();
+  //! Inspect the next round while the current one commits. The other kinds
+  //! of neighborhoods need every iteration of a round inspected before any
+  //! of them can commit.
+  constexpr static bool pipelineRounds = has_trait<det_pipeline_tag, ArgsTy>();
 
   static const int ChunkSize             = 32;
   static const unsigned InitialNumRounds = 100;
   static const size_t MinDelta           = ChunkSize * 40;
+  static const size_t MinInnerDelta      = ChunkSize * 4;
 
   static_assert(
       !hasFixedNeighborhood || (hasFixedNeighborhood && hasId),
       "Please provide id function when operator has fixed neighborhood");
+  static_assert(!pipelineRounds || (!hasFixedNeighborhood && !hasIntentToRead),
+                "Pipelined rounds need operators without a fixed neighborhood "
+                "or intent to read");
 
   function2_type fn2;
   args_type args;
@@ -777,10 +753,8 @@ class IntentToReadManagerBase<OptionsTy, true> {
   typedef DeterministicContext<OptionsTy> Context;
   typedef galois::gdeque<Context*> WL;
   substrate::PerThreadStorage<WL> pending;
-  substrate::Barrier& barrier;
 
 public:
-  IntentToReadManagerBase() : barrier(getBarrier(activeThreads)) {}
 
   void pushIntentToReadTask(Context* ctx) {
     pending.getLocal()->push_back(ctx);
@@ -791,9 +765,6 @@ public:
   bool buildIntentToRead() {
     for (Context* ctx : *pending.getLocal())
       ctx->build();
-    barrier.wait();
-    for (Context* ctx : *pending.getLocal())
-      ctx->propagate();
     pending.getLocal()->clear();
     return true;
   }
@@ -811,21 +782,33 @@ public:
     friend class WindowManagerBase;
     size_t window;
     size_t delta;
-    size_t committed;
-    size_t iterations;
+    size_t lowest;
+    // Counts of the current and of the previous round, so that a thread can
+    // start counting the next round while others still read the counts of
+    // the current one in calculateWindow
+    size_t committed[2];
+    size_t iterations[2];
+    unsigned cur;
 
   public:
+    ThreadLocalData()
+        : lowest(std::numeric_limits<size_t>::max()), committed(),
+          iterations(), cur(0) {}
+
     size_t nextWindow(bool first = false) {
       if (first)
         window = delta;
       else
         window += delta;
-      committed = iterations = 0;
+      cur ^= 1;
+      committed[cur] = iterations[cur] = 0;
       return window;
     }
 
-    void incrementIterations() { ++iterations; }
-    void incrementCommitted() { ++committed; }
+    void incrementIterations() { ++iterations[cur]; }
+    void incrementCommitted() { ++committed[cur]; }
+    //! Smallest id of the items of this thread that wait for the window
+    void setLowestWaiting(size_t id) { lowest = id; }
   };
 
 private:
@@ -855,37 +838,48 @@ public:
     return w;
   }
 
-  void calculateWindow(bool inner) {
+  /**
+   * Adapts the window to the commit ratio of the round that just finished.
+   * The next window starts at the smallest id that still waits, i.e., at the
+   * oldest iteration that failed, and spans delta ids, which doubles while
+   * almost everything commits and shrinks in proportion to the conflicts
+   * otherwise. A round of many conflicts thus retries fewer of its failed
+   * iterations at once instead of retrying all of them until they commit.
+   * Every thread computes the same window from the counts of all threads.
+   *
+   * @returns true if the round inspected iterations but committed none,
+   * which only happens when the inspection of a round overlapped the commit
+   * of the previous one
+   */
+  bool calculateWindow(bool inner) {
     ThreadLocalData& local = *data.getLocal();
 
     // Accumulate all threads' info
     size_t allcommitted  = 0;
     size_t alliterations = 0;
+    size_t lowest        = std::numeric_limits<size_t>::max();
     for (unsigned i = 0; i < numActive; ++i) {
       ThreadLocalData& r = *data.getRemote(i);
-      allcommitted += r.committed;
-      alliterations += r.iterations;
+      allcommitted += r.committed[local.cur];
+      alliterations += r.iterations[local.cur];
+      lowest = std::min(lowest, r.lowest);
     }
 
     float commitRatio =
         alliterations > 0 ? allcommitted / (float)alliterations : 0.0;
     const float target = 0.95;
 
-    if (commitRatio >= target)
-      local.delta += local.delta;
-    else if (allcommitted == 0) {
-      assert((alliterations == 0) && "someone should have committed");
+    if (alliterations == 0 ||
+        (commitRatio >= target && 2 * alliterations >= local.delta))
       local.delta += local.delta;
-    } else
+    else if (commitRatio < target)
       local.delta = commitRatio / target * local.delta;
 
-    if (!inner) {
-      if (local.delta < OptionsTy::MinDelta)
-        local.delta = OptionsTy::MinDelta;
-    } else if (local.delta < OptionsTy::MinDelta) {
-      // Try to get some new work instead of increasing window
-      local.delta = 0;
-    }
+    size_t minDelta = inner ? OptionsTy::MinInnerDelta : OptionsTy::MinDelta;
+    if (local.delta < minDelta)
+      local.delta = minDelta;
+    if (lowest != std::numeric_limits<size_t>::max())
+      local.window = lowest;
 
     // Useful debugging info
     if (false) {
@@ -897,6 +891,8 @@ public:
         gPrint(buf);
       }
     }
+
+    return alliterations > 0 && allcommitted == 0;
   }
 };
 
@@ -909,6 +905,7 @@ public:
 
     void incrementIterations() {}
     void incrementCommitted() {}
+    void setLowestWaiting(size_t) {}
   };
 
 private:
@@ -923,7 +920,7 @@ public:
     return std::numeric_limits<size_t>::max();
   }
 
-  void calculateWindow(bool) {}
+  bool calculateWindow(bool) { return false; }
 };
 
 template <typename OptionsTy>
@@ -963,6 +960,12 @@ class NewWorkManager : public IdManager<OptionsTy> {
       NewItemsTy;
   typedef typename NewItemsTy::iterator NewItemsIterator;
   typedef FIFO<1024, Item> ReserveTy;
+
+  struct LaterItem {
+    bool operator()(const Item& a, const Item& b) const { return a.id > b.id; }
+  };
+  //! Failed iterations waiting for the window to include them again
+  typedef std::priority_queue<Item, std::vector<Item>, LaterItem> DeferredTy;
   typedef worklists::PerSocketChunkFIFO<OptionsTy::ChunkSize, NewItem> NewWork;
 
   struct GetNewItem {
@@ -986,6 +989,7 @@ class NewWorkManager : public IdManager<OptionsTy> {
     PerIterAllocTy alloc;
     NewItemsTy newItems;
     ReserveTy reserve;
+    DeferredTy deferred;
     size_t minId;
     size_t maxId;
     size_t size;
@@ -1252,18 +1256,44 @@ public:
     numActive = getActiveThreads();
   }
 
-  bool emptyReserve() { return data.getLocal()->reserve.empty(); }
+  bool emptyReserve() {
+    ThreadLocalData& local = *data.getLocal();
+    return local.reserve.empty() && local.deferred.empty();
+  }
+
+  void deferItem(const Item& item) { data.getLocal()->deferred.push(item); }
+
+  //! Smallest id of the items of this thread that wait for the window
+  size_t lowestWaitingId() {
+    ThreadLocalData& local = *data.getLocal();
+    size_t id              = std::numeric_limits<size_t>::max();
+    if (!local.deferred.empty())
+      id = local.deferred.top().id;
+    galois::optional<Item> p = local.reserve.peek();
+    if (p)
+      id = std::min<size_t>(id, p->id);
+    return id;
+  }
 
+  //! Returns true if some waiting item entered the window
   template <typename WL>
-  void pushNextWindow(WL* wl, size_t window) {
+  bool pushNextWindow(WL* wl, size_t window) {
     ThreadLocalData& local = *data.getLocal();
     galois::optional<Item> p;
+    bool pushed = false;
+    while (!local.deferred.empty() && local.deferred.top().id < window) {
+      wl->push(local.deferred.top());
+      local.deferred.pop();
+      pushed = true;
+    }
     while ((p = local.reserve.peek())) {
       if (p->id >= window)
         break;
       wl->push(*p);
       local.reserve.pop();
+      pushed = true;
     }
+    return pushed;
   }
 
   void clearNewWork() { data.getLocal()->heap.clear(); }
@@ -1324,12 +1354,16 @@ class Executor : public BreakManager<OptionsTy>,
   typedef typename OptionsTy::value_type value_type;
   typedef DItem<OptionsTy> Item;
   typedef DeterministicContext<OptionsTy> Context;
+  typedef UserContextAccess<value_type> Facing;
 
   typedef worklists::PerSocketChunkFIFO<OptionsTy::ChunkSize, Item> WL;
   typedef worklists::PerSocketChunkFIFO<OptionsTy::ChunkSize, Context>
       PendingWork;
   typedef worklists::ChunkFIFO<OptionsTy::ChunkSize, Context, false>
       LocalPendingWork;
+  //! Contexts of one pipelined round. They keep their locks until the next
+  //! round has been inspected, so they are kept until then.
+  typedef galois::gdeque<Context> RoundContexts;
 
   // Truly thread-local
   using LoopStat = LoopStatistics<OptionsTy::needStats>;
@@ -1338,7 +1372,11 @@ class Executor : public BreakManager<OptionsTy>,
     typename OptionsTy::function1_type fn1;
     typename OptionsTy::function2_type fn2;
     LocalPendingWork localPending;
-    UserContextAccess<value_type> facing;
+    Facing facing;
+    //! Used instead of facing by odd rounds when rounds are pipelined, so that
+    //! per-iteration allocations of one round survive the next inspection
+    Facing oddFacing;
+    RoundContexts contexts[2];
 
     WL* wlcur;
     WL* wlnext;
@@ -1355,15 +1393,27 @@ class Executor : public BreakManager<OptionsTy>,
   WL worklists[2];
   PendingWork pending;
   const char* loopname;
-  substrate::CacheLineStorage<volatile long> innerDone;
+  // Indexed by the parity of the round, so that threads can start the next
+  // round while others still read the flag of the current one
+  substrate::CacheLineStorage<volatile long> innerDone[2];
   substrate::CacheLineStorage<volatile long> outerDone;
   substrate::CacheLineStorage<volatile long> hasNewWork;
 
-  int runFunction(ThreadLocalData& tld, Context* ctx);
+  int runFunction(ThreadLocalData& tld, Facing& facing, Context* ctx);
 
+  bool inspect(ThreadLocalData& tld, Facing& facing, Context* ctx);
   bool pendingLoop(ThreadLocalData& tld);
   bool commitLoop(ThreadLocalData& tld);
-  void go();
+  void go(std::false_type);
+
+  bool inspectRound(ThreadLocalData& tld, size_t round);
+  bool commitRound(ThreadLocalData& tld, size_t round);
+  void releaseRound(ThreadLocalData& tld, size_t round);
+  void go(std::true_type);
+
+  Facing& getFacing(ThreadLocalData& tld, size_t round) {
+    return (round & 1) ? tld.oddFacing : tld.facing;
+  }
 
   void drainPending(ThreadLocalData& tld) {
     Context* ctx;
@@ -1382,7 +1432,11 @@ public:
                   "need to use break function to break loop");
   }
 
-  bool executeTask(ThreadLocalData& tld, Context* ctx);
+  bool executeTask(ThreadLocalData& tld, Context* ctx) {
+    return executeTask(tld, tld.facing, ctx);
+  }
+
+  bool executeTask(ThreadLocalData& tld, Facing& facing, Context* ctx);
 
   template <typename RangeTy>
   void initThread(const RangeTy& range) {
@@ -1395,11 +1449,13 @@ public:
     this->sortInitialWork(range.begin(), range.end());
   }
 
-  void operator()() { go(); }
+  void operator()() {
+    go(std::integral_constant<bool, OptionsTy::pipelineRounds>());
+  }
 };
 
 template <typename OptionsTy>
-void Executor<OptionsTy>::go() {
+void Executor<OptionsTy>::go(std::false_type) {
   ThreadLocalData tld(options, loopname);
   auto& local = this->getLocalWindowManager();
   tld.wlcur   = &worklists[0];
@@ -1413,9 +1469,11 @@ void Executor<OptionsTy>::go() {
     while (true) {
       ++tld.rounds;
 
+      auto& done = innerDone[tld.rounds & 1].get();
+
       std::swap(tld.wlcur, tld.wlnext);
       bool nextPending = pendingLoop(tld);
-      innerDone.get()  = true;
+      done             = true;
 
       barrier.wait();
 
@@ -1436,19 +1494,18 @@ void Executor<OptionsTy>::go() {
       }
 
       nextCommit = commitLoop(tld);
+      local.setLowestWaiting(this->lowestWaitingId());
 
       if (nextPending || nextCommit)
-        innerDone.get() = false;
+        done = false;
 
       barrier.wait();
 
-      if (innerDone.get())
+      if (done)
         break;
 
       this->calculateWindow(true);
 
-      barrier.wait();
-
       this->pushNextWindow(tld.wlnext, local.nextWindow());
     }
 
@@ -1491,15 +1548,126 @@ void Executor<OptionsTy>::go() {
   }
 }
 
+/**
+ * Pipelined rounds, used with galois::det_pipeline: every thread commits its
+ * iterations of round k and then inspects items of round k+1 while other
+ * threads may still be committing. An inspection that reaches a lock of
+ * round k gives up right away (see DeterministicContextBase::alwaysAcquire),
+ * and round k releases its locks only after a barrier, so the two never
+ * touch the same data. This saves the barrier between inspection and commit
+ * of each round.
+ *
+ * Items of round k+1 that run into round k are deferred, so in the worst
+ * case a round commits nothing; the round after such a round is then
+ * inspected only after the previous one committed, which guarantees
+ * progress. All of these decisions only depend on the items of each round,
+ * hence the schedule stays deterministic.
+ */
+template <typename OptionsTy>
+void Executor<OptionsTy>::go(std::true_type) {
+  ThreadLocalData tld(options, loopname);
+  auto& local = this->getLocalWindowManager();
+  tld.wlcur   = &worklists[0];
+  tld.wlnext  = &worklists[1];
+
+  tld.hasNewWork = false;
+
+  while (true) {
+    ++tld.outerRounds;
+
+    // Inspect the first round on its own and gather the items of the second
+    // one, which is inspected while the first one commits
+    std::swap(tld.wlcur, tld.wlnext);
+    inspectRound(tld, tld.rounds + 1);
+    bool pushed = this->pushNextWindow(tld.wlnext, local.nextWindow());
+    bool serial = false;
+
+    barrier.wait();
+
+    while (true) {
+      size_t round = ++tld.rounds;
+      auto& done   = innerDone[round & 1].get();
+      done         = true;
+
+      std::swap(tld.wlcur, tld.wlnext);
+      // With a serial round, the items pushed last round are not inspected
+      // until after this round releases its locks
+      bool more = serial && pushed;
+      more |= commitRound(tld, round);
+      if (!serial)
+        more |= inspectRound(tld, round + 1);
+      local.setLowestWaiting(this->lowestWaitingId());
+
+      barrier.wait();
+
+      releaseRound(tld, round);
+      outerDone.get() = true;
+      bool stalled    = this->calculateWindow(true);
+      pushed          = this->pushNextWindow(tld.wlnext, local.nextWindow());
+
+      if (more || pushed)
+        done = false;
+
+      barrier.wait();
+
+      if (done)
+        break;
+
+      if (serial) {
+        inspectRound(tld, round + 1);
+        barrier.wait();
+      }
+      serial = stalled;
+    }
+
+    if (!this->emptyReserve())
+      outerDone.get() = false;
+
+    if (tld.hasNewWork)
+      hasNewWork.get() = true;
+
+    if (this->checkBreak())
+      break;
+
+    barrier.wait();
+
+    if (outerDone.get()) {
+      if (!OptionsTy::needsPush)
+        break;
+      if (!hasNewWork.get()) // (1)
+        break;
+      this->distributeNewWork(*this, tld.wlnext);
+      tld.hasNewWork = false;
+      // NB: assumes that distributeNewWork has a barrier otherwise checking at
+      // (1) is erroneous
+      hasNewWork.get() = false;
+    } else {
+      this->calculateWindow(false);
+
+      this->pushNextWindow(tld.wlnext, local.nextWindow());
+    }
+  }
+
+  this->clearNewWork();
+
+  if (OptionsTy::needStats) {
+    if (substrate::ThreadPool::getTID() == 0) {
+      reportStat_Single(loopname, "RoundsExecuted", tld.rounds);
+      reportStat_Single(loopname, "OuterRoundsExecuted", tld.outerRounds);
+    }
+  }
+}
+
 template <typename OptionsTy>
-int Executor<OptionsTy>::runFunction(ThreadLocalData& tld, Context* ctx) {
+int Executor<OptionsTy>::runFunction(ThreadLocalData& tld, Facing& facing,
+                                     Context* ctx) {
   int result = 0;
 #ifdef GALOIS_USE_LONGJMP_ABORT
   if ((result = setjmp(execFrame)) == 0) {
 #elif defined(GALOIS_USE_EXCEPTION_ABORT)
   try {
 #endif
-    tld.fn1(ctx->item.val, tld.facing.data());
+    tld.fn1(ctx->item.val, facing.data());
 #ifdef GALOIS_USE_LONGJMP_ABORT
   } else {
     clearConflictLock();
@@ -1513,6 +1681,45 @@ int Executor<OptionsTy>::runFunction(ThreadLocalData& tld, Context* ctx) {
   return result;
 }
 
+//! Runs the first pass of an iteration; returns false if it aborted
+template <typename OptionsTy>
+bool Executor<OptionsTy>::inspect(ThreadLocalData& tld, Facing& facing,
+                                  Context* ctx) {
+  bool commit = true;
+
+  ctx->startIteration();
+  ctx->setFirstPass();
+  tld.inc_iterations();
+  facing.setFirstPass();
+  setThreadContext(ctx);
+
+  this->allocLocalState(facing, tld.fn2);
+  int result = runFunction(tld, facing, ctx);
+  // FIXME:    clearReleasable();
+  facing.resetFirstPass();
+  ctx->resetFirstPass();
+  switch (result) {
+  case 0:
+  case REACHED_FAILSAFE:
+    break;
+  case CONFLICT:
+    commit = false;
+    break;
+  default:
+    abort();
+    break;
+  }
+
+  // TODO only needed if fn1 needs pia
+  if (OptionsTy::needsPia && !OptionsTy::useLocalState)
+    facing.resetAlloc();
+
+  if (commit || OptionsTy::hasFixedNeighborhood)
+    this->saveLocalState(facing, ctx->item);
+
+  return commit;
+}
+
 template <typename OptionsTy>
 bool Executor<OptionsTy>::pendingLoop(ThreadLocalData& tld) {
   auto& local = this->getLocalWindowManager();
@@ -1523,51 +1730,22 @@ bool Executor<OptionsTy>::pendingLoop(ThreadLocalData& tld) {
     // between aborted iterations.
     Context* ctx = this->emplaceContext(tld.localPending, pending, *p);
     this->pushDAGTask(ctx);
+    this->pushIntentToReadTask(ctx);
     local.incrementIterations();
-    bool commit = true;
-
-    ctx->startIteration();
-    ctx->setFirstPass();
-    tld.inc_iterations();
-    tld.facing.setFirstPass();
-    setThreadContext(ctx);
-
-    this->allocLocalState(tld.facing, tld.fn2);
-    int result = runFunction(tld, ctx);
-    // FIXME:    clearReleasable();
-    tld.facing.resetFirstPass();
-    ctx->resetFirstPass();
-    switch (result) {
-    case 0:
-    case REACHED_FAILSAFE:
-      break;
-    case CONFLICT:
-      commit = false;
-      break;
-    default:
-      abort();
-      break;
-    }
-
-    // TODO only needed if fn1 needs pia
-    if (OptionsTy::needsPia && !OptionsTy::useLocalState)
-      tld.facing.resetAlloc();
 
-    if (commit || OptionsTy::hasFixedNeighborhood) {
-      this->saveLocalState(tld.facing, ctx->item);
-    } else {
+    if (!inspect(tld, tld.facing, ctx))
       retval = true;
-    }
   }
 
   return retval;
 }
 
 template <typename OptionsTy>
-bool Executor<OptionsTy>::executeTask(ThreadLocalData& tld, Context* ctx) {
+bool Executor<OptionsTy>::executeTask(ThreadLocalData& tld, Facing& facing,
+                                      Context* ctx) {
   setThreadContext(ctx);
-  this->restoreLocalState(tld.facing, ctx->item);
-  tld.facing.resetFirstPass();
+  this->restoreLocalState(facing, ctx->item);
+  facing.resetFirstPass();
   ctx->resetFirstPass();
   int result = 0;
 #ifdef GALOIS_USE_LONGJMP_ABORT
@@ -1575,7 +1753,7 @@ bool Executor<OptionsTy>::executeTask(ThreadLocalData& tld, Context* ctx) {
 #elif defined(GALOIS_USE_EXCEPTION_ABORT)
   try {
 #endif
-    tld.fn2(ctx->item.val, tld.facing.data());
+    tld.fn2(ctx->item.val, facing.data());
 #ifdef GALOIS_USE_LONGJMP_ABORT
   } else {
     clearConflictLock();
@@ -1603,7 +1781,7 @@ bool Executor<OptionsTy>::executeTask(ThreadLocalData& tld, Context* ctx) {
     //    typedef typename UserContextAccess<value_type>::PushBufferTy::iterator
     //    iterator;
     unsigned count = 0;
-    for (auto& item : tld.facing.getPushBuffer()) {
+    for (auto& item : facing.getPushBuffer()) {
       this->pushNew(item, parent, ++count);
       if (count == 0) {
         GALOIS_DIE("counter overflow");
@@ -1612,8 +1790,8 @@ bool Executor<OptionsTy>::executeTask(ThreadLocalData& tld, Context* ctx) {
     if (count)
       tld.hasNewWork = true;
   }
-  assert(OptionsTy::needsPush || tld.facing.getPushBuffer().begin() ==
-                                     tld.facing.getPushBuffer().end());
+  assert(OptionsTy::needsPush ||
+         facing.getPushBuffer().begin() == facing.getPushBuffer().end());
 
   return true;
 }
@@ -1634,7 +1812,7 @@ bool Executor<OptionsTy>::commitLoop(ThreadLocalData& tld) {
       local.incrementCommitted();
     } else {
       this->reuseItem(ctx->item);
-      tld.wlnext->push(ctx->item);
+      this->deferItem(ctx->item);
       tld.inc_conflicts();
       retval = true;
       ctx->cancelIteration();
@@ -1658,6 +1836,86 @@ bool Executor<OptionsTy>::commitLoop(ThreadLocalData& tld) {
   return retval;
 }
 
+//! Inspects the items of wlcur as iterations of the given round; returns
+//! true if there were any
+template <typename OptionsTy>
+bool Executor<OptionsTy>::inspectRound(ThreadLocalData& tld, size_t round) {
+  RoundContexts& contexts = tld.contexts[round & 1];
+  Facing& facing          = getFacing(tld, round);
+  bool retval             = false;
+  galois::optional<Item> p;
+  while ((p = tld.wlcur->pop())) {
+    contexts.emplace_back(*p, round);
+    inspect(tld, facing, &contexts.back());
+    retval = true;
+  }
+
+  setThreadContext(0);
+
+  return retval;
+}
+
+//! Commits the iterations of a round that this thread inspected, but keeps
+//! their locks; returns true if some iteration has to be retried
+template <typename OptionsTy>
+bool Executor<OptionsTy>::commitRound(ThreadLocalData& tld, size_t round) {
+  auto& local    = this->getLocalWindowManager();
+  Facing& facing = getFacing(tld, round);
+  bool retval    = false;
+
+  for (Context& ctx : tld.contexts[round & 1]) {
+    bool commit = false;
+    local.incrementIterations();
+    if (ctx.isReady())
+      commit = executeTask(tld, facing, &ctx);
+
+    if (commit) {
+      local.incrementCommitted();
+    } else {
+      this->reuseItem(ctx.item);
+      this->deferItem(ctx.item);
+      tld.inc_conflicts();
+      retval = true;
+    }
+
+    this->deallocLocalState(facing);
+
+    if (OptionsTy::needsPia && !OptionsTy::useLocalState)
+      facing.resetAlloc();
+
+    facing.resetPushBuffer();
+  }
+
+  setThreadContext(0);
+
+  return retval;
+}
+
+//! Releases the locks of a round. Iterations of the next round that already
+//! know that they won't commit release their locks as well, so that they
+//! don't hold back the inspection of the round after. Which neighborhood
+//! list a lock ended up in depends on timing, but its final owner doesn't,
+//! so the locks are released by owner.
+template <typename OptionsTy>
+void Executor<OptionsTy>::releaseRound(ThreadLocalData& tld, size_t round) {
+  RoundContexts& contexts = tld.contexts[round & 1];
+  for (Context& ctx : contexts) {
+    ctx.commitIteration();
+    ctx.clear();
+  }
+  contexts.clear();
+
+  auto notReady = [](SimpleRuntimeContext* owner) {
+    return !static_cast<Context*>(owner)->isReady();
+  };
+  for (Context& ctx : tld.contexts[(round + 1) & 1])
+    if (!ctx.isReady())
+      ctx.releaseIf(notReady);
+
+  if (OptionsTy::needsPia && OptionsTy::useLocalState)
+    getFacing(tld, round).resetAlloc();
+}
+
 } // namespace internal
 } // namespace runtime
 
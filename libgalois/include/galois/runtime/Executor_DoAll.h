@@ -22,7 +22,9 @@
 
 #include "galois/config.h"
 #include "galois/gIO.h"
+#include "galois/runtime/Executor_Nested.h"
 #include "galois/runtime/Executor_OnEach.h"
+#include "galois/runtime/Interleave.h"
 #include "galois/runtime/OperatorReferenceTypes.h"
 #include "galois/runtime/Statistics.h"
 #include "galois/substrate/Barrier.h"
@@ -51,6 +53,8 @@ class DoAllStealingExec {
       NEED_STATS && has_trait<more_stats_tag, ArgsTuple>();
   constexpr static const bool USE_TERM = false;
 
+  using Prefetcher = decltype(getPrefetcher(std::declval<ArgsTuple>()));
+
   struct ThreadContext {
 
     alignas(substrate::GALOIS_CACHE_LINE_SIZE) substrate::SimpleLock work_mutex;
@@ -74,7 +78,8 @@ class DoAllStealingExec {
         : work_mutex(), id(id), shared_beg(beg), shared_end(end),
           m_size(std::distance(beg, end)), num_iter(0) {}
 
-    bool doWork(F func, const unsigned chunk_size) {
+    bool doWork(F func, const Prefetcher& prefetcher,
+                const unsigned chunk_size) {
       Iter beg(shared_beg);
       Iter end(shared_end);
 
@@ -84,12 +89,12 @@ class DoAllStealingExec {
 
         didwork = true;
 
-        for (; beg != end; ++beg) {
+        runInterleaved(prefetcher, beg, end, [&](auto&& item) {
           if (NEED_STATS) {
             ++num_iter;
           }
-          func(*beg);
-        }
+          func(item);
+        });
       }
 
       return didwork;
@@ -353,6 +358,7 @@ private:
 private:
   R range;
   F func;
+  Prefetcher prefetcher;
   const char* loopname;
   Diff_ty chunk_size;
   substrate::PerThreadStorage<ThreadContext> workers;
@@ -368,7 +374,7 @@ private:
 
 public:
   DoAllStealingExec(const R& _range, F _func, const ArgsTuple& argsTuple)
-      : range(_range), func(_func),
+      : range(_range), func(_func), prefetcher(getPrefetcher(argsTuple)),
         loopname(galois::internal::getLoopName(argsTuple)),
         chunk_size(get_trait_value<chunk_size_tag>(argsTuple).value),
         term(substrate::getSystemTermination(activeThreads)),
@@ -414,7 +420,7 @@ public:
 
       execTime.start();
 
-      if (ctx.doWork(func, chunk_size)) {
+      if (ctx.doWork(func, prefetcher, chunk_size)) {
         workHappened = true;
       }
 
@@ -468,10 +474,11 @@ struct ChooseDoAllImpl {
         exec(range, std::forward<F>(func), argsTuple);
 
     substrate::Barrier& barrier = getBarrier(activeThreads);
+    std::atomic<unsigned> busy(activeThreads);
 
     substrate::getThreadPool().run(
         activeThreads, [&exec](void) { exec.initThread(); }, std::ref(barrier),
-        std::ref(exec));
+        std::ref(exec), [&busy](void) { finishAndHelpNested(busy); });
   }
 };
 
@@ -506,12 +513,13 @@ struct ChooseDoAllImpl<false> {
 
           size_t iter = 0;
 
-          while (begin != end) {
-            func(*begin++);
-            if (NEED_STATS) {
-              ++iter;
-            }
-          }
+          runInterleaved(getPrefetcher(argsTuple), begin, end,
+                         [&](auto&& item) {
+                           func(item);
+                           if (NEED_STATS) {
+                             ++iter;
+                           }
+                         });
           execTime.stop();
 
           totalTime.stop();
@@ -540,6 +548,15 @@ void do_all_gen(const R& range, F&& func, const ArgsTuple& argsTuple) {
 
   using ArgsT = decltype(argsT);
 
+  OperatorReferenceType<decltype(std::forward<F>(func))> func_ref = func;
+
+  // called from the operator of another loop: split the range among the
+  // threads of that loop that run out of work
+  if (substrate::getThreadPool().isRunning()) {
+    internal::nested_do_all(range, func_ref, argsT);
+    return;
+  }
+
   constexpr bool TIME_IT = has_trait<loopname_tag, ArgsT>();
   CondStatTimer<TIME_IT> timer(galois::internal::getLoopName(argsT));
 
@@ -547,7 +564,6 @@ void do_all_gen(const R& range, F&& func, const ArgsTuple& argsTuple) {
 
   constexpr bool STEAL = has_trait<steal_tag, ArgsT>();
 
-  OperatorReferenceType<decltype(std::forward<F>(func))> func_ref = func;
   internal::ChooseDoAllImpl<STEAL>::call(range, func_ref, argsT);
 
   timer.stop();
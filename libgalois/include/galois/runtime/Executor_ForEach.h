@@ -21,14 +21,18 @@
 #define GALOIS_RUNTIME_EXECUTOR_FOREACH_H
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 #include "galois/config.h"
 #include "galois/gIO.h"
 #include "galois/Mem.h"
 #include "galois/runtime/Context.h"
+#include "galois/runtime/Executor_Nested.h"
+#include "galois/runtime/Interleave.h"
 #include "galois/runtime/LoopStatistics.h"
 #include "galois/runtime/OperatorReferenceTypes.h"
 #include "galois/runtime/Range.h"
@@ -57,6 +61,9 @@ class AbortHandler {
 
   typedef worklists::GFIFO<Item> AbortedList;
   substrate::PerThreadStorage<AbortedList> queues;
+  //! Serial tail of work deferred by a ContentionManager
+  AbortedList deferred;
+  std::atomic<bool> hasDeferred;
   bool useBasicPolicy;
 
   /**
@@ -120,7 +127,7 @@ class AbortHandler {
   void eagerPolicy(const Item& item) { queues.getLocal()->push(item); }
 
 public:
-  AbortHandler() {
+  AbortHandler() : hasDeferred(false) {
     // XXX(ddn): Implement smarter adaptive policy
     useBasicPolicy = substrate::getThreadPool().getMaxSockets() > 2;
   }
@@ -142,6 +149,120 @@ public:
   }
 
   AbortedList* getQueue() { return queues.getLocal(); }
+
+  //! Sets aside work to run serially once the parallel phase runs dry
+  void defer(const value_type& val) {
+    Item item = {val, 1};
+    deferred.push(item);
+    hasDeferred = true;
+  }
+
+  void defer(const Item& item) {
+    Item newitem = {item.val, item.retries + 1};
+    deferred.push(newitem);
+    hasDeferred = true;
+  }
+
+  bool anyDeferred() const { return hasDeferred; }
+
+  //! Only safe to call when no other thread defers work
+  AbortedList* takeDeferred() {
+    hasDeferred = false;
+    return &deferred;
+  }
+};
+
+/**
+ * Per-thread contention manager of loops with galois::contention_manager. It
+ * measures the ratio of aborted iterations over windows of a fixed number of
+ * iterations and raises the contention level after a window with many
+ * aborts and lowers it after one with few:
+ *
+ * - NONE: retry aborted work following the AbortHandler policy
+ * - BACKOFF: also back off exponentially after each abort, so that fewer
+ *   threads contend for the same data at any time
+ * - DEFER: defer aborted work to a serial tail, which runs on one thread when
+ *   the parallel phase runs out of work
+ *
+ * A loop over graph nodes that keeps reaching DEFER is better off with
+ * worklists::Colored, which runs color classes without conflicts. The
+ * manager cannot switch to it on its own since it needs a coloring.
+ */
+template <bool ReportStats>
+class ContentionManager {
+public:
+  enum Level { NONE, BACKOFF, DEFER };
+
+private:
+  static constexpr unsigned WINDOW      = 256;
+  static constexpr unsigned MAX_BACKOFF = 1024;
+
+  unsigned m_attempts;
+  unsigned m_aborts;
+  unsigned m_backoff;
+  Level m_level;
+  size_t m_escalations;
+  size_t m_backoffs;
+  size_t m_deferred;
+  const char* loopname;
+  bool report;
+
+  void endWindow() {
+    // Escalate from one abort in four iterations, relax below one in 16
+    if (4 * m_aborts >= m_attempts && m_level != DEFER) {
+      m_level = Level(m_level + 1);
+      ++m_escalations;
+    } else if (16 * m_aborts < m_attempts && m_level != NONE) {
+      m_level = Level(m_level - 1);
+    }
+    m_attempts = 0;
+    m_aborts   = 0;
+  }
+
+  void count() {
+    if (++m_attempts == WINDOW)
+      endWindow();
+  }
+
+public:
+  ContentionManager(const char* ln, bool r)
+      : m_attempts(0), m_aborts(0), m_backoff(1), m_level(NONE),
+        m_escalations(0), m_backoffs(0), m_deferred(0), loopname(ln),
+        report(r) {}
+
+  ~ContentionManager() {
+    if (!ReportStats || !report)
+      return;
+    reportStat_Tsum(loopname, "ContentionEscalations", m_escalations);
+    reportStat_Tsum(loopname, "AbortBackoffs", m_backoffs);
+    reportStat_Tsum(loopname, "DeferredToSerial", m_deferred);
+  }
+
+  Level level() const { return m_level; }
+
+  inline void commit() {
+    m_backoff = 1;
+    count();
+  }
+
+  //! Returns whether the aborted work should be deferred
+  bool abort() {
+    ++m_aborts;
+    count();
+    switch (m_level) {
+    case NONE:
+      return false;
+    case BACKOFF:
+      ++m_backoffs;
+      for (unsigned i = 0; i < m_backoff; ++i)
+        substrate::asmPause();
+      m_backoff = std::min(2 * m_backoff, MAX_BACKOFF);
+      return false;
+    default:
+      ++m_deferred;
+      return true;
+    }
+  }
 };
 
 // TODO(ddn): Implement wrapper to allow calling without UserContext
@@ -157,14 +278,21 @@ public:
   static constexpr bool needsBreak = has_trait<parallel_break_tag, ArgsTy>();
   static constexpr bool MORE_STATS =
       needStats && has_trait<more_stats_tag, ArgsTy>();
+  static constexpr bool optimisticReads =
+      needsAborts && has_trait<optimistic_reads_tag, ArgsTy>();
+  static constexpr bool manageContention =
+      needsAborts && has_trait<contention_manager_tag, ArgsTy>();
 
 protected:
   typedef typename WorkListTy::value_type value_type;
+  typedef typename std::conditional<optimisticReads, OptimisticRuntimeContext,
+                                    SimpleRuntimeContext>::type Context;
+  using Prefetcher = decltype(internal::getPrefetcher(std::declval<ArgsTy>()));
 
   struct ThreadLocalBasics {
     UserContextAccess<value_type> facing;
     FunctionTy function;
-    SimpleRuntimeContext ctx;
+    Context ctx;
 
     explicit ThreadLocalBasics(FunctionTy fn) : facing(), function(fn), ctx() {}
   };
@@ -172,9 +300,11 @@ protected:
   using LoopStat = LoopStatistics<needStats>;
 
   struct ThreadLocalData : public ThreadLocalBasics, public LoopStat {
+    ContentionManager<needStats> contention;
 
     ThreadLocalData(FunctionTy fn, const char* ln)
-        : ThreadLocalBasics(fn), LoopStat(ln) {}
+        : ThreadLocalBasics(fn), LoopStat(ln, optimisticReads),
+          contention(ln, manageContention) {}
   };
 
   // RunQueueState factors out state within runQueue iterations to protect it
@@ -194,6 +324,7 @@ protected:
 
   WorkListTy wl;
   FunctionTy origFunction;
+  Prefetcher prefetcher;
   const char* loopname;
   bool broke;
 
@@ -201,6 +332,13 @@ protected:
   PerThreadTimer<MORE_STATS> execTime;
 
   inline void commitIteration(ThreadLocalData& tld) {
+    // Validating now would be too late, since aborting does not undo the
+    // writes of the operator
+    if constexpr (optimisticReads) {
+      if (tld.ctx.hasUnvalidatedReads())
+        GALOIS_DIE("operators with optimistic_reads must call "
+                   "cautiousPoint() before they write");
+    }
     if (needsPush) {
       // auto ii = tld.facing.getPushBuffer().begin();
       // auto ee = tld.facing.getPushBuffer().end();
@@ -214,8 +352,11 @@ protected:
     }
     if (needsPia)
       tld.facing.resetAlloc();
-    if (needsAborts)
+    if (needsAborts) {
       tld.ctx.commitIteration();
+      if (manageContention)
+        tld.contention.commit();
+    }
     //++tld.stat_commits;
   }
 
@@ -224,8 +365,18 @@ protected:
                                                 ThreadLocalData& tld) {
     assert(needsAborts);
     tld.ctx.cancelIteration();
-    tld.inc_conflicts();
-    aborted.push(item);
+    if constexpr (optimisticReads) {
+      if (tld.ctx.abortedOnRead())
+        tld.inc_read_conflicts();
+      else
+        tld.inc_conflicts();
+    } else {
+      tld.inc_conflicts();
+    }
+    if (manageContention && tld.contention.abort())
+      aborted.defer(item);
+    else
+      aborted.push(item);
     // clear push buffer
     if (needsPush)
       tld.facing.resetPushBuffer();
@@ -244,13 +395,9 @@ protected:
   }
 
   bool runQueueSimple(ThreadLocalData& tld) {
-    galois::optional<value_type> p;
-    bool didWork = false;
-    while ((p = wl.pop())) {
-      didWork = true;
-      doProcess(*p, tld);
-    }
-    return didWork;
+    return internal::runInterleavedPops<Prefetcher, value_type>(
+        prefetcher, [&]() { return wl.pop(); },
+        [&](value_type& item) { doProcess(item, tld); });
   }
 
   template <unsigned int limit, typename WL>
@@ -290,6 +437,11 @@ protected:
     return runQueue<0>(tld, *aborted.getQueue());
   }
 
+  GALOIS_ATTRIBUTE_NOINLINE
+  void runDeferred(ThreadLocalData& tld) {
+    runQueue<0>(tld, *aborted.takeDeferred());
+  }
+
   void fastPushBack(typename UserContextAccess<value_type>::PushBufferTy& x) {
     wl.push(x.begin(), x.end());
     x.clear();
@@ -314,6 +466,10 @@ protected:
       tld.facing.setBreakFlag(&broke);
     if (couldAbort)
       setThreadContext(&tld.ctx);
+    if constexpr (optimisticReads) {
+      if (couldAbort)
+        tld.facing.setOptimisticContext(&tld.ctx);
+    }
     if (needsPush && !couldAbort)
       tld.facing.setFastPushBack(std::bind(&ForEachExecutor::fastPushBack, this,
                                            std::placeholders::_1));
@@ -337,11 +493,27 @@ protected:
           didWork = b || didWork;
         }
 
+        // Help with loops nested in the iterations of other threads
+        if (!didWork)
+          internal::helpNested();
+
         // Update node color and prop token
         term.localTermination(didWork);
         substrate::asmPause(); // Let token propagate
       } while (!term.globalTermination() && (!needsBreak || !broke));
 
+      if (manageContention && couldAbort && aborted.anyDeferred() &&
+          (!needsBreak || !broke)) {
+        // Run the serial tail on one thread while the others wait, then
+        // resume the parallel phase with whatever work the tail pushed
+        barrier.wait();
+        if (substrate::ThreadPool::getTID() == 0)
+          runDeferred(tld);
+        term.initializeThread();
+        barrier.wait();
+        continue;
+      }
+
       if (checkEmpty(wl, tld, 0)) {
         execTime.stop();
         break;
@@ -367,7 +539,8 @@ protected:
   ForEachExecutor(T2, FunctionTy f, const ArgsTy& args, WArgsTy... wargs)
       : term(substrate::getSystemTermination(activeThreads)),
         barrier(getBarrier(activeThreads)), wl(std::forward<WArgsTy>(wargs)...),
-        origFunction(f), loopname(galois::internal::getLoopName(args)),
+        origFunction(f), prefetcher(internal::getPrefetcher(args)),
+        loopname(galois::internal::getLoopName(args)),
         broke(false), initTime(loopname, "Init"),
         execTime(loopname, "Execute") {}
 
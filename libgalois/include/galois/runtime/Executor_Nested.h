@@ -0,0 +1,179 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_RUNTIME_EXECUTOR_NESTED_H
+#define GALOIS_RUNTIME_EXECUTOR_NESTED_H
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iterator>
+
+#include "galois/config.h"
+#include "galois/runtime/Context.h"
+#include "galois/substrate/CompilerSpecific.h"
+#include "galois/substrate/SimpleLock.h"
+#include "galois/Traits.h"
+
+namespace galois {
+namespace runtime {
+//! Implementation of loops nested in the operator of another loop
+namespace internal {
+
+/**
+ * Part [begin, end) of a nested loop that another thread may run. The
+ * thread that finishes it decrements the pending count of the loop.
+ */
+struct NestedTask {
+  void (*run)(void* loop, size_t begin, size_t end);
+  void* loop;
+  size_t begin;
+  size_t end;
+  std::atomic<size_t>* pending;
+};
+
+/**
+ * Nested tasks published by one thread. The owner pushes and pops at the
+ * back, so it takes back the smallest and most recent parts of its loops,
+ * while other threads steal the largest ones at the front.
+ */
+struct alignas(substrate::GALOIS_CACHE_LINE_SIZE) NestedQueue {
+  substrate::SimpleLock lock;
+  std::atomic<unsigned> size{0};
+  std::deque<NestedTask> tasks;
+};
+
+//! Number of published tasks that no thread has taken yet
+extern std::atomic<unsigned> nestedTasks;
+
+NestedQueue& getNestedQueue();
+
+void pushNestedTask(const NestedTask& task);
+
+/**
+ * Runs one published task, preferring the tasks of this thread. The task
+ * runs without a thread context: it is part of an iteration of another
+ * thread, which has acquired everything the task touches.
+ *
+ * @returns true if a task was run
+ */
+bool runNestedTask();
+
+//! Called by threads of a loop that have run out of work of their own
+inline bool helpNested() {
+  return nestedTasks.load(std::memory_order_relaxed) && runNestedTask();
+}
+
+/**
+ * Helps with nested tasks until all threads of the loop have finished their
+ * own work; busy counts these threads and must start at the number of
+ * threads of the loop.
+ */
+inline void finishAndHelpNested(std::atomic<unsigned>& busy) {
+  busy.fetch_sub(1, std::memory_order_acq_rel);
+  while (busy.load(std::memory_order_acquire)) {
+    if (!helpNested())
+      substrate::asmPause();
+  }
+}
+
+/**
+ * A do_all over a random access range run from inside an operator. The
+ * calling thread works through the range in chunks; whenever its queue is
+ * empty, i.e., its last published part has been stolen or there is none, it
+ * publishes the upper half of what is left. Loops that no thread steals
+ * from therefore cost one check per chunk, and ranges are only split as
+ * long as idle threads keep taking parts. Thieves split their parts the
+ * same way.
+ */
+template <typename Iter, typename F>
+class NestedLoop {
+  Iter base;
+  F& func;
+  size_t grain;
+  std::atomic<size_t> pending;
+
+  static void runTask(void* loop, size_t begin, size_t end) {
+    static_cast<NestedLoop*>(loop)->execute(begin, end);
+  }
+
+public:
+  NestedLoop(Iter b, F& f, size_t g) : base(b), func(f), grain(g), pending(0) {}
+
+  void execute(size_t begin, size_t end) {
+    NestedQueue& queue = getNestedQueue();
+    while (begin < end) {
+      if (end - begin > grain &&
+          !queue.size.load(std::memory_order_relaxed)) {
+        size_t mid = begin + (end - begin) / 2;
+        pending.fetch_add(1, std::memory_order_relaxed);
+        pushNestedTask(NestedTask{&runTask, this, mid, end, &pending});
+        end = mid;
+        continue;
+      }
+      size_t stop = std::min(end, begin + grain);
+      for (; begin < stop; ++begin)
+        func(*(base + begin));
+    }
+  }
+
+  //! Waits for the published parts, running them if no one else took them
+  void join() {
+    while (pending.load(std::memory_order_acquire)) {
+      if (!runNestedTask())
+        substrate::asmPause();
+    }
+  }
+};
+
+template <typename R, typename F>
+void nested_do_all_impl(const R& range, F& func, size_t,
+                        std::input_iterator_tag) {
+  for (auto ii = range.begin(), ei = range.end(); ii != ei; ++ii)
+    func(*ii);
+}
+
+template <typename R, typename F>
+void nested_do_all_impl(const R& range, F& func, size_t grain,
+                        std::random_access_iterator_tag) {
+  // the nested body is part of the enclosing iteration, whose neighborhood
+  // must already be acquired; without a context, no conflict can abort it
+  // while parts of it are published
+  SimpleRuntimeContext* ctx = getThreadContext();
+  setThreadContext(0);
+  NestedLoop<typename R::iterator, F> loop(range.begin(), func, grain);
+  loop.execute(0, std::distance(range.begin(), range.end()));
+  loop.join();
+  setThreadContext(ctx);
+}
+
+template <typename R, typename F, typename ArgsT>
+void nested_do_all(const R& range, F& func, const ArgsT& argsTuple) {
+  size_t grain =
+      std::max<size_t>(1, get_trait_value<chunk_size_tag>(argsTuple).value);
+  nested_do_all_impl(range, func, grain,
+                     typename std::iterator_traits<
+                         typename R::iterator>::iterator_category());
+}
+
+} // namespace internal
+} // namespace runtime
+} // namespace galois
+
+#endif
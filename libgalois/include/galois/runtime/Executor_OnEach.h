@@ -22,6 +22,7 @@
 
 #include "galois/config.h"
 #include "galois/gIO.h"
+#include "galois/runtime/Executor_Nested.h"
 #include "galois/runtime/OperatorReferenceTypes.h"
 #include "galois/runtime/Statistics.h"
 #include "galois/runtime/ThreadTimer.h"
@@ -55,12 +56,16 @@ inline void on_each_impl(FunctionTy&& fn, const ArgsTy& argsTuple) {
 
   OperatorReferenceType<decltype(std::forward<FunctionTy>(fn))> fn_ref = fn;
 
+  std::atomic<unsigned> busy(numT);
+
   auto runFun = [&] {
     execTime.start();
 
     fn_ref(substrate::ThreadPool::getTID(), numT);
 
     execTime.stop();
+
+    finishAndHelpNested(busy);
   };
 
   timer.start();
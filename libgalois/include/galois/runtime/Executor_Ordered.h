@@ -16,38 +16,371 @@
  * including but not limited to those resulting from defects in Software and/or
  * Documentation, or loss or inaccuracy of data of any kind.
  */
-
 #ifndef GALOIS_RUNTIME_EXECUTOR_ORDERED_H
 #define GALOIS_RUNTIME_EXECUTOR_ORDERED_H
 
+#include <algorithm>
+#include <deque>
+#include <iterator>
+
 #include "galois/config.h"
+#include "galois/gIO.h"
+#include "galois/optional.h"
+#include "galois/PriorityQueue.h"
+#include "galois/runtime/Context.h"
+#include "galois/runtime/LoopStatistics.h"
+#include "galois/runtime/Range.h"
+#include "galois/runtime/Statistics.h"
+#include "galois/runtime/Substrate.h"
+#include "galois/runtime/UserContextAccess.h"
+#include "galois/substrate/PerThreadStorage.h"
+#include "galois/substrate/ThreadPool.h"
+#include "galois/Threads.h"
 
 namespace galois {
 namespace runtime {
+//! Implementation of ordered execution
+namespace internal {
+
+/**
+ * Conflict detection for an item of the window. Items acquire their whole
+ * neighborhood before anything is executed; an item takes a lock away from
+ * a later item and gives up when the lock belongs to an earlier one, so
+ * once all neighborhoods are acquired, an item holds all of its locks iff no
+ * earlier item of the window touches its neighborhood.
+ */
+template <typename T, typename Cmp>
+class OrderedContext : public SimpleRuntimeContext {
+  const Cmp& cmp;
+  bool notReady;
+  unsigned tid;
+  size_t pos;
+
+public:
+  T item;
+  bool stable;
+
+  //! Context of the item at position p of the window of thread t
+  OrderedContext(const T& i, const Cmp& c, unsigned t, size_t p)
+      : SimpleRuntimeContext(true), cmp(c), notReady(false), tid(t), pos(p),
+        item(i), stable(true) {}
+
+  bool isReady() const { return !notReady; }
+
+  //! Items with equal priority are ordered by thread and then by position in
+  //! the window of their thread, the order in which the executor picks the
+  //! earliest item of the window, so that this item wins all its locks
+  bool precedes(const OrderedContext* other) const {
+    if (cmp(item, other->item))
+      return true;
+    if (cmp(other->item, item))
+      return false;
+    if (tid != other->tid)
+      return tid < other->tid;
+    return pos < other->pos;
+  }
+
+  virtual void subAcquire(Lockable* lockable, galois::MethodFlag) {
+    if (this->tryLock(lockable))
+      this->addToNhood(lockable);
+
+    OrderedContext* other;
+    do {
+      other = static_cast<OrderedContext*>(this->getOwner(lockable));
+      if (other == this)
+        return;
+      if (other && other->precedes(this)) {
+        // A lock that I want but can't get
+        notReady = true;
+        return;
+      }
+    } while (!this->stealByCAS(lockable, other));
+
+    // Disable loser
+    if (other) {
+      // Only need atomic write
+      other->notReady = true;
+    }
+  }
+};
+
+template <typename T>
+struct AlwaysStable {
+  bool operator()(const T&) const { return true; }
+};
+
+/**
+ * Executes items in the order given by Cmp, running in parallel the items
+ * that no earlier item can affect. Execution proceeds in rounds over a window
+ * of the earliest pending items:
+ *
+ * 1. every thread pops the earliest items of its own heap; the window is
+ *    then cut at the earliest item that some thread left in its heap, so
+ *    that no pending item outside the window precedes an item inside it,
+ * 2. every item of the window acquires its neighborhood with nhFunc
+ *    (speculatively, as nothing is written yet); an item that loses a lock to
+ *    an earlier item is rolled back, i.e., its locks are released and it is
+ *    put back in the heap for a later round,
+ * 3. the items that kept all their locks are sources: they run opFunc in
+ *    parallel and commit, and the items they push join the heap.
+ *
+ * Running sources out of order is only safe if executing an item never
+ * creates an earlier item that conflicts with a source, which holds for
+ * stable-source algorithms. Otherwise, stabilityTest tells which sources
+ * are safe to run now; the earliest item of the window is always safe as
+ * long as pushed items do not precede the item that pushes them.
+ *
+ * The window grows while almost all of its items commit and shrinks with
+ * the commit ratio otherwise.
+ */
+template <typename T, typename Cmp, typename NhFunc, typename OpFunc,
+          typename StableTest, bool HasStableTest>
+class OrderedExecutor {
+  typedef OrderedContext<T, Cmp> Context;
+  typedef galois::MinHeap<T, Cmp> Heap;
+
+  static const size_t InitialWindow = 64;
+  static const size_t MinWindow     = 8;
+  static const size_t MaxWindow     = 1 << 16;
+
+  // Truly thread-local
+  using LoopStat = LoopStatistics<true>;
+  struct ThreadLocalData : public LoopStat {
+    UserContextAccess<T> facing;
+    std::deque<Context> window;
+    size_t windowSize; // number of items to pop, the same in every thread
+    size_t rounds;
+    explicit ThreadLocalData(const char* ln)
+        : LoopStat(ln), windowSize(InitialWindow), rounds(0) {}
+  };
+
+  // Read by all threads to agree on the window
+  struct SharedData {
+    Heap pending;
+    galois::optional<T> first; // earliest item popped in this round
+    galois::optional<T> last;  // latest item popped, if pending is not empty
+    // indexed by round parity, as they are read one round after being set
+    size_t committed[2];
+    size_t iterations[2];
+    explicit SharedData(const Cmp& cmp)
+        : pending(cmp), committed{0, 0}, iterations{0, 0} {}
+  };
+
+  Cmp cmp;
+  NhFunc nhFunc;
+  OpFunc opFunc;
+  StableTest stabilityTest;
+  const char* loopname;
+  unsigned numThreads;
+  substrate::Barrier& barrier;
+  substrate::PerThreadStorage<SharedData> shared;
+
+  void popWindow(ThreadLocalData& tld, SharedData& local, unsigned tid) {
+    local.first = galois::optional<T>();
+    local.last  = galois::optional<T>();
+    for (size_t i = 0; i < tld.windowSize && !local.pending.empty(); ++i)
+      tld.window.emplace_back(local.pending.pop(), cmp, tid, i);
+    if (!tld.window.empty()) {
+      local.first = tld.window.front().item;
+      if (!local.pending.empty())
+        local.last = tld.window.back().item;
+    }
+  }
 
-// TODO(ddn): Pull in and integrate in executors from exp
+  void calculateWindow(ThreadLocalData& tld, unsigned parity) {
+    size_t allcommitted  = 0;
+    size_t alliterations = 0;
+    for (unsigned i = 0; i < numThreads; ++i) {
+      SharedData& r = *shared.getRemote(i);
+      allcommitted += r.committed[parity];
+      alliterations += r.iterations[parity];
+    }
+    if (!alliterations)
+      return;
 
+    float commitRatio  = allcommitted / (float)alliterations;
+    const float target = 0.95;
+    if (commitRatio >= target)
+      tld.windowSize = std::min(tld.windowSize * 2, MaxWindow);
+    else
+      tld.windowSize = std::max(
+          (size_t)(commitRatio / target * tld.windowSize), MinWindow);
+  }
+
+  void go() {
+    ThreadLocalData tld(loopname);
+    SharedData& local = *shared.getLocal();
+    unsigned tid      = substrate::ThreadPool::getTID();
+
+    while (true) {
+      ++tld.rounds;
+      unsigned cur          = tld.rounds & 1;
+      local.committed[cur]  = 0;
+      local.iterations[cur] = 0;
+
+      popWindow(tld, local, tid);
+
+      barrier.wait();
+
+      // Every thread computes the same bound and window size. The earliest
+      // item is the first of the lowest thread among those with the earliest
+      // priority, which is the least item of the window for precedes()
+      const T* limit    = nullptr;
+      const T* earliest = nullptr;
+      unsigned owner    = 0;
+      for (unsigned i = 0; i < numThreads; ++i) {
+        SharedData& r = *shared.getRemote(i);
+        if (r.first && (!earliest || cmp(*r.first, *earliest))) {
+          earliest = &*r.first;
+          owner    = i;
+        }
+        if (r.last && (!limit || cmp(*r.last, *limit)))
+          limit = &*r.last;
+      }
+      if (!earliest)
+        break;
+      calculateWindow(tld, cur ^ 1);
+
+      if (limit) {
+        while (!tld.window.empty() && cmp(*limit, tld.window.back().item)) {
+          local.pending.push(tld.window.back().item);
+          tld.window.pop_back();
+        }
+      }
+
+      for (auto& ctx : tld.window) {
+        tld.inc_iterations();
+        ctx.startIteration();
+        setThreadContext(&ctx);
+        nhFunc(ctx.item);
+        if (HasStableTest)
+          ctx.stable = stabilityTest(ctx.item);
+      }
+      setThreadContext(0);
+      local.iterations[cur] = tld.window.size();
+      if (HasStableTest && tid == owner)
+        tld.window.front().stable = true;
+
+      barrier.wait();
+
+      for (auto& ctx : tld.window) {
+        if (ctx.isReady() && ctx.stable) {
+          opFunc(ctx.item, tld.facing.data());
+          auto& pb = tld.facing.getPushBuffer();
+          tld.inc_pushes(pb.size());
+          for (auto& item : pb)
+            local.pending.push(item);
+          tld.facing.resetPushBuffer();
+          tld.facing.resetAlloc();
+          ++local.committed[cur];
+        } else {
+          local.pending.push(ctx.item);
+          tld.inc_conflicts();
+        }
+      }
+      // Nothing is acquired while operators run, so the locks can go as
+      // soon as this thread's items are done
+      for (auto& ctx : tld.window)
+        ctx.commitIteration();
+      tld.window.clear();
+    }
+
+    if (tid == 0)
+      reportStat_Single(loopname, "RoundsExecuted", tld.rounds);
+  }
+
+  //! With a single thread, items simply run in priority order
+  void goSerial() {
+    ThreadLocalData tld(loopname);
+    Heap& pending = shared.getLocal()->pending;
+    while (!pending.empty()) {
+      T item = pending.pop();
+      tld.inc_iterations();
+      opFunc(item, tld.facing.data());
+      auto& pb = tld.facing.getPushBuffer();
+      tld.inc_pushes(pb.size());
+      for (auto& i : pb)
+        pending.push(i);
+      tld.facing.resetPushBuffer();
+      tld.facing.resetAlloc();
+    }
+  }
+
+public:
+  OrderedExecutor(const Cmp& c, const NhFunc& nh, const OpFunc& op,
+                  const StableTest& st, const char* ln)
+      : cmp(c), nhFunc(nh), opFunc(op), stabilityTest(st),
+        loopname(ln ? ln : "for_each_ordered"),
+        numThreads(activeThreads), barrier(getBarrier(numThreads)),
+        shared(cmp) {}
+
+  template <typename RangeTy>
+  void initThread(const RangeTy& range) {
+    Heap& pending = shared.getLocal()->pending;
+    auto p        = range.local_pair();
+    for (auto ii = p.first; ii != p.second; ++ii)
+      pending.push(*ii);
+  }
+
+  void operator()() {
+    if (numThreads == 1)
+      goSerial();
+    else
+      go();
+  }
+};
+
+template <typename T, typename Cmp, typename NhFunc, typename OpFunc,
+          typename StableTest, bool HasStableTest, typename Iter>
+void runOrdered(Iter beg, Iter end, const Cmp& cmp, const NhFunc& nhFunc,
+                const OpFunc& opFunc, const StableTest& stabilityTest,
+                const char* loopname) {
+  typedef OrderedExecutor<T, Cmp, NhFunc, OpFunc, StableTest, HasStableTest>
+      WorkTy;
+
+  auto range    = makeStandardRange(beg, end);
+  auto& barrier = getBarrier(activeThreads);
+  WorkTy W(cmp, nhFunc, opFunc, stabilityTest, loopname);
+  substrate::getThreadPool().run(
+      activeThreads, [&W, &range]() { W.initThread(range); }, std::ref(barrier),
+      std::ref(W));
+}
+
+} // namespace internal
+
+/**
+ * Ordered execution for stable-source algorithms, where an item that is the
+ * earliest in its neighborhood stays so until it runs. nhFunc(item) must
+ * acquire (e.g., with MethodFlag::WRITE) every element that opFunc reads or
+ * writes, and opFunc must not touch anything else.
+ */
 template <typename Iter, typename Cmp, typename NhFunc, typename OpFunc>
-void for_each_ordered_impl(Iter GALOIS_UNUSED(beg), Iter GALOIS_UNUSED(end),
-                           const Cmp& GALOIS_UNUSED(cmp),
-                           const NhFunc& GALOIS_UNUSED(nhFunc),
-                           const OpFunc& GALOIS_UNUSED(opFunc),
-                           const char* GALOIS_UNUSED(loopname)) {
-  GALOIS_DIE("not yet implemented");
+void for_each_ordered_impl(Iter beg, Iter end, const Cmp& cmp,
+                           const NhFunc& nhFunc, const OpFunc& opFunc,
+                           const char* loopname) {
+  typedef typename std::iterator_traits<Iter>::value_type T;
+  internal::runOrdered<T, Cmp, NhFunc, OpFunc, internal::AlwaysStable<T>,
+                       false>(beg, end, cmp, nhFunc, opFunc,
+                              internal::AlwaysStable<T>(), loopname);
 }
 
+/**
+ * Ordered execution for unstable-source algorithms: a source of the window
+ * only runs if stabilityTest(item) holds, except for the earliest item which
+ * always runs.
+ */
 template <typename Iter, typename Cmp, typename NhFunc, typename OpFunc,
           typename StableTest>
-void for_each_ordered_impl(Iter GALOIS_UNUSED(beg), Iter GALOIS_UNUSED(end),
-                           const Cmp& GALOIS_UNUSED(cmp),
-                           const NhFunc& GALOIS_UNUSED(nhFunc),
-                           const OpFunc& GALOIS_UNUSED(opFunc),
-                           const StableTest& GALOIS_UNUSED(stabilityTest),
-                           const char* GALOIS_UNUSED(loopname)) {
-  GALOIS_DIE("not yet implemented");
+void for_each_ordered_impl(Iter beg, Iter end, const Cmp& cmp,
+                           const NhFunc& nhFunc, const OpFunc& opFunc,
+                           const StableTest& stabilityTest,
+                           const char* loopname) {
+  typedef typename std::iterator_traits<Iter>::value_type T;
+  internal::runOrdered<T, Cmp, NhFunc, OpFunc, StableTest, true>(
+      beg, end, cmp, nhFunc, opFunc, stabilityTest, loopname);
 }
 
-} // end namespace runtime
+} // namespace runtime
 } // end namespace galois
 
 #endif
@@ -0,0 +1,122 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_RUNTIME_INTERLEAVE_H
+#define GALOIS_RUNTIME_INTERLEAVE_H
+
+#include <utility>
+
+#include "galois/config.h"
+#include "galois/optional.h"
+#include "galois/Traits.h"
+
+namespace galois::runtime::internal {
+
+//! Prefetcher of loops without the interleave trait
+struct NoPrefetch {
+  static constexpr unsigned distance = 0;
+
+  template <typename A>
+  void prefetch(const A&) const {}
+};
+
+//! The galois::interleave trait of a loop, or NoPrefetch if it has none
+template <typename ArgsTuple>
+auto getPrefetcher(const ArgsTuple& args) {
+  if constexpr (has_trait<interleave_tag, ArgsTuple>()) {
+    return get_trait_value<interleave_tag>(args);
+  } else {
+    return NoPrefetch{};
+  }
+}
+
+/**
+ * Calls fn on [beg, end) and prefetches for each item distance items ahead,
+ * so that the operator of one item runs while the data of the next ones is
+ * on its way. This is the two-stage case of interleaving the instances of
+ * an operator: one stage issues the loads and the other uses them.
+ */
+template <typename P, typename Iter, typename F>
+void runInterleaved(const P& p, Iter beg, const Iter end, F&& fn) {
+  if constexpr (P::distance == 0) {
+    for (; beg != end; ++beg)
+      fn(*beg);
+  } else {
+    Iter ahead = beg;
+    for (unsigned i = 0; i < P::distance && ahead != end; ++i, ++ahead)
+      p.prefetch(*ahead);
+    for (; beg != end; ++beg) {
+      if (ahead != end) {
+        p.prefetch(*ahead);
+        ++ahead;
+      }
+      fn(*beg);
+    }
+  }
+}
+
+/**
+ * Like runInterleaved, but for items that are popped one at a time: pop()
+ * returns an optional item. Up to distance popped items wait in a ring
+ * between their prefetch and the call of fn. Returns whether there was an
+ * item.
+ */
+template <typename P, typename T, typename Pop, typename F>
+bool runInterleavedPops(const P& p, Pop&& pop, F&& fn) {
+  if constexpr (P::distance == 0) {
+    bool didWork = false;
+    galois::optional<T> item;
+    while ((item = pop())) {
+      didWork = true;
+      fn(*item);
+    }
+    return didWork;
+  } else {
+    galois::optional<T> ring[P::distance];
+    unsigned head = 0;
+    unsigned size = 0;
+    for (; size < P::distance; ++size) {
+      if (!(ring[size] = pop()))
+        break;
+      p.prefetch(*ring[size]);
+    }
+    bool didWork = size > 0;
+    // While the ring is full, replace the oldest item by a new one
+    while (size == P::distance) {
+      T item = std::move(*ring[head]);
+      if ((ring[head] = pop()))
+        p.prefetch(*ring[head]);
+      else
+        --size;
+      head = (head + 1) % P::distance;
+      fn(item);
+    }
+    // The worklist ran dry: the items left follow the empty slot
+    for (unsigned i = 0; i < P::distance; ++i) {
+      if (ring[head])
+        fn(*ring[head]);
+      head = (head + 1) % P::distance;
+    }
+    return didWork;
+  }
+}
+
+} // namespace galois::runtime::internal
+
+#endif
@@ -34,17 +34,27 @@ protected:
   size_t m_iterations;
   size_t m_pushes;
   size_t m_conflicts;
+  //! Conflicts caused by optimistic reads, reported separately from the
+  //! remaining (write) conflicts if splitConflicts is set
+  size_t m_readConflicts;
+  bool splitConflicts;
   const char* loopname;
 
 public:
-  explicit LoopStatistics(const char* ln)
-      : m_iterations(0), m_pushes(0), m_conflicts(0), loopname(ln) {}
+  explicit LoopStatistics(const char* ln, bool split = false)
+      : m_iterations(0), m_pushes(0), m_conflicts(0), m_readConflicts(0),
+        splitConflicts(split), loopname(ln) {}
 
   ~LoopStatistics() {
     reportStat_Tsum(loopname, "Iterations", m_iterations);
     reportStat_Tsum(loopname, "Commits", (m_iterations - m_conflicts));
     reportStat_Tsum(loopname, "Pushes", m_pushes);
     reportStat_Tsum(loopname, "Conflicts", m_conflicts);
+    if (splitConflicts) {
+      reportStat_Tsum(loopname, "ReadConflicts", m_readConflicts);
+      reportStat_Tsum(loopname, "WriteConflicts",
+                      m_conflicts - m_readConflicts);
+    }
   }
 
   size_t iterations(void) const { return m_iterations; }
@@ -56,12 +66,17 @@ public:
   inline void inc_iterations() { ++m_iterations; }
 
   inline void inc_conflicts() { ++m_conflicts; }
+
+  inline void inc_read_conflicts() {
+    ++m_conflicts;
+    ++m_readConflicts;
+  }
 };
 
 template <>
 class LoopStatistics<false> {
 public:
-  explicit LoopStatistics(const char*) {}
+  explicit LoopStatistics(const char*, bool = false) {}
 
   size_t iterations(void) const { return 0; }
   size_t pushes(void) const { return 0; }
@@ -70,6 +85,7 @@ public:
   inline void inc_iterations() const {}
   inline void inc_pushes(size_t = 0) const {}
   inline void inc_conflicts() const {}
+  inline void inc_read_conflicts() const {}
 };
 
 } // namespace runtime
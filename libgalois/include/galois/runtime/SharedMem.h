@@ -34,6 +34,16 @@ class SharedMem : public galois::substrate::SharedMem {
   internal::PageAllocState<> m_pa;
   SM m_sm;
 
+  void reportLaunchStats() {
+    auto stats = substrate::getThreadPool().getLaunchStats();
+    if (!stats.count)
+      return;
+    reportStat_Single("ThreadPool", "Launches", stats.count);
+    reportStat_Single("ThreadPool", "LaunchLatencyAvgNs",
+                      stats.totalLatency / stats.count);
+    reportStat_Single("ThreadPool", "LaunchLatencyMaxNs", stats.maxLatency);
+  }
+
 public:
   explicit SharedMem() : m_pa(), m_sm() {
     internal::setPagePoolState(&m_pa);
@@ -41,6 +51,7 @@ public:
   }
 
   ~SharedMem() {
+    reportLaunchStats();
     m_sm.print();
     internal::setSysStatManager(nullptr);
     internal::setPagePoolState(nullptr);
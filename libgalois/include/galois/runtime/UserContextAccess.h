@@ -40,6 +40,9 @@ public:
   SuperTy& data() { return *static_cast<SuperTy*>(this); }
   void setLocalState(void* p) { SuperTy::__setLocalState(p); }
   void setFastPushBack(FastPushBack f) { SuperTy::__setFastPushBack(f); }
+  void setOptimisticContext(OptimisticRuntimeContext* c) {
+    SuperTy::__setOptimisticContext(c);
+  }
   void setBreakFlag(bool* b) {
     SuperTy::didBreak = b;
   } // NOLINT(readability-non-const-parameter)
@@ -23,6 +23,7 @@
 #include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <thread>
@@ -66,35 +67,17 @@ protected:
   struct per_signal {
     std::condition_variable cv;
     std::mutex m;
-    unsigned wbegin, wend;
+    unsigned wbegin, wsplit, wend;
     std::atomic<int> done;
     std::atomic<int> fastRelease;
+    //! 0: waiting, 1: released, 2: parked on the futex
+    std::atomic<int> release;
     ThreadTopoInfo topo;
 
-    void wakeup(bool fastmode) {
-      if (fastmode) {
-        done        = 0;
-        fastRelease = 1;
-      } else {
-        std::lock_guard<std::mutex> lg(m);
-        done = 0;
-        cv.notify_one();
-        // start.release();
-      }
-    }
-
-    void wait(bool fastmode) {
-      if (fastmode) {
-        while (!fastRelease.load(std::memory_order_relaxed)) {
-          asmPause();
-        }
-        fastRelease = 0;
-      } else {
-        std::unique_lock<std::mutex> lg(m);
-        cv.wait(lg, [=] { return !done; });
-        // start.acquire();
-      }
-    }
+    void wakeup(bool fastmode);
+
+    //! outside of fastmode, spins for up to spins pauses before sleeping
+    void wait(bool fastmode, unsigned spins);
   };
 
   thread_local static per_signal my_box;
@@ -102,11 +85,23 @@ protected:
   MachineTopoInfo mi;
   std::vector<per_signal*> signals;
   std::vector<std::thread> threads;
+  //! thread IDs where the socket changes from the previous thread
+  std::vector<unsigned> socketBoundaries;
   unsigned reserved;
   unsigned masterFastmode;
+  //! number of pauses a waiting thread spins for before it sleeps
+  unsigned spinPauses;
   bool running;
   std::function<void(void)> work;
 
+  //! when the master started the current run; read by the woken threads
+  std::atomic<int64_t> launchStart;
+  //! latest start of a woken up thread in this run, relative to launchStart
+  std::atomic<int64_t> launchLatency;
+  uint64_t numLaunches;
+  uint64_t launchLatencyTotal;
+  uint64_t launchLatencyMax;
+
   //! destroy all threads
   void destroyCommon();
 
@@ -116,6 +111,12 @@ protected:
   //! main thread loop
   void threadLoop(unsigned tid);
 
+  //! set spinPauses to the pauses that fit in the spin time
+  void calibrateSpin();
+
+  //! where to split [wbegin, wend) between the two children of a cascade
+  unsigned cascadeSplit(unsigned wbegin, unsigned wend) const;
+
   //! spin up for run
   void cascade(bool fastmode);
 
@@ -171,6 +172,18 @@ public:
 
   bool isRunning() const { return running; }
 
+  //! Latency of waking up threads for run: the time from the start of a run
+  //! until the last of its threads started working, in nanoseconds, over all
+  //! runs on more than one thread
+  struct LaunchStats {
+    uint64_t count;
+    uint64_t totalLatency;
+    uint64_t maxLatency;
+  };
+  LaunchStats getLaunchStats() const {
+    return LaunchStats{numLaunches, launchLatencyTotal, launchLatencyMax};
+  }
+
   //! return the number of non-reserved threads in the pool
   unsigned getMaxUsableThreads() const { return mi.maxThreads - reserved; }
   //! return the number of threads supported by the thread pool on the current
@@ -21,7 +21,10 @@
 #include "galois/substrate/SimpleLock.h"
 #include "galois/substrate/CacheLineStorage.h"
 
+#include <atomic>
+#include <cstdint>
 #include <stdio.h>
+#include <vector>
 
 //! Global thread context for each active thread
 static thread_local galois::runtime::SimpleRuntimeContext* thread_ctx = 0;
@@ -97,3 +100,97 @@ void galois::runtime::SimpleRuntimeContext::subAcquire(
     galois::runtime::Lockable*, galois::MethodFlag) {
   GALOIS_DIE("unreachable");
 }
+
+namespace {
+
+//! Versions of the lockables read optimistically, so that only loops with
+//! optimistic reads pay for them. Allocated on first use.
+std::atomic<unsigned>& versionOf(galois::runtime::Lockable* lockable) {
+  constexpr unsigned bits = 18;
+  static std::vector<std::atomic<unsigned>> versions(size_t(1) << bits);
+  uint64_t h = (reinterpret_cast<uintptr_t>(lockable) >> 4) *
+               UINT64_C(0x9E3779B97F4A7C15);
+  return versions[h >> (64 - bits)];
+}
+
+} // namespace
+
+void galois::runtime::OptimisticRuntimeContext::subAcquire(
+    galois::runtime::Lockable* lockable, galois::MethodFlag m) {
+  if ((m & MethodFlag::INTERNAL_MASK) == MethodFlag::READ) {
+    if (validated) {
+      // Locked like a write, but kept apart so that commit does not bump
+      // its version
+      AcquireStatus i = tryAcquire(lockable);
+      if (i == AcquireStatus::NEW_OWNER)
+        reads.push_back(Read{lockable, 0, true});
+      else if (i == AcquireStatus::FAIL)
+        signalReadConflict(lockable);
+      return;
+    }
+    // Read the version before checking the lock, so that a writer that
+    // commits in between changes the version we compare against
+    unsigned version = versionOf(lockable).load(std::memory_order_acquire);
+    if (isLocked(lockable)) {
+      if (getOwner(lockable) != this)
+        signalReadConflict(lockable);
+      return;
+    }
+    reads.push_back(Read{lockable, version, false});
+    return;
+  }
+
+  AcquireStatus i = tryAcquire(lockable);
+  if (i == AcquireStatus::NEW_OWNER)
+    addToNhood(lockable);
+  else if (i == AcquireStatus::FAIL)
+    signalConflict(lockable);
+  else if (validated)
+    promoteRead(lockable);
+}
+
+void galois::runtime::OptimisticRuntimeContext::promoteRead(
+    galois::runtime::Lockable* lockable) {
+  for (Read& r : reads) {
+    if (r.lockable == lockable && r.locked) {
+      r.locked = false;
+      addToNhood(lockable);
+      return;
+    }
+  }
+}
+
+void galois::runtime::OptimisticRuntimeContext::validate() {
+  if (validated)
+    return;
+  for (Read& r : reads) {
+    AcquireStatus i = tryAcquire(r.lockable);
+    if (i == AcquireStatus::FAIL)
+      signalReadConflict(r.lockable);
+    r.locked = i == AcquireStatus::NEW_OWNER;
+    if (versionOf(r.lockable).load(std::memory_order_acquire) != r.version)
+      signalReadConflict(r.lockable);
+  }
+  validated = true;
+}
+
+void galois::runtime::OptimisticRuntimeContext::releaseReads() {
+  for (Read& r : reads)
+    if (r.locked)
+      release(r.lockable);
+  reads.clear();
+}
+
+unsigned galois::runtime::OptimisticRuntimeContext::cancelIteration() {
+  releaseReads();
+  return SimpleRuntimeContext::cancelIteration();
+}
+
+unsigned galois::runtime::OptimisticRuntimeContext::commitIteration() {
+  assert(validated || reads.empty());
+  // Only the lockables acquired for writing are in the neighborhood
+  for (Lockable* lockable = locks; lockable; lockable = lockable->next)
+    versionOf(lockable).fetch_add(1, std::memory_order_release);
+  releaseReads();
+  return SimpleRuntimeContext::commitIteration();
+}
@@ -21,3 +21,5 @@
 
 thread_local galois::runtime::SizedHeapFactory::SizedHeap*
     galois::runtime::internal::dagListHeap;
+thread_local galois::runtime::SizedHeapFactory::SizedHeap*
+    galois::runtime::internal::readListHeap;
@@ -0,0 +1,87 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/runtime/Executor_Nested.h"
+#include "galois/runtime/Range.h"
+#include "galois/substrate/ThreadPool.h"
+
+#include <algorithm>
+#include <vector>
+
+std::atomic<unsigned> galois::runtime::internal::nestedTasks(0);
+
+static std::vector<galois::runtime::internal::NestedQueue>& getQueues() {
+  static std::vector<galois::runtime::internal::NestedQueue> queues(
+      galois::substrate::getThreadPool().getMaxThreads());
+  return queues;
+}
+
+galois::runtime::internal::NestedQueue&
+galois::runtime::internal::getNestedQueue() {
+  return getQueues()[substrate::ThreadPool::getTID()];
+}
+
+void galois::runtime::internal::pushNestedTask(const NestedTask& task) {
+  NestedQueue& queue = getNestedQueue();
+  queue.lock.lock();
+  queue.tasks.push_back(task);
+  queue.size.store(queue.tasks.size(), std::memory_order_relaxed);
+  queue.lock.unlock();
+  nestedTasks.fetch_add(1, std::memory_order_release);
+}
+
+static bool takeTask(galois::runtime::internal::NestedQueue& queue,
+                     galois::runtime::internal::NestedTask& task, bool own) {
+  if (!queue.size.load(std::memory_order_relaxed))
+    return false;
+  queue.lock.lock();
+  bool found = !queue.tasks.empty();
+  if (found) {
+    if (own) {
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+    } else {
+      task = queue.tasks.front();
+      queue.tasks.pop_front();
+    }
+    queue.size.store(queue.tasks.size(), std::memory_order_relaxed);
+  }
+  queue.lock.unlock();
+  return found;
+}
+
+bool galois::runtime::internal::runNestedTask() {
+  auto& queues = getQueues();
+  unsigned tid = substrate::ThreadPool::getTID();
+  unsigned num = std::min<unsigned>(activeThreads, queues.size());
+  NestedTask task;
+  bool found = takeTask(queues[tid], task, true);
+  for (unsigned i = 1; !found && i < num; ++i)
+    found = takeTask(queues[(tid + i) % num], task, false);
+  if (!found)
+    return false;
+  nestedTasks.fetch_sub(1, std::memory_order_relaxed);
+
+  SimpleRuntimeContext* ctx = getThreadContext();
+  setThreadContext(0);
+  task.run(task.loop, task.begin, task.end);
+  setThreadContext(ctx);
+  task.pending->fetch_sub(1, std::memory_order_release);
+  return true;
+}
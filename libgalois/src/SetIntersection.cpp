@@ -0,0 +1,318 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file SetIntersection.cpp
+ *
+ * Scalar and SIMD implementations of the sorted-set intersection kernels
+ * declared in galois/SetIntersection.h.
+ */
+
+#include "galois/SetIntersection.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define GALOIS_INTERSECT_X86 1
+#include <immintrin.h>
+#endif
+
+namespace galois {
+namespace intersection {
+
+namespace {
+
+size_t countMergeScalar(const uint32_t* a, size_t na, const uint32_t* b,
+                        size_t nb) {
+  size_t i = 0, j = 0, count = 0;
+  while (i < na && j < nb) {
+    uint32_t x = a[i];
+    uint32_t y = b[j];
+    i += (x <= y);
+    j += (y <= x);
+    count += (x == y);
+  }
+  return count;
+}
+
+size_t collectMergeScalar(const uint32_t* a, size_t na, const uint32_t* b,
+                          size_t nb, uint32_t* out) {
+  size_t i = 0, j = 0, count = 0;
+  while (i < na && j < nb) {
+    uint32_t x = a[i];
+    uint32_t y = b[j];
+    // always write; only keep it if the elements match
+    out[count] = x;
+    i += (x <= y);
+    j += (y <= x);
+    count += (x == y);
+  }
+  return count;
+}
+
+#ifdef GALOIS_INTERSECT_X86
+
+/*
+ * Block merges: compare a block of a against every rotation of a block of b
+ * (all pairs), then advance the block(s) with the smaller last element. An
+ * element of a can only match within the b blocks it is compared with
+ * because blocks are only skipped when all their elements are smaller than
+ * everything that follows in the other set.
+ */
+
+//! For every 8-bit mask, the lanes of the set bits in order
+struct CompressTable {
+  uint32_t lanes[256][8];
+  CompressTable() {
+    for (unsigned m = 0; m < 256; ++m) {
+      unsigned n = 0;
+      for (unsigned l = 0; l < 8; ++l) {
+        if (m & (1u << l)) {
+          lanes[m][n++] = l;
+        }
+      }
+      for (; n < 8; ++n) {
+        lanes[m][n] = 0;
+      }
+    }
+  }
+};
+
+const CompressTable compressTable;
+
+__attribute__((target("avx2"))) inline unsigned
+matchMaskAVX2(__m256i va, __m256i vb) {
+  const __m256i rotate = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+  __m256i match        = _mm256_cmpeq_epi32(va, vb);
+  for (unsigned r = 1; r < 8; ++r) {
+    vb    = _mm256_permutevar8x32_epi32(vb, rotate);
+    match = _mm256_or_si256(match, _mm256_cmpeq_epi32(va, vb));
+  }
+  return _mm256_movemask_ps(_mm256_castsi256_ps(match));
+}
+
+__attribute__((target("avx2,popcnt"))) size_t
+countMergeAVX2(const uint32_t* a, size_t na, const uint32_t* b, size_t nb) {
+  size_t i = 0, j = 0, count = 0;
+  while (i + 8 <= na && j + 8 <= nb) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+    count += _mm_popcnt_u32(matchMaskAVX2(va, vb));
+
+    uint32_t aLast = a[i + 7];
+    uint32_t bLast = b[j + 7];
+    i += (aLast <= bLast) * 8;
+    j += (bLast <= aLast) * 8;
+  }
+  return count + countMergeScalar(a + i, na - i, b + j, nb - j);
+}
+
+__attribute__((target("avx2,popcnt"))) size_t
+collectMergeAVX2(const uint32_t* a, size_t na, const uint32_t* b, size_t nb,
+                 uint32_t* out) {
+  size_t i = 0, j = 0, count = 0;
+  uint32_t matched[8];
+  while (i + 8 <= na && j + 8 <= nb) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+    unsigned mask = matchMaskAVX2(va, vb);
+    if (mask) {
+      __m256i lanes = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(compressTable.lanes[mask]));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(matched),
+                          _mm256_permutevar8x32_epi32(va, lanes));
+      unsigned n = _mm_popcnt_u32(mask);
+      std::memcpy(out + count, matched, n * sizeof(uint32_t));
+      count += n;
+    }
+
+    uint32_t aLast = a[i + 7];
+    uint32_t bLast = b[j + 7];
+    i += (aLast <= bLast) * 8;
+    j += (bLast <= aLast) * 8;
+  }
+  return count +
+         collectMergeScalar(a + i, na - i, b + j, nb - j, out + count);
+}
+
+__attribute__((target("avx512f"))) inline __mmask16
+matchMaskAVX512(__m512i va, __m512i vb) {
+  const __m512i rotate = _mm512_set_epi32(0, 15, 14, 13, 12, 11, 10, 9, 8, 7,
+                                          6, 5, 4, 3, 2, 1);
+  __mmask16 match      = _mm512_cmpeq_epi32_mask(va, vb);
+  for (unsigned r = 1; r < 16; ++r) {
+    // (masked form: the unmasked one trips -Wmaybe-uninitialized in GCC)
+    vb = _mm512_mask_permutexvar_epi32(vb, 0xFFFF, rotate, vb);
+    match |= _mm512_cmpeq_epi32_mask(va, vb);
+  }
+  return match;
+}
+
+__attribute__((target("avx512f,popcnt"))) size_t
+countMergeAVX512(const uint32_t* a, size_t na, const uint32_t* b, size_t nb) {
+  size_t i = 0, j = 0, count = 0;
+  while (i + 16 <= na && j + 16 <= nb) {
+    __m512i va = _mm512_loadu_si512(a + i);
+    __m512i vb = _mm512_loadu_si512(b + j);
+    count += _mm_popcnt_u32(matchMaskAVX512(va, vb));
+
+    uint32_t aLast = a[i + 15];
+    uint32_t bLast = b[j + 15];
+    i += (aLast <= bLast) * 16;
+    j += (bLast <= aLast) * 16;
+  }
+  return count + countMergeScalar(a + i, na - i, b + j, nb - j);
+}
+
+__attribute__((target("avx512f,popcnt"))) size_t
+collectMergeAVX512(const uint32_t* a, size_t na, const uint32_t* b, size_t nb,
+                   uint32_t* out) {
+  size_t i = 0, j = 0, count = 0;
+  while (i + 16 <= na && j + 16 <= nb) {
+    __m512i va     = _mm512_loadu_si512(a + i);
+    __m512i vb     = _mm512_loadu_si512(b + j);
+    __mmask16 mask = matchMaskAVX512(va, vb);
+    _mm512_mask_compressstoreu_epi32(out + count, mask, va);
+    count += _mm_popcnt_u32(mask);
+
+    uint32_t aLast = a[i + 15];
+    uint32_t bLast = b[j + 15];
+    i += (aLast <= bLast) * 16;
+    j += (bLast <= aLast) * 16;
+  }
+  return count +
+         collectMergeScalar(a + i, na - i, b + j, nb - j, out + count);
+}
+
+#endif
+
+//! Returns the position of the first element of large[pos, nl) that is not
+//! less than key, searching exponentially from pos first
+inline size_t gallop(const uint32_t* large, size_t pos, size_t nl,
+                     uint32_t key) {
+  size_t step = 1;
+  size_t low  = pos;
+  while (pos + step < nl && large[pos + step] < key) {
+    low = pos + step;
+    step <<= 1;
+  }
+  size_t high = std::min(pos + step + 1, nl);
+  return std::lower_bound(large + low, large + high, key) - large;
+}
+
+} // namespace
+
+bool isSupported(Kernel k) {
+  switch (k) {
+  case Kernel::Scalar:
+    return true;
+#ifdef GALOIS_INTERSECT_X86
+  case Kernel::AVX2:
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+  case Kernel::AVX512:
+    return __builtin_cpu_supports("avx512f") &&
+           __builtin_cpu_supports("popcnt");
+#endif
+  default:
+    return false;
+  }
+}
+
+Kernel bestKernel() {
+  static const Kernel best = isSupported(Kernel::AVX512) ? Kernel::AVX512
+                             : isSupported(Kernel::AVX2) ? Kernel::AVX2
+                                                         : Kernel::Scalar;
+  return best;
+}
+
+size_t countMerge(const uint32_t* a, size_t na, const uint32_t* b, size_t nb,
+                  Kernel k) {
+  switch (k) {
+#ifdef GALOIS_INTERSECT_X86
+  case Kernel::AVX512:
+    return countMergeAVX512(a, na, b, nb);
+  case Kernel::AVX2:
+    return countMergeAVX2(a, na, b, nb);
+#endif
+  default:
+    return countMergeScalar(a, na, b, nb);
+  }
+}
+
+size_t collectMerge(const uint32_t* a, size_t na, const uint32_t* b,
+                    size_t nb, uint32_t* out, Kernel k) {
+  switch (k) {
+#ifdef GALOIS_INTERSECT_X86
+  case Kernel::AVX512:
+    return collectMergeAVX512(a, na, b, nb, out);
+  case Kernel::AVX2:
+    return collectMergeAVX2(a, na, b, nb, out);
+#endif
+  default:
+    return collectMergeScalar(a, na, b, nb, out);
+  }
+}
+
+size_t countGallop(const uint32_t* small, size_t ns, const uint32_t* large,
+                   size_t nl) {
+  size_t pos = 0, count = 0;
+  for (size_t i = 0; i < ns && pos < nl; ++i) {
+    pos = gallop(large, pos, nl, small[i]);
+    if (pos < nl && large[pos] == small[i]) {
+      ++count;
+      ++pos;
+    }
+  }
+  return count;
+}
+
+size_t collectGallop(const uint32_t* small, size_t ns, const uint32_t* large,
+                     size_t nl, uint32_t* out) {
+  size_t pos = 0, count = 0;
+  for (size_t i = 0; i < ns && pos < nl; ++i) {
+    pos = gallop(large, pos, nl, small[i]);
+    if (pos < nl && large[pos] == small[i]) {
+      out[count++] = small[i];
+      ++pos;
+    }
+  }
+  return count;
+}
+
+size_t countBitmap(const uint64_t* bitmap, const uint32_t* b, size_t nb) {
+  size_t count = 0;
+  for (size_t i = 0; i < nb; ++i) {
+    count += (bitmap[b[i] >> 6] >> (b[i] & 63)) & 1;
+  }
+  return count;
+}
+
+size_t collectBitmap(const uint64_t* bitmap, const uint32_t* b, size_t nb,
+                     uint32_t* out) {
+  size_t count = 0;
+  for (size_t i = 0; i < nb; ++i) {
+    out[count] = b[i];
+    count += (bitmap[b[i] >> 6] >> (b[i] & 63)) & 1;
+  }
+  return count;
+}
+
+} // namespace intersection
+} // namespace galois
@@ -23,8 +23,15 @@
 #include "galois/gIO.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 // Forward declare this to avoid including PerThreadStorage.
 // We avoid this to stress that the thread Pool MUST NOT depend on PTS.
 namespace galois::substrate {
@@ -37,11 +44,83 @@ using galois::substrate::ThreadPool;
 
 thread_local ThreadPool::per_signal ThreadPool::my_box;
 
+namespace {
+
+int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+#ifdef __linux__
+void futexWait(std::atomic<int>* addr, int val) {
+  syscall(SYS_futex, reinterpret_cast<int*>(addr), FUTEX_WAIT_PRIVATE, val,
+          nullptr, nullptr, 0);
+}
+
+void futexWake(std::atomic<int>* addr) {
+  syscall(SYS_futex, reinterpret_cast<int*>(addr), FUTEX_WAKE_PRIVATE, 1,
+          nullptr, nullptr, 0);
+}
+#endif
+
+} // namespace
+
+void ThreadPool::per_signal::wakeup(bool fastmode) {
+  if (fastmode) {
+    done        = 0;
+    fastRelease = 1;
+    return;
+  }
+#ifdef __linux__
+  done = 0;
+  // only pay for the system call if the thread is already asleep
+  if (release.exchange(1) == 2)
+    futexWake(&release);
+#else
+  std::lock_guard<std::mutex> lg(m);
+  done = 0;
+  cv.notify_one();
+#endif
+}
+
+void ThreadPool::per_signal::wait(bool fastmode, unsigned spins) {
+  if (fastmode) {
+    while (!fastRelease.load(std::memory_order_relaxed)) {
+      asmPause();
+    }
+    fastRelease = 0;
+    return;
+  }
+#ifdef __linux__
+  for (unsigned i = 0; i < spins; ++i) {
+    if (release.load(std::memory_order_acquire) == 1) {
+      release.store(0, std::memory_order_relaxed);
+      return;
+    }
+    asmPause();
+  }
+  int expected = 0;
+  if (release.compare_exchange_strong(expected, 2)) {
+    do {
+      futexWait(&release, 2);
+    } while (release.load(std::memory_order_acquire) == 2);
+  }
+  release.store(0, std::memory_order_relaxed);
+#else
+  (void)spins;
+  std::unique_lock<std::mutex> lg(m);
+  cv.wait(lg, [=] { return !done; });
+#endif
+}
+
 ThreadPool::ThreadPool()
     : mi(getHWTopo().machineTopoInfo), reserved(0), masterFastmode(false),
-      running(false) {
+      spinPauses(0), running(false), launchStart(0), launchLatency(0),
+      numLaunches(0), launchLatencyTotal(0), launchLatencyMax(0) {
   signals.resize(mi.maxThreads);
   initThread(0);
+  calibrateSpin();
 
   for (unsigned i = 1; i < mi.maxThreads; ++i) {
     std::thread t(&ThreadPool::threadLoop, this, i);
@@ -53,6 +132,33 @@ ThreadPool::ThreadPool()
                      [](per_signal* p) { return !p || !p->done; })) {
     std::atomic_thread_fence(std::memory_order_seq_cst);
   }
+
+  for (unsigned i = 1; i < mi.maxThreads; ++i)
+    if (signals[i]->topo.socket != signals[i - 1]->topo.socket)
+      socketBoundaries.push_back(i);
+}
+
+void ThreadPool::calibrateSpin() {
+  // Spinning for a few tens of microseconds (e.g. GALOIS_SPIN_US=50) keeps
+  // back-to-back parallel loops from paying for a sleep and a wakeup between
+  // them. Every idle thread then keeps a core busy for that long after each
+  // loop, which only pays off for programs that run short loops back to back
+  // and takes the core from anything else on the machine, so threads sleep
+  // right away unless asked to spin. The LaunchLatency stats show what a
+  // setting gains.
+  int spinUs = 0;
+  EnvCheck("GALOIS_SPIN_US", spinUs);
+  if (spinUs <= 0) {
+    spinPauses = 0;
+    return;
+  }
+
+  const unsigned samples = 1 << 12;
+  int64_t start          = nowNs();
+  for (unsigned i = 0; i < samples; ++i)
+    asmPause();
+  double pauseNs = std::max(double(nowNs() - start) / samples, 1.0);
+  spinPauses     = unsigned(std::min(spinUs * 1000.0 / pauseNs, 1e9));
 }
 
 ThreadPool::~ThreadPool() {
@@ -134,7 +240,13 @@ void ThreadPool::threadLoop(unsigned tid) {
   bool fastmode = false;
   auto& me      = my_box;
   do {
-    me.wait(fastmode);
+    me.wait(fastmode, spinPauses);
+    int64_t latency =
+        nowNs() - launchStart.load(std::memory_order_relaxed);
+    int64_t latest  = launchLatency.load(std::memory_order_relaxed);
+    while (latency > latest &&
+           !launchLatency.compare_exchange_weak(latest, latency))
+      ;
     cascade(fastmode);
     try {
       work();
@@ -161,7 +273,7 @@ void ThreadPool::decascade() {
   auto& me = my_box;
   // nothing to wake up
   if (me.wbegin != me.wend) {
-    auto midpoint = me.wbegin + (1 + me.wend - me.wbegin) / 2;
+    auto midpoint = me.wsplit;
     auto& c1done  = signals[me.wbegin]->done;
     while (!c1done) {
       asmPause();
@@ -176,6 +288,24 @@ void ThreadPool::decascade() {
   me.done = 1;
 }
 
+unsigned ThreadPool::cascadeSplit(unsigned wbegin, unsigned wend) const {
+  unsigned midpoint = wbegin + (1 + wend - wbegin) / 2;
+  // Prefer a socket boundary, so that only O(log #sockets) wakeups cross
+  // sockets and every socket wakes up its own threads
+  auto ii = std::lower_bound(socketBoundaries.begin(), socketBoundaries.end(),
+                             midpoint);
+  unsigned best = midpoint;
+  unsigned dist = ~0U;
+  if (ii != socketBoundaries.end() && *ii < wend) {
+    best = *ii;
+    dist = *ii - midpoint;
+  }
+  if (ii != socketBoundaries.begin() && *(ii - 1) > wbegin &&
+      midpoint - *(ii - 1) < dist)
+    best = *(ii - 1);
+  return best;
+}
+
 void ThreadPool::cascade(bool fastmode) {
   auto& me = my_box;
   assert(me.wbegin <= me.wend);
@@ -185,7 +315,8 @@ void ThreadPool::cascade(bool fastmode) {
     return;
   }
 
-  auto midpoint = me.wbegin + (1 + me.wend - me.wbegin) / 2;
+  auto midpoint = cascadeSplit(me.wbegin, me.wend);
+  me.wsplit     = midpoint;
 
   auto child1    = signals[me.wbegin];
   child1->wbegin = me.wbegin + 1;
@@ -212,6 +343,8 @@ void ThreadPool::runInternal(unsigned num) {
   me.wend   = num;
 
   assert(!masterFastmode || masterFastmode == num);
+  launchLatency = 0;
+  launchStart.store(nowNs(), std::memory_order_relaxed);
   // launch threads
   cascade(masterFastmode);
   // Do master thread work
@@ -223,6 +356,12 @@ void ThreadPool::runInternal(unsigned num) {
   }
   // wait for children
   decascade();
+  if (num > 1) {
+    uint64_t latency = launchLatency;
+    ++numLaunches;
+    launchLatencyTotal += latency;
+    launchLatencyMax = std::max(launchLatencyMax, latency);
+  }
   // Clean up
   work    = nullptr;
   running = false;
@@ -0,0 +1,117 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/GraphColoring.h"
+#include "galois/graphs/LCGraph.h"
+
+#include <vector>
+
+typedef galois::graphs::LC_CSR_Graph<unsigned, int>::with_no_lockable<
+    true>::type Graph;
+typedef Graph::GraphNode GNode;
+
+// A ring where each node is also connected to a pseudo-random other node,
+// with every edge in both directions
+static void makeGraph(Graph& graph, uint32_t numNodes) {
+  std::vector<std::vector<uint32_t>> edges(numNodes);
+  auto connect = [&](uint32_t a, uint32_t b) {
+    if (a == b)
+      return;
+    edges[a].push_back(b);
+    edges[b].push_back(a);
+  };
+  for (uint32_t n = 0; n < numNodes; ++n) {
+    connect(n, (n + 1) % numNodes);
+    connect(n, (n * 7919u + 13) % numNodes);
+  }
+  std::vector<uint64_t> prefixSum(numNodes);
+  std::vector<std::vector<int>> data(numNodes);
+  uint64_t numEdges = 0;
+  for (uint32_t n = 0; n < numNodes; ++n) {
+    data[n].resize(edges[n].size());
+    numEdges += edges[n].size();
+    prefixSum[n] = numEdges;
+  }
+  graph.constructFrom(numNodes, numEdges, prefixSum, edges, data);
+}
+
+static void checkColoring(Graph& graph,
+                          const galois::GraphColoring<Graph>& coloring) {
+  for (GNode n : graph) {
+    GALOIS_ASSERT(coloring.color(n) < coloring.numColors(), "bad color");
+    for (auto e : graph.edges(n)) {
+      GNode m = graph.getEdgeDst(e);
+      GALOIS_ASSERT(m == n || coloring.color(m) != coloring.color(n),
+                    "neighbors ", n, " and ", m, " have the same color");
+      if (coloring.distance() < 2)
+        continue;
+      for (auto f : graph.edges(m)) {
+        GNode k = graph.getEdgeDst(f);
+        GALOIS_ASSERT(k == n || coloring.color(k) != coloring.color(n),
+                      "nodes ", n, " and ", k, " two hops apart have the same "
+                      "color");
+      }
+    }
+  }
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  galois::setActiveThreads(4);
+
+  const uint32_t numNodes = 10000;
+  Graph graph;
+  makeGraph(graph, numNodes);
+
+  galois::GraphColoring<Graph> coloring1(graph, 1);
+  checkColoring(graph, coloring1);
+  galois::GraphColoring<Graph> coloring(graph);
+  checkColoring(graph, coloring);
+
+  // Every node adds to itself and its neighbors without locks, which is only
+  // safe if nodes of the same color run at the same time. The first visit
+  // of a node pushes it twice, so it appears twice in the next round.
+  for (GNode n : graph)
+    graph.getData(n) = 0;
+  std::vector<unsigned> visits(numNodes);
+  galois::for_each(
+      galois::iterate(graph),
+      [&](GNode n, auto& ctx) {
+        ++graph.getData(n);
+        for (auto e : graph.edges(n))
+          ++graph.getData(graph.getEdgeDst(e));
+        if (++visits[n] == 1) {
+          ctx.push(n);
+          ctx.push(n);
+        }
+      },
+      galois::wl<galois::worklists::Colored<>>(coloring),
+      galois::loopname("colored"));
+
+  for (GNode n : graph) {
+    GALOIS_ASSERT(visits[n] == 3, "node ", n, " visited ", visits[n],
+                  " times");
+    unsigned expected = 3 * (1 + std::distance(graph.edge_begin(n),
+                                               graph.edge_end(n)));
+    GALOIS_ASSERT(graph.getData(n) == expected, "wrong value at node ", n);
+  }
+
+  return 0;
+}
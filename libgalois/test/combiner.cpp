@@ -0,0 +1,102 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/AtomicHelpers.h"
+#include "galois/UpdateCombiner.h"
+
+#include <atomic>
+#include <vector>
+
+// Each round, item x adds x to destination x % numDsts. Rounds with fewer
+// items than destinations are sparse enough to be applied directly.
+void checkSum(unsigned numDsts) {
+  std::vector<std::atomic<uint64_t>> sums(numDsts);
+  std::vector<std::atomic<unsigned>> applies(numDsts);
+  auto combiner = galois::make_update_combiner<uint64_t>(
+      numDsts, std::plus<uint64_t>(), [&](size_t dst, uint64_t v) {
+        sums[dst] += v;
+        ++applies[dst];
+      });
+
+  std::vector<uint64_t> expected(numDsts);
+  for (unsigned numItems : {8 * numDsts, numDsts / 32, 4 * numDsts, 0u}) {
+    bool direct = combiner.isDirect();
+    for (auto& a : applies)
+      a = 0;
+
+    galois::do_all(galois::iterate(0u, numItems), [&](unsigned x) {
+      combiner.push(x % numDsts, x);
+    });
+    combiner.flush();
+
+    for (unsigned x = 0; x < numItems; ++x)
+      expected[x % numDsts] += x;
+    for (unsigned d = 0; d < numDsts; ++d) {
+      GALOIS_ASSERT(sums[d] == expected[d], "destination ", d, " got ",
+                    sums[d], " instead of ", expected[d]);
+      unsigned numPushes = numItems / numDsts + (d < numItems % numDsts);
+      if (!direct)
+        GALOIS_ASSERT(applies[d] == (numPushes > 0), "destination ", d,
+                      " applied ", applies[d], " times after combining");
+      else
+        GALOIS_ASSERT(applies[d] == numPushes, "destination ", d, " applied ",
+                      applies[d], " times");
+    }
+    GALOIS_ASSERT(combiner.isDirect() == (numItems < numDsts / 16.0),
+                  "wrong mode after ", numItems, " updates");
+  }
+}
+
+void checkMin(unsigned numDsts) {
+  std::vector<std::atomic<unsigned>> labels(numDsts);
+  for (auto& l : labels)
+    l = ~0u;
+  auto combiner = galois::make_update_combiner<unsigned>(
+      numDsts, galois::gmin<unsigned>(), [&](size_t dst, unsigned v) {
+        galois::atomicMin(labels[dst], v);
+      });
+
+  unsigned numItems = 16 * numDsts;
+  galois::do_all(galois::iterate(0u, numItems), [&](unsigned x) {
+    combiner.push((x * 7919u) % numDsts, numItems - x);
+  });
+  combiner.flush();
+
+  std::vector<unsigned> expected(numDsts, ~0u);
+  for (unsigned x = 0; x < numItems; ++x) {
+    unsigned& e = expected[(x * 7919u) % numDsts];
+    e           = std::min(e, numItems - x);
+  }
+  for (unsigned d = 0; d < numDsts; ++d)
+    GALOIS_ASSERT(labels[d] == expected[d], "destination ", d, " got ",
+                  labels[d], " instead of ", expected[d]);
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  galois::setActiveThreads(4);
+
+  for (unsigned numDsts : {1u, 100u, 1000u, 100000u}) {
+    checkSum(numDsts);
+    checkMin(numDsts);
+  }
+
+  return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/runtime/Context.h"
+#include "galois/runtime/Executor_ForEach.h"
+
+#include <cstdlib>
+#include <vector>
+
+using Manager = galois::runtime::ContentionManager<false>;
+
+//! Runs a window of 256 iterations of which the first numAborts abort, and
+//! returns how many of the aborts asked for deferral
+unsigned window(Manager& m, unsigned numAborts) {
+  unsigned deferred = 0;
+  for (unsigned i = 0; i < 256; ++i) {
+    if (i < numAborts)
+      deferred += m.abort();
+    else
+      m.commit();
+  }
+  return deferred;
+}
+
+// Levels only change at the end of a window: up from one abort in four,
+// down below one in 16. An abort that ends a window already gets the new
+// level.
+void checkLevels() {
+  Manager m(nullptr, false);
+  GALOIS_ASSERT(m.level() == Manager::NONE);
+  GALOIS_ASSERT(window(m, 63) == 0 && m.level() == Manager::NONE);
+  GALOIS_ASSERT(window(m, 64) == 0 && m.level() == Manager::BACKOFF);
+  GALOIS_ASSERT(window(m, 256) == 1 && m.level() == Manager::DEFER);
+  GALOIS_ASSERT(window(m, 256) == 256 && m.level() == Manager::DEFER);
+  GALOIS_ASSERT(window(m, 16) == 16 && m.level() == Manager::DEFER);
+  GALOIS_ASSERT(window(m, 15) == 15 && m.level() == Manager::BACKOFF);
+  GALOIS_ASSERT(window(m, 0) == 0 && m.level() == Manager::NONE);
+  GALOIS_ASSERT(window(m, 0) == 0 && m.level() == Manager::NONE);
+}
+
+// Item 0 aborts far more often than it takes to reach DEFER, so it ends up
+// in the serial tail, which only runs once all other items are done. Loops
+// on one thread do not detect conflicts.
+void checkSerialTail(unsigned numItems) {
+  const unsigned hotAborts = 2000;
+  std::vector<unsigned> attempts(numItems);
+  std::vector<unsigned> order(numItems);
+  std::atomic<unsigned> numDone(0);
+
+  galois::for_each(galois::iterate(0u, numItems),
+                   [&](unsigned x, auto&) {
+                     if (++attempts[x] <= (x ? 0 : hotAborts))
+                       galois::runtime::signalConflict();
+                     order[x] = numDone++;
+                   },
+                   galois::contention_manager());
+
+  GALOIS_ASSERT(attempts[0] == hotAborts + 1);
+  GALOIS_ASSERT(order[0] == numItems - 1, "item 0 committed ", order[0],
+                "th, before the serial tail");
+  for (unsigned x = 1; x < numItems; ++x)
+    GALOIS_ASSERT(attempts[x] == 1, "item ", x, " ran ", attempts[x],
+                  " times");
+}
+
+// Every item holds one of a few cells while it does some work, so with
+// several threads most iterations abort unless the executor backs off or
+// defers the conflicting items. Items of the first quarter push one more
+// item each.
+struct Cells {
+  std::vector<galois::runtime::Lockable> locks;
+  std::vector<uint64_t> values;
+  std::vector<unsigned> visits;
+  unsigned numItems;
+
+  Cells(unsigned numCells, unsigned n)
+      : locks(numCells), values(numCells), visits(n + n / 4), numItems(n) {}
+
+  void update(unsigned x, galois::UserContext<unsigned>& ctx) {
+    unsigned c = x % values.size();
+    galois::runtime::acquire(&locks[c], galois::MethodFlag::WRITE);
+    uint64_t v = values[c];
+    for (unsigned i = 0; i < 64; ++i)
+      v = v * 31 + i;
+    values[c] = v;
+    ++visits[x];
+    if (x < numItems / 4)
+      ctx.push(x + numItems);
+  }
+};
+
+template <typename... Args>
+void checkContended(unsigned numCells, unsigned numItems, Args&&... args) {
+  Cells cells(numCells, numItems);
+  galois::for_each(
+      galois::iterate(0u, numItems),
+      [&](unsigned x, auto& ctx) { cells.update(x, ctx); },
+      std::forward<Args>(args)...);
+
+  for (unsigned x = 0; x < cells.visits.size(); ++x)
+    GALOIS_ASSERT(cells.visits[x] == 1, "item ", x, " ran ", cells.visits[x],
+                  " times");
+}
+
+int main(int argc, char** argv) {
+  galois::SharedMemSys Galois_runtime;
+
+  unsigned numItems   = argc > 1 ? atoi(argv[1]) : 1 << 18;
+  unsigned numCells   = argc > 2 ? atoi(argv[2]) : 2;
+  unsigned numThreads = argc > 3 ? atoi(argv[3]) : 4;
+  galois::setActiveThreads(numThreads);
+
+  checkLevels();
+  if (galois::getActiveThreads() > 1)
+    checkSerialTail(1024);
+
+  checkContended(numCells, numItems, galois::loopname("default"));
+  checkContended(numCells, numItems, galois::loopname("managed"),
+                 galois::contention_manager());
+
+  return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/runtime/Context.h"
+#include "galois/Timer.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Every item updates two cells in a way that depends on the order of the
+// updates, so the cells end up the same only if conflicting items commit in
+// the same order. Items of the first quarter push one more item each.
+struct Cells {
+  std::vector<galois::runtime::Lockable> locks;
+  std::vector<uint64_t> values;
+  unsigned numItems;
+
+  Cells(unsigned numCells, unsigned n)
+      : locks(numCells), values(numCells), numItems(n) {}
+
+  unsigned first(unsigned x) const { return x % values.size(); }
+  unsigned second(unsigned x) const { return (x * 7919u) % values.size(); }
+
+  void acquire(unsigned c, galois::MethodFlag m) {
+    galois::runtime::acquire(&locks[c], m);
+  }
+
+  template <typename C>
+  void update(unsigned x, C& ctx) {
+    acquire(first(x), galois::MethodFlag::WRITE);
+    acquire(second(x), galois::MethodFlag::WRITE);
+    ctx.cautiousPoint();
+    values[first(x)]  = values[first(x)] * 31 + x;
+    values[second(x)] = values[second(x)] * 17 + x;
+    if (x < numItems / 4)
+      ctx.push(x + numItems);
+  }
+
+  // Only reads the first cell
+  template <typename C>
+  void updateReading(unsigned x, C& ctx) {
+    acquire(first(x), galois::MethodFlag::READ);
+    acquire(second(x), galois::MethodFlag::WRITE);
+    ctx.cautiousPoint();
+    values[second(x)] = values[second(x)] * 31 + values[first(x)] + x;
+    if (x < numItems / 4)
+      ctx.push(x + numItems);
+  }
+};
+
+struct LocalState {
+  unsigned visits;
+  LocalState() : visits(0) {}
+};
+
+template <typename F, typename... Args>
+std::vector<uint64_t> run(unsigned numCells, unsigned numItems, F fn,
+                          Args&&... args) {
+  Cells cells(numCells, numItems);
+  galois::for_each(
+      galois::iterate(0u, numItems),
+      [&](unsigned x, auto& ctx) { fn(cells, x, ctx); },
+      std::forward<Args>(args)...);
+  return cells.values;
+}
+
+template <typename F, typename... Args>
+void check(const char* name, unsigned numCells, unsigned numItems, F fn,
+           Args&&... args) {
+  unsigned maxThreads = galois::getActiveThreads();
+  std::vector<uint64_t> expected;
+  for (unsigned t = 1; t <= maxThreads; t *= 2) {
+    galois::setActiveThreads(t);
+    for (unsigned rep = 0; rep < 2; ++rep) {
+      auto values = run(numCells, numItems, fn, args...);
+      if (expected.empty())
+        expected = values;
+      GALOIS_ASSERT(values == expected, name, ": different result with ", t,
+                    " threads");
+    }
+  }
+  galois::setActiveThreads(maxThreads);
+}
+
+template <typename F, typename... Args>
+unsigned long timeRun(unsigned numCells, unsigned numItems, F fn,
+                      Args&&... args) {
+  galois::Timer t;
+  t.start();
+  run(numCells, numItems, fn, std::forward<Args>(args)...);
+  t.stop();
+  return t.get();
+}
+
+int main(int argc, char** argv) {
+  galois::SharedMemSys Galois_runtime;
+
+  unsigned numItems   = argc > 1 ? atoi(argv[1]) : 1 << 15;
+  unsigned numCells   = argc > 2 ? atoi(argv[2]) : 1 << 12;
+  unsigned numThreads = argc > 3 ? atoi(argv[3]) : 4;
+  galois::setActiveThreads(numThreads);
+
+  using DWL = galois::worklists::Deterministic<>;
+  auto update = [](Cells& c, unsigned x, auto& ctx) { c.update(x, ctx); };
+  auto updateReading = [](Cells& c, unsigned x, auto& ctx) {
+    c.updateReading(x, ctx);
+  };
+  auto updateWithState = [](Cells& c, unsigned x, auto& ctx) {
+    LocalState* s = ctx.template getLocalState<LocalState>();
+    if (ctx.isFirstPass())
+      new (s) LocalState();
+    ++s->visits;
+    c.update(x, ctx);
+  };
+
+  check("write", numCells, numItems, update, galois::wl<DWL>());
+  check("write, pipelined", numCells, numItems, update, galois::wl<DWL>(),
+        galois::det_pipeline());
+  check("read", numCells, numItems, updateReading, galois::wl<DWL>(),
+        galois::intent_to_read());
+  check("local state", numCells, numItems, updateWithState, galois::wl<DWL>(),
+        galois::local_state<LocalState>(), galois::per_iter_alloc());
+  check("local state, pipelined", numCells, numItems, updateWithState,
+        galois::wl<DWL>(), galois::local_state<LocalState>(),
+        galois::per_iter_alloc(), galois::det_pipeline());
+
+  // Cost of deterministic scheduling compared to the default worklist
+  std::cout << "threads: " << galois::getActiveThreads()
+            << " items: " << numItems << " cells: " << numCells << "\n";
+  std::cout << "nondeterministic: " << timeRun(numCells, numItems, update)
+            << " ms\n";
+  std::cout << "deterministic: "
+            << timeRun(numCells, numItems, update, galois::wl<DWL>())
+            << " ms\n";
+  std::cout << "deterministic, pipelined: "
+            << timeRun(numCells, numItems, update, galois::wl<DWL>(),
+                       galois::det_pipeline())
+            << " ms\n";
+  std::cout << "deterministic, intent to read: "
+            << timeRun(numCells, numItems, updateReading, galois::wl<DWL>(),
+                       galois::intent_to_read())
+            << " ms\n";
+
+  return 0;
+}
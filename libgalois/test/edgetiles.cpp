@@ -0,0 +1,83 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/EdgeTiles.h"
+#include "galois/graphs/LCGraph.h"
+
+#include <atomic>
+#include <vector>
+
+typedef galois::graphs::LC_CSR_Graph<int, int> Graph;
+
+// A star whose hub is connected to all other nodes, plus a path through the
+// other nodes
+static void makeGraph(Graph& graph, uint32_t numNodes) {
+  std::vector<uint64_t> prefixSum(numNodes);
+  std::vector<std::vector<uint32_t>> edges(numNodes);
+  std::vector<std::vector<int>> data(numNodes);
+  uint64_t numEdges = 0;
+  for (uint32_t n = 0; n < numNodes; ++n) {
+    if (n == 0) {
+      for (uint32_t m = 1; m < numNodes; ++m)
+        edges[n].push_back(m);
+    } else if (n + 1 < numNodes) {
+      edges[n].push_back(n + 1);
+    }
+    data[n].resize(edges[n].size());
+    numEdges += edges[n].size();
+    prefixSum[n] = numEdges;
+  }
+  graph.constructFrom(numNodes, numEdges, prefixSum, edges, data);
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  galois::setActiveThreads(4);
+
+  const uint32_t numNodes = 10000;
+  Graph graph;
+  makeGraph(graph, numNodes);
+
+  for (unsigned tileSize : {0u, 1u, 100u}) {
+    size_t maxSize = tileSize ? tileSize : galois::edgeTileSize(graph);
+    std::vector<std::atomic<unsigned>> visits(graph.sizeEdges());
+    std::atomic<size_t> numTiles(0);
+    galois::do_all(
+        galois::iterate_edge_tiles(graph),
+        [&](const galois::EdgeTile<Graph>& tile) {
+          GALOIS_ASSERT(tile.beg < tile.end, "empty tile");
+          GALOIS_ASSERT(size_t(tile.end - tile.beg) <= maxSize,
+                        "tile too large");
+          GALOIS_ASSERT(*graph.edge_begin(tile.src) <= *tile.beg &&
+                            *tile.end <= *graph.edge_end(tile.src),
+                        "tile outside of its source");
+          for (auto ii = tile.beg; ii != tile.end; ++ii)
+            ++visits[*ii];
+          ++numTiles;
+        },
+        galois::edge_tile<>(tileSize), galois::steal());
+    for (auto& v : visits)
+      GALOIS_ASSERT(v == 1, "edge not in exactly one tile");
+    size_t hubTiles = (numNodes - 1 + maxSize - 1) / maxSize;
+    GALOIS_ASSERT(numTiles == hubTiles + numNodes - 2, "wrong number of tiles");
+  }
+
+  return 0;
+}
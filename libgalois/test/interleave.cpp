@@ -0,0 +1,75 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+
+#include <atomic>
+#include <vector>
+
+// Every item must be prefetched and run exactly once, whether or not the loop
+// steals and however many items the worklist has when the ring fills up
+template <typename... Args>
+void checkDoAll(unsigned numItems, Args&&... args) {
+  std::vector<std::atomic<unsigned>> prefetched(numItems);
+  std::vector<std::atomic<unsigned>> visits(numItems);
+  galois::do_all(
+      galois::iterate(0u, numItems), [&](unsigned x) { ++visits[x]; },
+      galois::interleave<4>([&](unsigned x) { ++prefetched[x]; }),
+      std::forward<Args>(args)...);
+  for (unsigned x = 0; x < numItems; ++x) {
+    GALOIS_ASSERT(prefetched[x] == 1, "item ", x, " prefetched ",
+                  prefetched[x], " times");
+    GALOIS_ASSERT(visits[x] == 1, "item ", x, " ran ", visits[x], " times");
+  }
+}
+
+// Items below half push the item numItems above them
+void checkForEach(unsigned numItems) {
+  std::vector<std::atomic<unsigned>> prefetched(2 * numItems);
+  std::vector<std::atomic<unsigned>> visits(2 * numItems);
+  galois::for_each(
+      galois::iterate(0u, numItems),
+      [&](unsigned x, auto& ctx) {
+        ++visits[x];
+        if (x < numItems / 2)
+          ctx.push(x + numItems);
+      },
+      galois::interleave<4>([&](unsigned x) { ++prefetched[x]; }),
+      galois::disable_conflict_detection());
+  for (unsigned x = 0; x < 2 * numItems; ++x) {
+    unsigned expected = x < numItems || x - numItems < numItems / 2;
+    GALOIS_ASSERT(prefetched[x] == expected, "item ", x, " prefetched ",
+                  prefetched[x], " times");
+    GALOIS_ASSERT(visits[x] == expected, "item ", x, " ran ", visits[x],
+                  " times");
+  }
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  galois::setActiveThreads(4);
+
+  for (unsigned numItems : {0u, 3u, 4u, 5u, 1000u}) {
+    checkDoAll(numItems);
+    checkDoAll(numItems, galois::steal(), galois::chunk_size<2>());
+    checkForEach(numItems);
+  }
+
+  return 0;
+}
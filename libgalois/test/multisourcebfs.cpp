@@ -0,0 +1,131 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/MultiSourceBFS.h"
+#include "galois/graphs/LCGraph.h"
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+typedef galois::graphs::LC_CSR_Graph<int, int> Graph;
+typedef Graph::GraphNode GNode;
+
+static const unsigned UNREACHED = ~0u;
+
+// A directed random graph, with some nodes that have no edges
+static void makeGraph(Graph& graph, uint32_t numNodes, unsigned degree) {
+  std::vector<uint64_t> prefixSum(numNodes);
+  std::vector<std::vector<uint32_t>> edges(numNodes);
+  std::vector<std::vector<int>> data(numNodes);
+  uint64_t numEdges = 0;
+  uint64_t x        = 1;
+  for (uint32_t n = 0; n < numNodes; ++n) {
+    if (n % 7 != 3) {
+      for (unsigned i = 0; i < degree; ++i) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        edges[n].push_back((x >> 33) % numNodes);
+      }
+    }
+    data[n].resize(edges[n].size());
+    numEdges += edges[n].size();
+    prefixSum[n] = numEdges;
+  }
+  graph.constructFrom(numNodes, numEdges, prefixSum, edges, data);
+}
+
+static std::vector<unsigned> bfs(Graph& graph, GNode source) {
+  std::vector<unsigned> dist(graph.size(), UNREACHED);
+  std::deque<GNode> queue{source};
+  dist[source] = 0;
+  while (!queue.empty()) {
+    GNode n = queue.front();
+    queue.pop_front();
+    for (auto e : graph.edges(n)) {
+      GNode dst = graph.getEdgeDst(e);
+      if (dist[dst] == UNREACHED) {
+        dist[dst] = dist[n] + 1;
+        queue.push_back(dst);
+      }
+    }
+  }
+  return dist;
+}
+
+// Each source must reach each node once, at the level of its own BFS, and
+// the edge callbacks must be the edges into nodes newly reached by a source
+template <unsigned Words>
+void check(Graph& graph, galois::MultiSourceBFS<Graph, Words>& msbfs,
+           const std::vector<GNode>& sources) {
+  typedef typename galois::MultiSourceBFS<Graph, Words>::Sources Sources;
+  std::vector<std::atomic<unsigned>> edges(sources.size());
+  msbfs.run(sources, [&](GNode, GNode, const Sources& fresh) {
+    fresh.forEach([&](unsigned s) { ++edges[s]; });
+  });
+
+  for (unsigned s = 0; s < sources.size(); ++s) {
+    std::vector<unsigned> dist = bfs(graph, sources[s]);
+    std::vector<unsigned> level(graph.size(), UNREACHED);
+    for (size_t d = 0; d < msbfs.numLevels(); ++d) {
+      for (auto& v : msbfs.level(d)) {
+        if (!v.sources.test(s))
+          continue;
+        GALOIS_ASSERT(level[v.node] == UNREACHED, "source ", s,
+                      " reached node ", v.node, " twice");
+        level[v.node] = d;
+      }
+    }
+
+    unsigned expectedEdges = 0;
+    for (GNode n : graph) {
+      GALOIS_ASSERT(level[n] == dist[n], "source ", s, " reached node ", n,
+                    " at level ", level[n], " instead of ", dist[n]);
+      GALOIS_ASSERT(msbfs.reachedBy(n).test(s) == (dist[n] != UNREACHED),
+                    "wrong sources of node ", n);
+      for (auto e : graph.edges(n))
+        if (dist[n] != UNREACHED && dist[graph.getEdgeDst(e)] == dist[n] + 1)
+          ++expectedEdges;
+    }
+    GALOIS_ASSERT(edges[s] == expectedEdges, "source ", s, " got ", edges[s],
+                  " edges instead of ", expectedEdges);
+  }
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  galois::setActiveThreads(4);
+
+  Graph graph;
+  makeGraph(graph, 2000, 3);
+
+  galois::MultiSourceBFS<Graph, 2> msbfs(graph);
+  std::vector<GNode> sources;
+  for (unsigned i = 0; i < 128; ++i)
+    sources.push_back((i * 131) % graph.size());
+  check(graph, msbfs, sources);
+  // fewer sources, some of them twice, after a larger run
+  check(graph, msbfs, std::vector<GNode>{5, 3, 5, 17});
+  check(graph, msbfs, std::vector<GNode>{});
+
+  galois::MultiSourceBFS<Graph, 1> small(graph);
+  check(graph, small, std::vector<GNode>{0, 1, 2});
+
+  return 0;
+}
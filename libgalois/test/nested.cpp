@@ -0,0 +1,83 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+
+#include <atomic>
+#include <vector>
+
+// Few items with large inner ranges: threads without items of their own can
+// only help through the nested loops.
+static const unsigned numHubs = 3;
+static const size_t hubSize   = 1 << 18;
+
+static size_t fib(size_t n) {
+  if (n < 2)
+    return n;
+  size_t a, b;
+  galois::parallel_invoke([&] { a = fib(n - 1); }, [&] { b = fib(n - 2); });
+  return a + b;
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  galois::setActiveThreads(4);
+
+  std::vector<size_t> expected(numHubs);
+  for (unsigned h = 0; h < numHubs; ++h)
+    expected[h] = (h + 1) * hubSize * (hubSize - 1) / 2;
+
+  std::vector<std::atomic<size_t>> sums(numHubs);
+  galois::for_each(
+      galois::iterate(0u, numHubs),
+      [&](unsigned h, galois::UserContext<unsigned>&) {
+        galois::do_all(galois::iterate(size_t(0), hubSize),
+                       [&](size_t i) { sums[h] += (h + 1) * i; });
+      },
+      galois::loopname("ForEachNested"));
+  for (unsigned h = 0; h < numHubs; ++h)
+    GALOIS_ASSERT(sums[h] == expected[h], "wrong sum in for_each");
+
+  for (auto& s : sums)
+    s = 0;
+  galois::do_all(
+      galois::iterate(0u, numHubs),
+      [&](unsigned h) {
+        galois::do_all(galois::iterate(size_t(0), hubSize),
+                       [&](size_t i) { sums[h] += (h + 1) * i; });
+      },
+      galois::steal(), galois::loopname("DoAllNested"));
+  for (unsigned h = 0; h < numHubs; ++h)
+    GALOIS_ASSERT(sums[h] == expected[h], "wrong sum in do_all");
+
+  std::atomic<size_t> inner(0);
+  galois::on_each([&](unsigned tid, unsigned) {
+    if (tid == 0)
+      galois::do_all(galois::iterate(size_t(0), hubSize),
+                     [&](size_t) { ++inner; });
+  });
+  GALOIS_ASSERT(inner == hubSize, "wrong count in on_each");
+
+  size_t f = 0;
+  galois::do_all(galois::iterate(0u, 1u), [&](unsigned) { f = fib(20); });
+  GALOIS_ASSERT(f == 6765, "wrong fib");
+  GALOIS_ASSERT(fib(15) == 610, "wrong fib outside of loops");
+
+  return 0;
+}
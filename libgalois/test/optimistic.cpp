@@ -0,0 +1,150 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/runtime/Context.h"
+
+#include <vector>
+
+using galois::MethodFlag;
+using galois::runtime::Lockable;
+using galois::runtime::OptimisticRuntimeContext;
+
+//! Whether fn signals a conflict
+template <typename F>
+bool conflicts(F fn) {
+#if defined(GALOIS_USE_LONGJMP_ABORT)
+  if (setjmp(galois::runtime::execFrame))
+    return true;
+  fn();
+  return false;
+#elif defined(GALOIS_USE_EXCEPTION_ABORT)
+  try {
+    fn();
+  } catch (galois::runtime::ConflictFlag) {
+    return true;
+  }
+  return false;
+#endif
+}
+
+void acquire(OptimisticRuntimeContext& ctx, Lockable& l, MethodFlag m) {
+  galois::runtime::setThreadContext(&ctx);
+  galois::runtime::acquire(&l, m);
+}
+
+bool validates(OptimisticRuntimeContext& ctx) {
+  bool c = conflicts([&] { ctx.validate(); });
+  GALOIS_ASSERT(c == ctx.abortedOnRead());
+  return !c;
+}
+
+// Runs two iterations by hand, interleaving their steps
+void checkInterleavings() {
+  OptimisticRuntimeContext ctx1, ctx2;
+  Lockable x, y;
+
+  // A read goes stale when a writer commits after it
+  ctx1.startIteration();
+  ctx2.startIteration();
+  acquire(ctx1, x, MethodFlag::READ);
+  acquire(ctx2, x, MethodFlag::WRITE);
+  ctx2.commitIteration();
+  GALOIS_ASSERT(!validates(ctx1), "stale read validated");
+  ctx1.cancelIteration();
+
+  // A read of a lockable held by a writer aborts right away
+  ctx1.startIteration();
+  ctx2.startIteration();
+  acquire(ctx2, x, MethodFlag::WRITE);
+  GALOIS_ASSERT(conflicts([&] { acquire(ctx1, x, MethodFlag::READ); }));
+  GALOIS_ASSERT(ctx1.abortedOnRead());
+  ctx1.cancelIteration();
+  ctx2.commitIteration();
+
+  // Locking a read after validation does not make it a write
+  ctx1.startIteration();
+  ctx2.startIteration();
+  acquire(ctx2, y, MethodFlag::READ);
+  GALOIS_ASSERT(validates(ctx1));
+  acquire(ctx1, y, MethodFlag::READ);
+  ctx1.commitIteration();
+  GALOIS_ASSERT(validates(ctx2), "read-only commit changed a version");
+  ctx2.commitIteration();
+
+  // Writing a lockable locked by validate() does
+  ctx1.startIteration();
+  ctx2.startIteration();
+  acquire(ctx2, x, MethodFlag::READ);
+  acquire(ctx1, x, MethodFlag::READ);
+  GALOIS_ASSERT(validates(ctx1));
+  acquire(ctx1, x, MethodFlag::WRITE);
+  ctx1.commitIteration();
+  GALOIS_ASSERT(!validates(ctx2), "write after validation went unnoticed");
+  ctx2.cancelIteration();
+
+  galois::runtime::setThreadContext(nullptr);
+}
+
+// Writers increment both cells of a pair while readers record their
+// difference, which is zero unless a reader saw the pair in the middle of an
+// update and still committed
+void checkLoop() {
+  const unsigned numPairs = 64;
+  const unsigned numItems = 1 << 16;
+  std::vector<Lockable> locks(2 * numPairs);
+  std::vector<uint64_t> values(2 * numPairs);
+  std::vector<uint64_t> diffs(numItems);
+
+  galois::for_each(
+      galois::iterate(0u, numItems),
+      [&](unsigned x, auto& ctx) {
+        unsigned p = 2 * (x / 4 % numPairs);
+        if (x % 4 == 0) {
+          galois::runtime::acquire(&locks[p], MethodFlag::WRITE);
+          galois::runtime::acquire(&locks[p + 1], MethodFlag::WRITE);
+          ctx.cautiousPoint();
+          values[p] += 1;
+          values[p + 1] += 1;
+        } else {
+          galois::runtime::acquire(&locks[p], MethodFlag::READ);
+          uint64_t first = values[p];
+          galois::runtime::acquire(&locks[p + 1], MethodFlag::READ);
+          uint64_t second = values[p + 1];
+          ctx.cautiousPoint();
+          diffs[x] = first - second;
+        }
+      },
+      galois::optimistic_reads());
+
+  for (unsigned c = 0; c < values.size(); ++c)
+    GALOIS_ASSERT(values[c] == numItems / numPairs / 4, "lost update");
+  for (unsigned x = 0; x < numItems; ++x)
+    GALOIS_ASSERT(!diffs[x], "inconsistent read by ", x);
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  checkInterleavings();
+
+  galois::setActiveThreads(4);
+  checkLoop();
+
+  return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/runtime/Context.h"
+#include "galois/runtime/Executor_Ordered.h"
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <vector>
+
+// Items touch the lock of their bucket. Items of the same bucket must run in
+// priority order; items of different buckets may run in any order.
+struct Buckets {
+  static const unsigned numBuckets = 16;
+  std::vector<galois::runtime::Lockable> locks;
+  std::vector<std::vector<int>> runs;
+
+  Buckets() : locks(numBuckets), runs(numBuckets) {}
+
+  void acquire(int x) {
+    galois::runtime::acquire(&locks[x % numBuckets],
+                             galois::MethodFlag::WRITE);
+  }
+
+  bool check() const {
+    for (auto& r : runs)
+      if (!std::is_sorted(r.begin(), r.end()))
+        return false;
+    return true;
+  }
+};
+
+// The earliest item of a window is forced to run even if it fails the
+// stability test, so it must win every lock it wants, including against an
+// item of equal priority whose context happens to sit at a lower address.
+void checkEqualPriorityLocks() {
+  typedef galois::runtime::internal::OrderedContext<int, std::less<int>>
+      Context;
+  std::less<int> cmp;
+  galois::runtime::Lockable lock;
+  // earliest is the first item of thread 0 but comes after other in memory
+  std::deque<Context> contexts;
+  contexts.emplace_back(7, cmp, 1, 0);
+  contexts.emplace_back(7, cmp, 0, 0);
+  Context& other    = contexts[0];
+  Context& earliest = contexts[1];
+  GALOIS_ASSERT(earliest.precedes(&other) && !other.precedes(&earliest),
+                "equal priorities are not ordered by thread");
+
+  for (Context* ctx : {&earliest, &other}) {
+    ctx->startIteration();
+    galois::runtime::setThreadContext(ctx);
+    galois::runtime::acquire(&lock, galois::MethodFlag::WRITE);
+  }
+  galois::runtime::setThreadContext(0);
+  GALOIS_ASSERT(earliest.isReady(), "earliest item lost a lock");
+  GALOIS_ASSERT(!other.isReady(), "later item kept a contended lock");
+  for (Context& ctx : contexts)
+    ctx.commitIteration();
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  checkEqualPriorityLocks();
+  galois::setActiveThreads(4);
+
+  const int num = 10000;
+  std::vector<int> items(num);
+  for (int i = 0; i < num; ++i)
+    items[i] = (i * 7919) % num;
+
+  Buckets stable;
+  galois::for_each_ordered(
+      items.begin(), items.end(), std::less<int>(),
+      [&](int x) { stable.acquire(x); },
+      [&](int x, galois::UserContext<int>&) {
+        stable.runs[x % Buckets::numBuckets].push_back(x);
+      },
+      "stable");
+  size_t total = 0;
+  for (auto& r : stable.runs)
+    total += r.size();
+  GALOIS_ASSERT(total == num, "missing items");
+  GALOIS_ASSERT(stable.check(), "items of a bucket ran out of order");
+
+  // No item passes the stability test, so only the earliest item of every
+  // window may run and pushed items must run in order with the others
+  Buckets unstable;
+  std::vector<int> order;
+  galois::for_each_ordered(
+      items.begin(), items.begin() + 200, std::less<int>(),
+      [&](int x) { unstable.acquire(x); },
+      [&](int x, galois::UserContext<int>& ctx) {
+        order.push_back(x);
+        if (x % 2 == 0)
+          ctx.push(x + 101);
+      },
+      [](int) { return false; }, "unstable");
+  GALOIS_ASSERT(std::is_sorted(order.begin(), order.end()),
+                "items ran out of order");
+
+  // Few distinct priorities, so windows are full of equal priorities, and
+  // most items fail the stability test; every round must still commit the
+  // earliest item of its window for the loop to finish
+  const int numTies = 2000;
+  auto priority      = [](int x) { return x / 200; };
+  auto byPriority    = [=](int a, int b) { return priority(a) < priority(b); };
+  Buckets ties;
+  galois::for_each_ordered(
+      items.begin(), items.begin() + numTies, byPriority,
+      [&](int x) { ties.acquire(x); },
+      [&](int x, galois::UserContext<int>&) {
+        ties.runs[x % Buckets::numBuckets].push_back(priority(x));
+      },
+      [](int x) { return x % 8 == 0; }, "ties");
+  total = 0;
+  for (auto& r : ties.runs)
+    total += r.size();
+  GALOIS_ASSERT(total == numTies, "missing items");
+  GALOIS_ASSERT(ties.check(), "items of a bucket ran out of order");
+
+  return 0;
+}
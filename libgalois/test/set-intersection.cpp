@@ -0,0 +1,110 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/SetIntersection.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace in = galois::intersection;
+
+std::vector<uint32_t> randomSet(std::mt19937& gen, size_t n, uint32_t range) {
+  std::uniform_int_distribution<uint32_t> dist(0, range - 1);
+  std::set<uint32_t> s;
+  while (s.size() < std::min<size_t>(n, range)) {
+    s.insert(dist(gen));
+  }
+  return std::vector<uint32_t>(s.begin(), s.end());
+}
+
+// note: GALOIS_ASSERT declares a local named b, so sets are x and y
+void check(const std::vector<uint32_t>& x, const std::vector<uint32_t>& y,
+           uint32_t range) {
+  std::vector<uint32_t> expected;
+  std::set_intersection(x.begin(), x.end(), y.begin(), y.end(),
+                        std::back_inserter(expected));
+
+  std::vector<uint32_t> out(std::min(x.size(), y.size()) + 1);
+  auto matches = [&](size_t n) {
+    return n == expected.size() &&
+           std::equal(expected.begin(), expected.end(), out.begin());
+  };
+
+  for (in::Kernel k :
+       {in::Kernel::Scalar, in::Kernel::AVX2, in::Kernel::AVX512}) {
+    if (!in::isSupported(k)) {
+      continue;
+    }
+    size_t count = in::countMerge(x.data(), x.size(), y.data(), y.size(), k);
+    GALOIS_ASSERT(count == expected.size());
+    size_t n =
+        in::collectMerge(x.data(), x.size(), y.data(), y.size(), out.data(), k);
+    GALOIS_ASSERT(matches(n));
+  }
+
+  const auto& small = (x.size() < y.size()) ? x : y;
+  const auto& large = (x.size() < y.size()) ? y : x;
+  size_t count =
+      in::countGallop(small.data(), small.size(), large.data(), large.size());
+  GALOIS_ASSERT(count == expected.size());
+  size_t n = in::collectGallop(small.data(), small.size(), large.data(),
+                               large.size(), out.data());
+  GALOIS_ASSERT(matches(n));
+
+  std::vector<uint64_t> bitmap((range + 63) / 64, 0);
+  for (uint32_t v : x) {
+    bitmap[v / 64] |= uint64_t{1} << (v % 64);
+  }
+  count = in::countBitmap(bitmap.data(), y.data(), y.size());
+  GALOIS_ASSERT(count == expected.size());
+  n = in::collectBitmap(bitmap.data(), y.data(), y.size(), out.data());
+  GALOIS_ASSERT(matches(n));
+
+  count = in::count(x.data(), x.size(), y.data(), y.size());
+  GALOIS_ASSERT(count == expected.size());
+  n = in::collect(x.data(), x.size(), y.data(), y.size(), out.data());
+  GALOIS_ASSERT(matches(n));
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  std::mt19937 gen(0);
+
+  check({}, {}, 1);
+  check({1, 2, 3}, {}, 4);
+  for (size_t na : {1, 7, 8, 15, 16, 17, 100, 1000}) {
+    for (size_t nb : {1, 8, 16, 33, 100, 5000}) {
+      for (uint32_t range : {64u, 1000u, 100000u}) {
+        check(randomSet(gen, na, range), randomSet(gen, nb, range), range);
+      }
+    }
+  }
+
+  // the best kernel is the widest one the CPU supports
+  in::Kernel best = in::bestKernel();
+  GALOIS_ASSERT(in::isSupported(best));
+  for (in::Kernel k : {in::Kernel::AVX2, in::Kernel::AVX512}) {
+    GALOIS_ASSERT(!in::isSupported(k) || k <= best);
+  }
+  return 0;
+}
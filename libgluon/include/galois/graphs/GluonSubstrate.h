@@ -26,8 +26,11 @@
 #ifndef _GALOIS_GLUONSUB_H_
 #define _GALOIS_GLUONSUB_H_
 
+#include <atomic>
 #include <unordered_map>
 #include <fstream>
+#include <cstring>
+#include <memory>
 
 #include "galois/runtime/GlobalObj.h"
 #include "galois/runtime/DistStats.h"
@@ -71,6 +74,103 @@ enum ReadLocation {
 namespace galois {
 namespace graphs {
 
+/**
+ * Keeps track of the hosts a host has updates for as the bits of a field's
+ * bitset are set, so that finding them costs O(updates) instead of a scan of
+ * the shared proxies. Setting the bit of a mirror marks the host of its
+ * master as one to reduce to, and setting the bit of a master marks the
+ * hosts of its mirrors as ones to broadcast to. Resetting the bits of all
+ * mirrors or all masters unmarks the hosts of that kind; like
+ * GluonSubstrate::reset_bitset, this assumes masters come first.
+ *
+ * Hosts are only unmarked when all bits they could be marked for are reset,
+ * so a host with updates is always marked, and one without may be.
+ */
+class SyncPeerTracker : public galois::DynamicBitSetObserver {
+  galois::DynamicBitSet& bitset;
+  //! Hosts sharing node n are peers[peerOffsets[n]..peerOffsets[n + 1]]
+  const std::vector<size_t>& peerOffsets;
+  const std::vector<uint32_t>& peers;
+  size_t numMasters;
+  std::vector<std::atomic<uint8_t>> reducePeers;
+  std::vector<std::atomic<uint8_t>> broadcastPeers;
+
+  static void mark(std::atomic<uint8_t>& m) {
+    if (!m.load(std::memory_order_relaxed))
+      m.store(1, std::memory_order_relaxed);
+  }
+
+  static void markAll(std::vector<std::atomic<uint8_t>>& marks) {
+    for (auto& m : marks)
+      m.store(1, std::memory_order_relaxed);
+  }
+
+  static void unmarkAll(std::vector<std::atomic<uint8_t>>& marks) {
+    for (auto& m : marks)
+      m.store(0, std::memory_order_relaxed);
+  }
+
+public:
+  /**
+   * Starts tracking the bits of a bitset, which may already have some set,
+   * so every host starts out marked.
+   *
+   * @param _bitset Bitset to track
+   * @param _peerOffsets Offsets of the hosts sharing each node in _peers
+   * @param _peers Hosts sharing each node
+   * @param _numMasters Number of masters, which are nodes 0 to _numMasters - 1
+   * @param numHosts Total number of hosts
+   */
+  SyncPeerTracker(galois::DynamicBitSet& _bitset,
+                  const std::vector<size_t>& _peerOffsets,
+                  const std::vector<uint32_t>& _peers, size_t _numMasters,
+                  unsigned numHosts)
+      : bitset(_bitset), peerOffsets(_peerOffsets), peers(_peers),
+        numMasters(_numMasters), reducePeers(numHosts),
+        broadcastPeers(numHosts) {
+    anySet();
+    bitset.setObserver(this);
+  }
+
+  ~SyncPeerTracker() { bitset.setObserver(nullptr); }
+
+  //! Returns the bitset this tracks
+  const galois::DynamicBitSet& tracked() const { return bitset; }
+
+  //! Returns true if there may be updates to reduce to host x
+  bool reduceTo(unsigned x) const {
+    return reducePeers[x].load(std::memory_order_relaxed);
+  }
+
+  //! Returns true if there may be updates to broadcast to host x
+  bool broadcastTo(unsigned x) const {
+    return broadcastPeers[x].load(std::memory_order_relaxed);
+  }
+
+  void bitSet(size_t index) override {
+    if (index + 1 >= peerOffsets.size()) {
+      anySet();
+      return;
+    }
+    auto& marks = (index < numMasters) ? broadcastPeers : reducePeers;
+    for (size_t i = peerOffsets[index]; i < peerOffsets[index + 1]; ++i)
+      mark(marks[peers[i]]);
+  }
+
+  void anySet() override {
+    markAll(reducePeers);
+    markAll(broadcastPeers);
+  }
+
+  void rangeReset(size_t begin, size_t end) override {
+    size_t numNodes = peerOffsets.size() - 1;
+    if (begin <= numMasters && end + 1 >= numNodes)
+      unmarkAll(reducePeers);
+    if (begin == 0 && end + 1 >= numMasters)
+      unmarkAll(broadcastPeers);
+  }
+};
+
 /**
  * Gluon communication substrate that handles communication given a user graph.
  * User graph should provide certain things the substrate expects.
@@ -104,6 +204,29 @@ private:
   uint32_t num_run; //!< Keep track of number of runs.
   uint32_t num_round; //!< Keep track of number of rounds.
   bool isCartCut;     //!< True if graph is a cartesian cut
+  //! Number of consecutive hosts (e.g., the hosts on one machine) grouped
+  //! together when routing sync messages through a two-level hierarchy;
+  //! 0 or 1 sends messages directly to every host
+  unsigned commGroupSize;
+  //! Hosts in other groups this host forwards its group's messages to
+  std::vector<unsigned> hierarchyForwardHosts;
+  //! Number of hosts in other groups that forward messages to this host
+  unsigned hierarchyForwardSources;
+  //! Messages this host relays to each host in other groups
+  std::vector<galois::runtime::SendBuffer> hierarchyForward;
+  //! If true, hosts agree before each sync on which hosts have updates for
+  //! which so that nothing is sent between hosts with nothing to exchange
+  bool elideEmptySyncs;
+  //! Hosts this host has updates for in the current sync
+  std::vector<uint8_t> syncSendTo;
+  //! Hosts that have updates for this host in the current sync
+  std::vector<uint8_t> syncRecvFrom;
+  //! Hosts sharing local node n are syncPeers[syncPeerOffsets[n]..
+  //! syncPeerOffsets[n + 1]]; built on the first sync that elides
+  std::vector<size_t> syncPeerOffsets;
+  std::vector<uint32_t> syncPeers;
+  //! Trackers of the hosts with updates, one per bitset synced so far
+  std::vector<std::unique_ptr<SyncPeerTracker>> syncPeerTrackers;
 
   // bitvector status hasn't been maintained
   //! Typedef used so galois::runtime::BITVECTOR_STATUS doesn't have to be
@@ -401,6 +524,80 @@ private:
 #endif
   }
 
+  /**
+   * Returns the host that relays messages from host src to host dst when
+   * syncing through the two-level hierarchy. Messages within a group go
+   * directly. Otherwise, a message first goes to the host in src's group
+   * with the same index in its group as dst, which forwards it to dst along
+   * with the messages of the rest of its group. If src's group has no such
+   * host, src relays its own message.
+   *
+   * @param src Host sending the message
+   * @param dst Host the message is meant for
+   * @returns Host that sends the message to dst
+   */
+  unsigned hierarchyRelay(unsigned src, unsigned dst) const {
+    unsigned srcGroup = src / commGroupSize;
+    if (srcGroup == dst / commGroupSize) {
+      return dst;
+    }
+    unsigned relay = srcGroup * commGroupSize + dst % commGroupSize;
+    return (relay < numHosts) ? relay : src;
+  }
+
+  /**
+   * Determines which hosts this host forwards messages to and how many hosts
+   * forward messages to it when syncing through the two-level hierarchy.
+   */
+  void setupCommHierarchy() {
+    if (commGroupSize <= 1 || commGroupSize >= numHosts) {
+      commGroupSize = 0;
+      return;
+    }
+    if (id == 0) {
+      galois::gInfo("Gluon routing sync messages through groups of ",
+                    commGroupSize, " hosts");
+    }
+
+    unsigned myGroup        = id / commGroupSize;
+    hierarchyForwardSources = 0;
+    hierarchyForward.resize(numHosts);
+    for (unsigned x = 0; x < numHosts; ++x) {
+      if (x / commGroupSize == myGroup) {
+        continue;
+      }
+      // x gets a forwarded message from this host if some host in this group
+      // uses this host as its relay to x
+      for (unsigned s = myGroup * commGroupSize;
+           s < std::min((myGroup + 1) * commGroupSize, numHosts); ++s) {
+        if (hierarchyRelay(s, x) == id) {
+          hierarchyForwardHosts.push_back(x);
+          break;
+        }
+      }
+    }
+
+    // count the distinct relays the hosts of every other group use to reach
+    // this host
+    std::vector<bool> isSource(numHosts, false);
+    for (unsigned s = 0; s < numHosts; ++s) {
+      if (s / commGroupSize != myGroup) {
+        isSource[hierarchyRelay(s, id)] = true;
+      }
+    }
+    for (unsigned s = 0; s < numHosts; ++s) {
+      if (isSource[s]) {
+        ++hierarchyForwardSources;
+      }
+    }
+  }
+
+  //! Returns true if sync messages should go through the two-level hierarchy
+  //! (only supported for bulk-synchronous syncs)
+  bool useCommHierarchy(bool async) const {
+    return (commGroupSize != 0) && !async;
+  }
+
 public:
   /**
    * Delete default constructor: this class NEEDS to have a graph passed into
@@ -419,17 +616,24 @@ public:
    * @param _partitionAgnostic determines if sync should be partition agnostic
    * or not
    * @param _enforcedDataMode Forced data comm mode for sync
+   * @param _commGroupSize Number of consecutive hosts grouped together when
+   * routing sync messages through a two-level hierarchy; 0 or 1 sends
+   * messages directly to every host
+   * @param _elideEmptySyncs If true, hosts with no updates for a host send
+   * it nothing instead of an empty message
    */
   GluonSubstrate(
       GraphTy& _userGraph, unsigned host, unsigned numHosts, bool _transposed,
       std::pair<unsigned, unsigned> _cartesianGrid = std::make_pair(0u, 0u),
       bool _partitionAgnostic                      = false,
-      DataCommMode _enforcedDataMode               = DataCommMode::noData)
+      DataCommMode _enforcedDataMode               = DataCommMode::noData,
+      unsigned _commGroupSize = 0, bool _elideEmptySyncs = false)
       : galois::runtime::GlobalObject(this), userGraph(_userGraph), id(host),
         transposed(_transposed), isVertexCut(userGraph.is_vertex_cut()),
         cartesianGrid(_cartesianGrid), partitionAgnostic(_partitionAgnostic),
         substrateDataMode(_enforcedDataMode), numHosts(numHosts), num_run(0),
-        num_round(0), currentBVFlag(nullptr),
+        num_round(0), commGroupSize(_commGroupSize),
+        elideEmptySyncs(_elideEmptySyncs), currentBVFlag(nullptr),
         mirrorNodes(userGraph.getMirrorNodes()) {
     if (cartesianGrid.first != 0 && cartesianGrid.second != 0) {
       GALOIS_ASSERT(cartesianGrid.first * cartesianGrid.second == numHosts,
@@ -448,6 +652,7 @@ public:
     enforcedDataMode = _enforcedDataMode;
 
     initBareMPI();
+    setupCommHierarchy();
     // master setup from mirrors done by setupCommunication call
     masterNodes.resize(numHosts);
     // setup proxy communication
@@ -2108,6 +2313,116 @@ private:
   }
 #endif
 
+  /**
+   * Builds the lists of hosts sharing each local node from the master and
+   * mirror lists: the host of the master of each mirror, and the hosts of the
+   * mirrors of each master.
+   */
+  void buildSyncPeers() {
+    size_t numNodes = userGraph.size();
+    syncPeerOffsets.assign(numNodes + 1, 0);
+    for (unsigned x = 0; x < numHosts; ++x) {
+      for (size_t n : mirrorNodes[x])
+        ++syncPeerOffsets[n + 1];
+      for (size_t n : masterNodes[x])
+        ++syncPeerOffsets[n + 1];
+    }
+    for (size_t n = 0; n < numNodes; ++n)
+      syncPeerOffsets[n + 1] += syncPeerOffsets[n];
+
+    syncPeers.resize(syncPeerOffsets[numNodes]);
+    std::vector<size_t> filled(syncPeerOffsets.begin(),
+                               syncPeerOffsets.end() - 1);
+    for (unsigned x = 0; x < numHosts; ++x) {
+      for (size_t n : mirrorNodes[x])
+        syncPeers[filled[n]++] = x;
+      for (size_t n : masterNodes[x])
+        syncPeers[filled[n]++] = x;
+    }
+  }
+
+  /**
+   * Returns the tracker of the hosts with updates in a bitset, which starts
+   * tracking it on the first call, or null if its bits are observed by
+   * something else.
+   *
+   * @param bitset Bitset of the field being synced
+   */
+  SyncPeerTracker* getSyncPeerTracker(galois::DynamicBitSet& bitset) {
+    for (auto& t : syncPeerTrackers) {
+      if (&t->tracked() == &bitset)
+        return t.get();
+    }
+    if (bitset.getObserver())
+      return nullptr;
+
+    if (syncPeerOffsets.empty())
+      buildSyncPeers();
+    syncPeerTrackers.emplace_back(
+        std::make_unique<SyncPeerTracker>(bitset, syncPeerOffsets, syncPeers,
+                                          userGraph.numMasters(), numHosts));
+    return syncPeerTrackers.back().get();
+  }
+
+  /**
+   * Hosts agree on which hosts have updates for which in the current sync
+   * with a single all-to-all exchange of one byte per host pair, so that
+   * hosts with nothing to exchange skip the empty messages they would
+   * otherwise send and wait for. Late rounds where most hosts have no updates
+   * then cost one collective instead of a message between every host pair.
+   *
+   * The hosts this host has updates for come from a SyncPeerTracker on the
+   * field's bitset, which marks them as bits are set. Fields without a
+   * bitset, vector bitsets, onlyData mode and GPU builds, where bitsets are
+   * copied from the device rather than set, send to every host as usual.
+   *
+   * @tparam syncType either reduce or broadcast
+   * @tparam BitsetFnTy struct that has info on how to access the bitset
+   *
+   * @param loopName used to name timers for statistics
+   */
+  template <WriteLocation writeLocation, ReadLocation readLocation,
+            SyncType syncType, typename BitsetFnTy>
+  void exchangeSyncPartners(std::string loopName) {
+    std::string syncTypeStr = (syncType == syncReduce) ? "Reduce" : "Broadcast";
+    galois::StatTimer Texchange(
+        (syncTypeStr + "PartnerExchange_" + get_run_identifier(loopName))
+            .c_str(),
+        RNAME);
+    Texchange.start();
+
+    SyncPeerTracker* tracker = nullptr;
+#ifndef GALOIS_ENABLE_GPU
+    if (BitsetFnTy::is_valid() && !BitsetFnTy::is_vector_bitset() &&
+        substrateDataMode != onlyData) {
+      tracker = getSyncPeerTracker(BitsetFnTy::get());
+    }
+#endif
+
+    syncSendTo.assign(numHosts, 0);
+    for (unsigned x = 0; x < numHosts; ++x) {
+      if (x == id || nothingToSend(x, syncType, writeLocation, readLocation))
+        continue;
+      if (!tracker)
+        syncSendTo[x] = 1;
+      else if (syncType == syncReduce)
+        syncSendTo[x] = tracker->reduceTo(x);
+      else
+        syncSendTo[x] = tracker->broadcastTo(x);
+    }
+
+    syncRecvFrom.resize(numHosts);
+#ifdef GALOIS_USE_LCI
+    // no all-to-all available: expect a message from everyone as usual
+    std::fill(syncRecvFrom.begin(), syncRecvFrom.end(), 1);
+    std::fill(syncSendTo.begin(), syncSendTo.end(), 1);
+#else
+    MPI_Alltoall(syncSendTo.data(), 1, MPI_BYTE, syncRecvFrom.data(), 1,
+                 MPI_BYTE, MPI_COMM_WORLD);
+#endif
+    Texchange.stop();
+  }
+
   /**
    * Sends data to all hosts (if there is anything that needs to be sent
    * to that particular host) and adjusts bitset according to sync type.
@@ -2133,12 +2448,23 @@ private:
     std::string statNumMessages_str(syncTypeStr + "NumMessages_" +
                                     get_run_identifier(loopName));
 
+    bool elide = elideEmptySyncs && !async;
+    if (elide) {
+      exchangeSyncPartners<writeLocation, readLocation, syncType, BitsetFnTy>(
+          loopName);
+    }
+
     size_t numMessages = 0;
+    size_t numElided   = 0;
     for (unsigned h = 1; h < numHosts; ++h) {
       unsigned x = (id + h) % numHosts;
 
       if (nothingToSend(x, syncType, writeLocation, readLocation))
         continue;
+      if (elide && !syncSendTo[x]) {
+        ++numElided;
+        continue;
+      }
 
       getSendBuffer<syncType, SyncFnTy, BitsetFnTy, VecTy, async>(loopName, x,
                                                                   b);
@@ -2160,6 +2486,118 @@ private:
       reset_bitset(syncType, &BitsetFnTy::reset_range);
     }
 
+    galois::runtime::reportStat_Tsum(RNAME, statNumMessages_str, numMessages);
+    if (elide) {
+      // the partner exchange sends a byte to every other host
+      galois::runtime::reportStat_Tsum(
+          RNAME,
+          syncTypeStr + "PartnerExchangeBytes_" + get_run_identifier(loopName),
+          numHosts - 1);
+      galois::runtime::reportStat_Tsum(
+          RNAME, syncTypeStr + "ElidedMessages_" + get_run_identifier(loopName),
+          numElided);
+    }
+  }
+
+  /**
+   * Appends a message to a bundle of messages sent through the two-level
+   * hierarchy. A bundle starts with the number of messages it holds.
+   *
+   * @param bundle Bundle to append to
+   * @param host Host the message is for (first hop) or from (second hop)
+   * @param data Message to append
+   * @param size Size of the message in bytes
+   */
+  void appendToBundle(galois::runtime::SendBuffer& bundle, uint32_t host,
+                      const uint8_t* data, size_t size) {
+    uint32_t numEntries = 0;
+    if (bundle.size() == 0) {
+      galois::runtime::gSerialize(bundle, numEntries);
+    }
+    std::memcpy(&numEntries, bundle.linearData(), sizeof(numEntries));
+    ++numEntries;
+    bundle.insertAt(reinterpret_cast<const uint8_t*>(&numEntries),
+                    sizeof(numEntries), 0);
+
+    galois::runtime::gSerialize(bundle, host, size);
+    bundle.insert(data, size);
+  }
+
+  /**
+   * Sends a bundle of messages to a host. Bundles with no messages are still
+   * sent (with a header) as the receiver expects one from every sender;
+   * the buffered network layer never delivers zero-byte messages.
+   *
+   * @param dest Host to send the bundle to
+   * @param bundle Bundle to send; it is moved out
+   */
+  void sendBundle(uint32_t dest, galois::runtime::SendBuffer& bundle) {
+    if (bundle.size() == 0) {
+      uint32_t numEntries = 0;
+      galois::runtime::gSerialize(bundle, numEntries);
+    }
+    galois::runtime::getSystemNetworkInterface().sendTagged(
+        dest, galois::runtime::evilPhase, bundle);
+  }
+
+  /**
+   * First hop of a sync through the two-level hierarchy: builds the message
+   * for every host as usual, but bundles all messages that go through the
+   * same relay and sends one bundle to every other host in this group.
+   * Messages this host relays itself are kept for the second hop.
+   *
+   * @tparam writeLocation Location data is written (src or dst)
+   * @tparam readLocation Location data is read (src or dst)
+   * @tparam syncType either reduce or broadcast
+   * @tparam SyncFnTy synchronization structure with info needed to synchronize
+   * @tparam BitsetFnTy struct that has info on how to access the bitset
+   *
+   * @param loopName used to name timers created by this sync send
+   */
+  template <WriteLocation writeLocation, ReadLocation readLocation,
+            SyncType syncType, typename SyncFnTy, typename BitsetFnTy,
+            typename VecTy>
+  void syncHierarchySend(std::string loopName) {
+    auto& net               = galois::runtime::getSystemNetworkInterface();
+    std::string syncTypeStr = (syncType == syncReduce) ? "Reduce" : "Broadcast";
+    std::string statNumMessages_str(syncTypeStr + "NumMessages_" +
+                                    get_run_identifier(loopName));
+
+    std::vector<galois::runtime::SendBuffer> bundles(numHosts);
+    for (unsigned h = 1; h < numHosts; ++h) {
+      unsigned x = (id + h) % numHosts;
+
+      if (nothingToSend(x, syncType, writeLocation, readLocation))
+        continue;
+
+      galois::runtime::SendBuffer b;
+      getSendBuffer<syncType, SyncFnTy, BitsetFnTy, VecTy, false>(loopName, x,
+                                                                  b);
+
+      unsigned relay = hierarchyRelay(id, x);
+      if (relay == id) {
+        appendToBundle(hierarchyForward[x], id, b.linearData(), b.size());
+      } else {
+        appendToBundle(bundles[relay], x, b.linearData(), b.size());
+      }
+    }
+
+    // every host in the group expects a (possibly empty) bundle
+    size_t numMessages  = 0;
+    unsigned groupBegin = (id / commGroupSize) * commGroupSize;
+    unsigned groupEnd   = std::min(groupBegin + commGroupSize, numHosts);
+    for (unsigned x = groupBegin; x < groupEnd; ++x) {
+      if (x == id)
+        continue;
+      sendBundle(x, bundles[x]);
+      ++numMessages;
+    }
+    net.flush();
+
+    if (BitsetFnTy::is_valid()) {
+      reset_bitset(syncType, &BitsetFnTy::reset_range);
+    }
+
     galois::runtime::reportStat_Tsum(RNAME, statNumMessages_str, numMessages);
   }
 
@@ -2184,8 +2622,13 @@ private:
         (syncTypeStr + "Send_" + get_run_identifier(loopName)).c_str(), RNAME);
 
     TSendTime.start();
-    syncNetSend<writeLocation, readLocation, syncType, SyncFnTy, BitsetFnTy,
-                VecTy, async>(loopName);
+    if (useCommHierarchy(async)) {
+      syncHierarchySend<writeLocation, readLocation, syncType, SyncFnTy,
+                        BitsetFnTy, VecTy>(loopName);
+    } else {
+      syncNetSend<writeLocation, readLocation, syncType, SyncFnTy, BitsetFnTy,
+                  VecTy, async>(loopName);
+    }
     TSendTime.stop();
   }
 
@@ -2514,6 +2957,8 @@ private:
           continue;
         if (nothingToRecv(x, syncType, writeLocation, readLocation))
           continue;
+        if (elideEmptySyncs && !syncRecvFrom[x])
+          continue;
 
         Twait.start();
         decltype(net.recieveTagged(galois::runtime::evilPhase, nullptr)) p;
@@ -2529,6 +2974,96 @@ private:
     }
   }
 
+  /**
+   * Receives numBundles bundles sent through the two-level hierarchy. Messages
+   * meant for this host are applied; first hop messages meant for other hosts
+   * are kept to be forwarded in the second hop.
+   *
+   * @tparam syncType either reduce or broadcast
+   * @tparam SyncFnTy synchronization structure with info needed to synchronize
+   * @tparam BitsetFnTy struct that has info on how to access the bitset
+   *
+   * @param loopName used to name timers for statistics
+   * @param numBundles Number of bundles to receive
+   * @param firstHop True if bundles are from the first hop (tagged with the
+   * host each message is for); else they are tagged with the host each
+   * message is from
+   */
+  template <SyncType syncType, typename SyncFnTy, typename BitsetFnTy,
+            typename VecTy>
+  void syncHierarchyRecvBundles(std::string loopName, unsigned numBundles,
+                                bool firstHop) {
+    auto& net = galois::runtime::getSystemNetworkInterface();
+    std::string wait_timer_str("Wait_" + get_run_identifier(loopName));
+    galois::CondStatTimer<GALOIS_COMM_STATS> Twait(wait_timer_str.c_str(),
+                                                   RNAME);
+
+    for (unsigned i = 0; i < numBundles; ++i) {
+      Twait.start();
+      decltype(net.recieveTagged(galois::runtime::evilPhase, nullptr)) p;
+      do {
+        p = net.recieveTagged(galois::runtime::evilPhase, nullptr);
+      } while (!p);
+      Twait.stop();
+
+      galois::runtime::RecvBuffer& bundle = p->second;
+      uint32_t numEntries;
+      galois::runtime::gDeserialize(bundle, numEntries);
+      for (uint32_t e = 0; e < numEntries; ++e) {
+        uint32_t host;
+        size_t size;
+        galois::runtime::gDeserialize(bundle, host, size);
+        const uint8_t* data = bundle.r_linearData();
+        bundle.setOffset(bundle.getOffset() + size);
+
+        if (firstHop && host != id) {
+          appendToBundle(hierarchyForward[host], p->first, data, size);
+        } else {
+          galois::runtime::RecvBuffer message(data, data + size);
+          syncRecvApply<syncType, SyncFnTy, BitsetFnTy, VecTy, false>(
+              firstHop ? p->first : host, message, loopName);
+        }
+      }
+    }
+    incrementEvilPhase();
+  }
+
+  /**
+   * Second hop of a sync through the two-level hierarchy: receives this
+   * group's bundles, forwards the messages relayed by this host to the hosts
+   * in other groups (one message per host), and applies everything meant for
+   * this host.
+   *
+   * @tparam syncType either reduce or broadcast
+   * @tparam SyncFnTy synchronization structure with info needed to synchronize
+   * @tparam BitsetFnTy struct that has info on how to access the bitset
+   *
+   * @param loopName used to name timers for statistics
+   */
+  template <SyncType syncType, typename SyncFnTy, typename BitsetFnTy,
+            typename VecTy>
+  void syncHierarchyRecv(std::string loopName) {
+    auto& net               = galois::runtime::getSystemNetworkInterface();
+    std::string syncTypeStr = (syncType == syncReduce) ? "Reduce" : "Broadcast";
+    std::string statNumMessages_str(syncTypeStr + "NumMessages_" +
+                                    get_run_identifier(loopName));
+
+    unsigned groupBegin = (id / commGroupSize) * commGroupSize;
+    unsigned groupEnd   = std::min(groupBegin + commGroupSize, numHosts);
+    syncHierarchyRecvBundles<syncType, SyncFnTy, BitsetFnTy, VecTy>(
+        loopName, groupEnd - groupBegin - 1, true);
+
+    for (unsigned x : hierarchyForwardHosts) {
+      sendBundle(x, hierarchyForward[x]);
+    }
+    net.flush();
+    galois::runtime::reportStat_Tsum(RNAME, statNumMessages_str,
+                                     hierarchyForwardHosts.size());
+
+    syncHierarchyRecvBundles<syncType, SyncFnTy, BitsetFnTy, VecTy>(
+        loopName, hierarchyForwardSources, false);
+  }
+
   /**
    * Receives messages from all other hosts and "applies" the message (reduce
    * or set) based on the sync structure provided.
@@ -2550,8 +3085,12 @@ private:
         (syncTypeStr + "Recv_" + get_run_identifier(loopName)).c_str(), RNAME);
 
     TRecvTime.start();
-    syncNetRecv<writeLocation, readLocation, syncType, SyncFnTy, BitsetFnTy,
-                VecTy, async>(loopName);
+    if (useCommHierarchy(async)) {
+      syncHierarchyRecv<syncType, SyncFnTy, BitsetFnTy, VecTy>(loopName);
+    } else {
+      syncNetRecv<writeLocation, readLocation, syncType, SyncFnTy, BitsetFnTy,
+                  VecTy, async>(loopName);
+    }
     TRecvTime.stop();
   }
 
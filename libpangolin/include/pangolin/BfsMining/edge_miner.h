@@ -4,6 +4,8 @@
 #include "pangolin/quick_pattern.h"
 #include "pangolin/canonical_graph.h"
 #include "pangolin/domain_support.h"
+#include "pangolin/pattern_map.h"
+#include "pangolin/label_index.h"
 #include "pangolin/BfsMining/embedding_list.h"
 
 template <typename ElementTy, typename EmbeddingTy, typename API,
@@ -18,46 +20,51 @@ class EdgeMiner : public Miner<ElementTy, EmbeddingTy, false> {
   typedef std::unordered_map<CPattern, Frequency> CgMapFreq;
   // quick pattern map (mapping quick pattern to its domain support)
   typedef std::unordered_map<QPattern, DomainSupport*> QpMapDomain;
-  // canonical pattern map (mapping canonical pattern to its domain support)
-  typedef std::unordered_map<CPattern, DomainSupport*> CgMapDomain;
+  // canonical pattern map (mapping canonical pattern to its domain support),
+  // updated by all threads at once
+  typedef PatternMap<CPattern, DomainSupport*> CgMapDomain;
+  // canonical form of a quick pattern, computed once by bliss
+  struct CanonicalForm {
+    CPattern cg;
+    VertexPositionEquivalences equivalences;
+  };
+  // memoized canonical forms (mapping quick pattern to its canonical form)
+  typedef PatternMap<QPattern, CanonicalForm> QpMapCanonical;
   // PerThreadStorage: thread-local quick pattern map
   typedef galois::substrate::PerThreadStorage<QpMapFreq> LocalQpMapFreq;
   // PerThreadStorage: thread-local canonical pattern map
   typedef galois::substrate::PerThreadStorage<CgMapFreq> LocalCgMapFreq;
   typedef galois::substrate::PerThreadStorage<QpMapDomain> LocalQpMapDomain;
-  typedef galois::substrate::PerThreadStorage<CgMapDomain> LocalCgMapDomain;
 
 public:
   EdgeMiner(unsigned max_sz, int nt)
       : Miner<ElementTy, EmbeddingTy, false>(max_sz, nt) {}
   virtual ~EdgeMiner() {}
   void clean() {
-    edge_map.clear();
     freq_edge_set.clear();
-    is_frequent_edge.clear();
+    is_frequent_label.clear();
+    all_labels_frequent.clear();
     clean_maps();
   }
   void clean_maps() {
     id_map.clear();
     domain_support_map.clear();
-    for (auto ele : qp_map)
-      ele.second->clean();
-    for (auto ele : cg_map)
-      ele.second->clean();
+    cg_map.for_each([](const CPattern&, DomainSupport* support) {
+      support->clean();
+      delete support;
+    });
     for (auto ele : init_map)
       ele.second->clean();
-    qp_map.clear();
     cg_map.clear();
+    cf_cache.clear();
     init_map.clear();
     for (auto i = 0; i < this->num_threads; i++) {
       auto qp_map_ptr = qp_localmaps.getLocal(i);
-      for (auto ele : *qp_map_ptr)
+      for (auto ele : *qp_map_ptr) {
         ele.second->clean();
+        delete ele.second;
+      }
       qp_map_ptr->clear();
-      auto cg_map_ptr = cg_localmaps.getLocal(i);
-      for (auto ele : *cg_map_ptr)
-        ele.second->clean();
-      cg_map_ptr->clear();
       auto init_map_ptr = init_pattern_maps.getLocal(i);
       for (auto ele : *init_map_ptr)
         ele.second->clean();
@@ -67,7 +74,8 @@ public:
   void initialize(std::string) { init_emb_list(); }
   void init_emb_list() {
     this->emb_list.init(this->graph, this->max_size + 1);
-    construct_edgemap();
+    if (label_index.empty())
+      label_index.build(this->graph);
   }
   void inc_total_num(int value) { total_num += value; }
   void solver() {
@@ -90,9 +98,7 @@ public:
       level++;
       // this->emb_list.printout_embeddings(level, debug);
       quick_aggregate(level);
-      merge_qp_map(level + 1);
       canonical_aggregate();
-      merge_cg_map(level + 1);
       num_freq_patterns = support_count();
       // std::cout << "num_frequent_patterns: " << num_freq_patterns << "\n";
       // printout_agg();
@@ -123,13 +129,11 @@ public:
           for (unsigned i = 0; i < n; ++i) {
             auto src = emb.get_vertex(i);
             if (emb.get_key(i) == 0) { // TODO: need to fix this
-              for (auto e : this->graph.edges(src)) {
-                GNode dst    = this->graph.getEdgeDst(e);
+              for_each_frequent_neighbor(src, [&](VertexId dst) {
                 BYTE existed = 0;
-                if (is_frequent_edge[*e])
-                  if (API::toAdd(n, emb, i, src, dst, existed, vert_set))
-                    num_new_emb[pos]++;
-              }
+                if (API::toAdd(n, emb, i, src, dst, existed, vert_set))
+                  num_new_emb[pos]++;
+              });
             }
           }
           emb.clean();
@@ -155,17 +159,14 @@ public:
           for (unsigned i = 0; i < n; ++i) {
             auto src = emb.get_vertex(i);
             if (emb.get_key(i) == 0) {
-              for (auto e : this->graph.edges(src)) {
-                GNode dst    = this->graph.getEdgeDst(e);
+              for_each_frequent_neighbor(src, [&](VertexId dst) {
                 BYTE existed = 0;
-                if (is_frequent_edge[*e]) {
-                  if (API::toAdd(n, emb, i, src, dst, existed, vert_set)) {
-                    this->emb_list.set_idx(level + 1, start, pos);
-                    this->emb_list.set_his(level + 1, start, i);
-                    this->emb_list.set_vid(level + 1, start++, dst);
-                  }
+                if (API::toAdd(n, emb, i, src, dst, existed, vert_set)) {
+                  this->emb_list.set_idx(level + 1, start, pos);
+                  this->emb_list.set_his(level + 1, start, i);
+                  this->emb_list.set_vid(level + 1, start++, dst);
                 }
-              }
+              });
             }
           }
         },
@@ -179,17 +180,27 @@ public:
         [&](const GNode& src) {
           InitMap* lmap   = init_pattern_maps.getLocal();
           auto& src_label = this->graph.getData(src);
-          for (auto e : this->graph.edges(src)) {
-            GNode dst       = this->graph.getEdgeDst(e);
-            auto& dst_label = this->graph.getData(dst);
-            if (src_label <= dst_label) {
-              InitPattern key = get_init_pattern(src_label, dst_label);
-              if (lmap->find(key) == lmap->end()) {
-                (*lmap)[key] = new DomainSupport(2);
-                (*lmap)[key]->set_threshold(threshold);
-              }
-              (*lmap)[key]->add_vertex(0, src);
-              (*lmap)[key]->add_vertex(1, dst);
+          // all the neighbors of a run form the same single-edge pattern
+          for (auto r = label_index.run_begin(src);
+               r < label_index.run_end(src); r++) {
+            auto dst_label = label_index.get_label(r);
+            if (src_label > dst_label)
+              continue;
+            InitPattern key = get_init_pattern(src_label, dst_label);
+            auto it         = lmap->find(key);
+            if (it == lmap->end()) {
+              DomainSupport* support = new DomainSupport(2);
+              support->set_threshold(threshold);
+              it = lmap->emplace(key, support).first;
+            }
+            DomainSupport* support = it->second;
+            if (support->has_domain_reached_support(0) == false)
+              support->add_vertex(0, src);
+            for (auto nb = label_index.begin(r); nb != label_index.end(r);
+                 nb++) {
+              if (support->has_domain_reached_support(1))
+                break;
+              support->add_vertex(1, *nb);
             }
           }
         },
@@ -214,22 +225,19 @@ public:
           get_embedding(level, pos, emb);
           unsigned n = emb.size();
           QPattern qp(emb, true);
-          bool qp_existed = false;
-          auto it         = lmap->find(qp);
+          auto it = lmap->find(qp);
           if (it == lmap->end()) {
-            (*lmap)[qp] = new DomainSupport(n);
-            (*lmap)[qp]->set_threshold(threshold);
-            this->emb_list.set_pid(pos, qp.get_id());
-          } else {
-            qp_existed = true;
-            this->emb_list.set_pid(pos, (it->first).get_id());
-          }
+            DomainSupport* support = new DomainSupport(n);
+            support->set_threshold(threshold);
+            it = lmap->emplace(qp, support).first;
+          } else
+            qp.clean();
+          this->emb_list.set_pid(pos, (it->first).get_id());
+          DomainSupport* support = it->second;
           for (unsigned i = 0; i < n; i++) {
-            if ((*lmap)[qp]->has_domain_reached_support(i) == false)
-              (*lmap)[qp]->add_vertex(i, emb.get_vertex(i));
+            if (support->has_domain_reached_support(i) == false)
+              support->add_vertex(i, emb.get_vertex(i));
           }
-          if (qp_existed)
-            qp.clean();
         },
         galois::chunk_size<CHUNK_SIZE>(), galois::steal(),
         galois::loopname("QuickAggregation"));
@@ -237,55 +245,66 @@ public:
   // aggregate quick patterns into canonical patterns.
   // construct id_map from quick pattern ID (qp_id) to canonical pattern ID
   // (cg_id)
+  // Every thread aggregates the quick patterns of its own map, so they are
+  // not merged into a global quick pattern map first. The canonical form of
+  // a quick pattern is memoized in cf_cache, so bliss runs about once per
+  // distinct quick pattern even though several threads may have found it,
+  // and domain supports are merged straight into the shared cg_map.
   void canonical_aggregate() {
     id_map.clear();
-    for (auto i = 0; i < this->num_threads; i++)
-      cg_localmaps.getLocal(i)->clear();
-    galois::do_all(
-        galois::iterate(qp_map),
-        [&](std::pair<QPattern, DomainSupport*> element) {
-          CgMapDomain* lmap    = cg_localmaps.getLocal();
-          unsigned num_domains = element.first.get_size();
-          CPattern cg(element.first);
-          int qp_id = element.first.get_id();
-          int cg_id = cg.get_id();
-          slock.lock();
-          id_map.insert(std::make_pair(qp_id, cg_id));
-          slock.unlock();
-          auto it = lmap->find(cg);
-          if (it == lmap->end()) {
-            (*lmap)[cg] = new DomainSupport(num_domains);
-            (*lmap)[cg]->set_threshold(threshold);
-            element.first.set_cgid(cg.get_id());
-          } else {
-            element.first.set_cgid((it->first).get_id());
-          }
-          VertexPositionEquivalences equivalences;
-          element.first.get_equivalences(equivalences);
-          for (unsigned i = 0; i < num_domains; i++) {
-            if ((*lmap)[cg]->has_domain_reached_support(i) == false) {
-              unsigned qp_idx = cg.get_quick_pattern_index(i);
-              assert(qp_idx < num_domains);
-              UintSet equ_set = equivalences.get_equivalent_set(qp_idx);
-              for (unsigned idx : equ_set) {
-                DomainSupport* support = element.second;
-                if (support->has_domain_reached_support(idx) == false) {
-                  bool reached_threshold =
-                      (*lmap)[cg]->add_vertices(i, support->domain_sets[idx]);
-                  if (reached_threshold)
-                    break;
-                } else {
-                  (*lmap)[cg]->set_domain_frequent(i);
-                  break;
-                }
-              }
+    galois::on_each(
+        [&](unsigned tid, unsigned) {
+          for (auto& element : *qp_localmaps.getLocal(tid)) {
+            CanonicalForm* form = cf_cache.find(element.first);
+            if (form == nullptr) {
+              QPattern qp = element.first;
+              CanonicalForm cf{CPattern(qp), VertexPositionEquivalences()};
+              qp.get_equivalences(cf.equivalences);
+              auto res = cf_cache.insert(qp, cf);
+              form     = res.first;
+              if (res.second) {
+                slock.lock();
+                id_map.insert(std::make_pair(qp.get_id(), form->cg.get_id()));
+                slock.unlock();
+              } else
+                cf.cg.clean();
             }
+            merge_into_canonical(*form, element.first.get_size(),
+                                 element.second);
           }
-          cg.clean();
         },
-        galois::chunk_size<CHUNK_SIZE>(), galois::steal(),
         galois::loopname("CanonicalAggregation"));
   }
+  // merge the domain support of a quick pattern into the domain support of
+  // its canonical pattern, mapping every domain through the equivalent
+  // positions of the quick pattern
+  inline void merge_into_canonical(CanonicalForm& form, unsigned num_domains,
+                                   DomainSupport* support) {
+    cg_map.update(form.cg, [&](DomainSupport*& cg_support, bool inserted) {
+      if (inserted) {
+        cg_support = new DomainSupport(num_domains);
+        cg_support->set_threshold(threshold);
+      }
+      for (unsigned i = 0; i < num_domains; i++) {
+        if (cg_support->has_domain_reached_support(i) == false) {
+          unsigned qp_idx = form.cg.get_quick_pattern_index(i);
+          assert(qp_idx < num_domains);
+          UintSet equ_set = form.equivalences.get_equivalent_set(qp_idx);
+          for (unsigned idx : equ_set) {
+            if (support->has_domain_reached_support(idx) == false) {
+              bool reached_threshold =
+                  cg_support->add_vertices(i, support->domain_sets[idx]);
+              if (reached_threshold)
+                break;
+            } else {
+              cg_support->set_domain_frequent(i);
+              break;
+            }
+          }
+        }
+      }
+    });
+  }
   inline void merge_qp_map(LocalQpMapFreq& qp_localmap, QpMapFreq& qp_map) {
     for (auto i = 0; i < this->num_threads; i++) {
       for (auto element : *qp_localmap.getLocal(i)) {
@@ -327,63 +346,6 @@ public:
       }
     }
   }
-  inline void merge_qp_map(unsigned num_domains) {
-    qp_map.clear();
-    qp_map = *(qp_localmaps.getLocal(0));
-    for (auto i = 1; i < this->num_threads; i++) {
-      const QpMapDomain* lmap = qp_localmaps.getLocal(i);
-      for (auto element : *lmap) {
-        if (qp_map.find(element.first) == qp_map.end())
-          qp_map[element.first] = element.second;
-      }
-      galois::do_all(
-          galois::iterate(*lmap),
-          [&](std::pair<QPattern, DomainSupport*> element) {
-            DomainSupport* support = element.second;
-            for (unsigned i = 0; i < num_domains; i++) {
-              if (!qp_map[element.first]->has_domain_reached_support(i) &&
-                  qp_map[element.first] != support) {
-                if (support->has_domain_reached_support(i))
-                  qp_map[element.first]->set_domain_frequent(i);
-                else
-                  qp_map[element.first]->add_vertices(i,
-                                                      support->domain_sets[i]);
-              }
-            }
-          },
-          galois::chunk_size<CHUNK_SIZE>(), galois::steal(),
-          galois::loopname("MergeQuickPatterns"));
-    }
-  }
-  inline void merge_cg_map(unsigned num_domains) {
-    cg_map.clear();
-    cg_map = *(cg_localmaps.getLocal(0));
-    for (auto i = 1; i < this->num_threads; i++) {
-      const CgMapDomain* lmap = cg_localmaps.getLocal(i);
-      for (auto element : *lmap) {
-        if (cg_map.find(element.first) == cg_map.end())
-          cg_map[element.first] = element.second;
-      }
-      galois::do_all(
-          galois::iterate(*lmap),
-          [&](std::pair<CPattern, DomainSupport*> element) {
-            DomainSupport* support = element.second;
-            for (unsigned i = 0; i < num_domains; i++) {
-              if (!cg_map[element.first]->has_domain_reached_support(i) &&
-                  cg_map[element.first] != support) {
-                if (support->has_domain_reached_support(i))
-                  cg_map[element.first]->set_domain_frequent(i);
-                else
-                  cg_map[element.first]->add_vertices(i,
-                                                      support->domain_sets[i]);
-              }
-            }
-          },
-          galois::chunk_size<CHUNK_SIZE>(), galois::steal(),
-          galois::loopname("MergeCanonicalPatterns"));
-    }
-  }
-
   // Filtering for FSM
   inline void init_filter() {
     UintList is_frequent_emb(this->emb_list.size(), 0);
@@ -403,26 +365,31 @@ public:
 
     assert(this->emb_list.size() * 2 ==
            this->graph.sizeEdges()); // symmetric graph
-    is_frequent_edge.resize(this->graph.sizeEdges());
-    std::fill(is_frequent_edge.begin(), is_frequent_edge.end(), 0);
+    num_labels = label_index.get_max_label() + 1;
+    is_frequent_label.assign(num_labels * num_labels, 0);
+    for (auto element : init_map) {
+      if (element.second->get_support()) {
+        auto l0 = element.first.first;
+        auto l1 = element.first.second;
+        is_frequent_label[l0 * num_labels + l1] = 1;
+        is_frequent_label[l1 * num_labels + l0] = 1;
+      }
+    }
+    all_labels_frequent.assign(num_labels, 0);
+    for (unsigned l = 0; l < num_labels; l++)
+      all_labels_frequent[l] =
+          std::all_of(&is_frequent_label[l * num_labels],
+                      &is_frequent_label[(l + 1) * num_labels],
+                      [](BYTE frequent) { return frequent; });
+    galois::GAccumulator<Ulong> num_frequent_edges;
     galois::do_all(
-        galois::iterate((size_t)0, this->emb_list.size()),
-        [&](const size_t& pos) {
-          if (is_frequent_emb[pos]) {
-            auto src  = this->emb_list.get_idx(1, pos);
-            auto dst  = this->emb_list.get_vid(1, pos);
-            auto eid0 = edge_map[OrderedEdge(src, dst)];
-            auto eid1 = edge_map[OrderedEdge(dst, src)];
-            // std::cout << "src=" << src << ", dst=" << dst
-            //	<< ", eid_sd=" << eid0 << ", eid_ds=" << eid1 << "\n";
-            __sync_bool_compare_and_swap(&is_frequent_edge[eid0], 0, 1);
-            __sync_bool_compare_and_swap(&is_frequent_edge[eid1], 0, 1);
-          }
+        galois::iterate(this->graph.begin(), this->graph.end()),
+        [&](const GNode& src) {
+          for_each_frequent_neighbor(src,
+                                     [&](VertexId) { num_frequent_edges += 1; });
         },
-        galois::chunk_size<CHUNK_SIZE>(), galois::steal(),
         galois::loopname("InitFrquentEdges"));
-    std::cout << "Number of frequent edges: "
-              << count(is_frequent_edge.begin(), is_frequent_edge.end(), 1)
+    std::cout << "Number of frequent edges: " << num_frequent_edges.reduce()
               << "\n";
 
     UintList indices     = parallel_prefix_sum(is_frequent_emb);
@@ -485,44 +452,21 @@ public:
       std::cout << "{" << it->first << " --> " << it->second << std::endl;
   }
   inline void printout_agg() {
-    BoolVec support(cg_map.size());
-    int i = 0;
-    for (auto it = cg_map.begin(); it != cg_map.end(); ++it) {
-      support[i] = it->second->get_support();
-      i++;
-    }
-    i = 0;
-    for (auto it = cg_map.begin(); it != cg_map.end(); ++it) {
-      std::cout << "{" << it->first << " --> " << support[i] << std::endl;
-      i++;
-    }
+    cg_map.for_each([](const CPattern& cg, DomainSupport* support) {
+      std::cout << "{" << cg << " --> " << support->get_support() << std::endl;
+    });
   }
   inline unsigned support_count() {
     domain_support_map.clear();
     unsigned count = 0;
-    for (auto it = cg_map.begin(); it != cg_map.end(); ++it) {
-      bool support = it->second->get_support();
-      domain_support_map.insert(std::make_pair(it->first.get_id(), support));
+    cg_map.for_each([&](const CPattern& cg, DomainSupport* domain_support) {
+      bool support = domain_support->get_support();
+      domain_support_map.insert(std::make_pair(cg.get_id(), support));
       if (support)
         count++;
-    }
+    });
     return count;
   }
-  // construct edge-map for later use. May not be necessary if Galois has this
-  // support
-  void construct_edgemap() {
-    // std::cout << "Constructing edge map ...\n";
-    for (auto src : this->graph) {
-      for (auto e : this->graph.edges(src)) {
-        GNode dst = this->graph.getEdgeDst(e);
-        OrderedEdge edge(src, dst);
-        // std::cout << "src=" << src << ", dst=" << dst
-        //	<< ", eid=" << *e << "\n";
-        edge_map.insert(std::pair<OrderedEdge, unsigned>(edge, *e));
-      }
-    }
-  }
-
 protected:
   int total_num; // total number of frequent patterns
   unsigned threshold;
@@ -532,17 +476,41 @@ private:
   InitMap init_map;
   UintMap id_map;
   DomainMap domain_support_map;
-  galois::gstl::Map<OrderedEdge, unsigned> edge_map;
   std::set<std::pair<VertexId, VertexId>> freq_edge_set;
-  std::vector<unsigned> is_frequent_edge;
+  LabelIndex label_index; // neighbors of every vertex grouped by label
+  unsigned num_labels;
+  // indicate a pair of vertex labels forms a frequent single-edge pattern
+  std::vector<BYTE> is_frequent_label;
+  // indicate a label forms frequent single-edge patterns with every label
+  std::vector<BYTE> all_labels_frequent;
   InitMaps init_pattern_maps; // initialization map, only used for once, no need
                               // to clear
   LocalQpMapDomain qp_localmaps; // quick pattern local map for each thread
-  LocalCgMapDomain cg_localmaps; // canonical pattern local map for each thread
-  QpMapDomain qp_map;            // quick pattern map
+  QpMapCanonical cf_cache;       // canonical forms of the quick patterns
   CgMapDomain cg_map;            // canonical graph map
   galois::substrate::SimpleLock slock;
 
+  // calls fn(dst) for every neighbor dst of src whose label forms a frequent
+  // single-edge pattern with the label of src, skipping the neighbors of the
+  // other labels a run at a time
+  template <typename FnTy>
+  inline void for_each_frequent_neighbor(VertexId src, FnTy fn) {
+    auto src_label = this->graph.getData(src);
+    if (all_labels_frequent[src_label]) {
+      for (auto nb = label_index.neighbors_begin(src);
+           nb != label_index.neighbors_end(src); nb++)
+        fn(*nb);
+      return;
+    }
+    const BYTE* is_frequent = &is_frequent_label[src_label * num_labels];
+    for (auto r = label_index.run_begin(src); r < label_index.run_end(src);
+         r++) {
+      if (!is_frequent[label_index.get_label(r)])
+        continue;
+      for (auto nb = label_index.begin(r); nb != label_index.end(r); nb++)
+        fn(*nb);
+    }
+  }
   inline InitPattern get_init_pattern(BYTE src_label, BYTE dst_label) {
     if (src_label <= dst_label)
       return std::make_pair(src_label, dst_label);
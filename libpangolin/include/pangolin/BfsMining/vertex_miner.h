@@ -1,5 +1,8 @@
 #ifndef VERTEX_MINER_H
 #define VERTEX_MINER_H
+#include <chrono>
+#include <cmath>
+#include <random>
 #include "pangolin/miner.h"
 #include "pangolin/ptypes.h"
 #include "pangolin/quick_pattern.h"
@@ -13,8 +16,9 @@ class VertexMiner : public Miner<ElementTy, EmbeddingTy, enable_dag> {
   typedef EmbeddingList<ElementTy, EmbeddingTy> EmbeddingListTy;
 
 public:
-  VertexMiner(unsigned max_sz, int nt, unsigned nb)
-      : Miner<ElementTy, EmbeddingTy, enable_dag>(max_sz, nt), num_blocks(nb) {}
+  VertexMiner(unsigned max_sz, int nt, unsigned nb, bool df = false)
+      : Miner<ElementTy, EmbeddingTy, enable_dag>(max_sz, nt), num_blocks(nb),
+        use_dfs(df) {}
   virtual ~VertexMiner() {}
   void init_emb_list() {
     this->emb_list.init(this->graph, this->max_size, enable_dag);
@@ -63,6 +67,14 @@ public:
     // input_pid = pid;
   }
   virtual void print_output() {}
+  // estimate the counts by sampling instead of enumerating all embeddings;
+  // error is the target relative half-width of the 95% confidence interval
+  // and seconds the time budget (0 disables either)
+  void set_sampling(double error, double seconds) {
+    sample_error   = error;
+    sample_seconds = seconds;
+  }
+  bool is_sampling() { return sample_error > 0 || sample_seconds > 0; }
 
   // extension for vertex-induced motif
   inline void extend_vertex_multi(unsigned level, size_t chunk_begin,
@@ -484,6 +496,13 @@ public:
   }
 
   void tc_solver() { // edge parallel
+    if (is_sampling()) {
+      estimate([&](const size_t& id, std::vector<Ulong>& x) {
+        x[0] = this->intersect_dag(this->emb_list.get_idx(1, id),
+                                   this->emb_list.get_vid(1, id));
+      });
+      return;
+    }
     galois::do_all(
         galois::iterate((size_t)0, this->emb_list.size()),
         [&](const size_t& id) {
@@ -497,6 +516,25 @@ public:
   }
 
   void solver() {
+    if (is_sampling()) {
+      if (this->max_size >= 5 && !is_single_pattern())
+        GALOIS_DIE("sampling supports motifs of up to 4 vertices");
+      if (use_wedge && this->max_size == 4)
+        is_wedge.assign(galois::getActiveThreads(), 0);
+      estimate([&](const size_t& pos, std::vector<Ulong>& x) {
+        auto& local_counters = *(counters.getLocal());
+        std::fill(local_counters.begin(), local_counters.end(), 0);
+        EmbeddingTy emb(2);
+        get_embedding(1, pos, emb);
+        dfs_extend(1, emb);
+        std::copy(local_counters.begin(), local_counters.end(), x.begin());
+      });
+      return;
+    }
+    if (use_dfs) {
+      dfs_solver();
+      return;
+    }
     size_t num          = this->emb_list.size();
     size_t chunk_length = (num - 1) / num_blocks + 1;
     // std::cout << "number of single-edge embeddings: " << num << "\n";
@@ -530,8 +568,183 @@ public:
     }
   }
 
+  // depth-first extension: every single-edge embedding is extended all the
+  // way to max_size vertices by one thread, so only the current path of each
+  // thread is kept instead of all the embeddings of every level
+  void dfs_solver() {
+    if (use_wedge && this->max_size == 4)
+      is_wedge.assign(galois::getActiveThreads(), 0);
+    galois::do_all(
+        galois::iterate((size_t)0, this->emb_list.size()),
+        [&](const size_t& pos) {
+          EmbeddingTy emb(2);
+          get_embedding(1, pos, emb);
+          dfs_extend(1, emb);
+        },
+        galois::chunk_size<CHUNK_SIZE>(), galois::steal(),
+        galois::loopname("Extending-dfs"));
+    galois::on_each([&](unsigned tid, unsigned) {
+      auto& local_counters = *(counters.getLocal(tid));
+      for (int i = 0; i < this->npatterns; i++)
+        this->accumulators[i] += local_counters[i];
+    });
+    if (this->max_size >= 5 && !is_single_pattern()) {
+      merge_qp_map();
+      canonical_reduce();
+      merge_cg_map();
+    }
+  }
+
+  // extends emb (level + 1 vertices) with the same rules as the BFS
+  // extension of the corresponding mode, recursing instead of materializing
+  void dfs_extend(unsigned level, EmbeddingTy& emb) {
+    auto& local_counters = *(counters.getLocal());
+    unsigned n           = level + 1;
+    if (use_match_order || is_single_pattern()) {
+      unsigned i = use_match_order ? API::getExtendableVertex(n) : level;
+      auto src   = emb.get_vertex(i);
+      for (auto e : this->graph.edges(src)) {
+        GNode dst = this->graph.getEdgeDst(e);
+        if (use_match_order ? API::toAdd(n, this->graph, emb, src, dst)
+                            : API::toAdd(n, this->graph, emb, i, dst)) {
+          if (level < this->max_size - 2) {
+            emb.push_back(ElementTy(dst));
+            dfs_extend(level + 1, emb);
+            emb.pop_back();
+          } else {
+            local_counters[0] += 1;
+          }
+        }
+      }
+      return;
+    }
+
+    unsigned tid          = galois::substrate::ThreadPool::getTID();
+    StrQpMapFreq* qp_lmap = nullptr;
+    if (n >= 4)
+      qp_lmap = qp_localmaps.getLocal();
+    unsigned pid = emb.get_pid();
+    for (unsigned i = 0; i < n; ++i) {
+      if (!API::toExtend(n, emb, i))
+        continue;
+      auto src = emb.get_vertex(i);
+      for (auto e : this->graph.edges(src)) {
+        GNode dst = this->graph.getEdgeDst(e);
+        if (!API::toAdd(n, this->graph, emb, i, dst))
+          continue;
+        if (n < this->max_size - 1) {
+          unsigned child_pid = pid;
+          if (!is_single && n == 2 && this->max_size == 4) {
+            if (use_wedge)
+              is_wedge[tid] = 0;
+            child_pid = this->find_motif_pattern_id(n, i, dst, emb, tid);
+          }
+          emb.push_back(ElementTy(dst));
+          emb.set_pid(child_pid);
+          dfs_extend(level + 1, emb);
+          emb.pop_back();
+          emb.set_pid(pid);
+        } else { // do reduction
+          if (n < 4) {
+            local_counters[this->find_motif_pattern_id(n, i, dst, emb, tid)] +=
+                1;
+          } else
+            quick_reduce(n, i, dst, emb, qp_lmap);
+        }
+      }
+    }
+  }
+
+  // draws single-edge embeddings uniformly at random (with replacement, one
+  // RNG per thread) and scales the mean of their counts, computed by
+  // count_root(pos, x), by the number of single-edge embeddings; the number
+  // of samples doubles until every nonzero estimate is within sample_error
+  // at 95% confidence or sample_seconds have passed, and once the next batch
+  // would cost as much as enumerating every root the counts are made exact
+  template <typename CountFn>
+  void estimate(CountFn count_root) {
+    size_t num_roots = this->emb_list.size();
+    galois::substrate::PerThreadStorage<std::mt19937_64> rngs;
+    galois::substrate::PerThreadStorage<std::vector<Ulong>> root_counts;
+    galois::substrate::PerThreadStorage<std::vector<double>> moments;
+    galois::on_each([&](unsigned tid, unsigned) {
+      rngs.getLocal()->seed(tid + 1);
+      root_counts.getLocal()->resize(npatterns);
+      moments.getLocal()->assign(2 * npatterns, 0);
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<double> estimates(npatterns, 0), half_widths(npatterns, 0);
+    size_t num_samples = 0, batch = 1024;
+    while (num_roots > 0) {
+      bool exact = num_samples + batch >= num_roots;
+      if (exact) {
+        num_samples = batch = num_roots;
+        galois::on_each([&](unsigned, unsigned) {
+          auto& m = *moments.getLocal();
+          std::fill(m.begin(), m.end(), 0);
+        });
+      }
+      galois::do_all(
+          galois::iterate((size_t)0, batch),
+          [&](const size_t& id) {
+            auto& x = *root_counts.getLocal();
+            std::fill(x.begin(), x.end(), 0);
+            std::uniform_int_distribution<size_t> pick(0, num_roots - 1);
+            count_root(exact ? id : pick(*rngs.getLocal()), x);
+            auto& m = *moments.getLocal();
+            for (int i = 0; i < npatterns; i++) {
+              m[i] += x[i];
+              m[npatterns + i] += double(x[i]) * x[i];
+            }
+          },
+          galois::steal(), galois::loopname("Sampling"));
+      if (!exact)
+        num_samples += batch;
+
+      bool found = false, converged = true;
+      for (int i = 0; i < npatterns; i++) {
+        double sum = 0, squares = 0;
+        for (unsigned tid = 0; tid < galois::getActiveThreads(); tid++) {
+          sum += (*moments.getRemote(tid))[i];
+          squares += (*moments.getRemote(tid))[npatterns + i];
+        }
+        double mean = sum / num_samples;
+        double var  = std::max(0.0, (squares - num_samples * mean * mean) /
+                                       (num_samples - 1));
+        estimates[i]   = exact ? sum : num_roots * mean;
+        half_widths[i] =
+            exact ? 0 : 1.96 * num_roots * std::sqrt(var / num_samples);
+        if (estimates[i] > 0) {
+          found = true;
+          if (half_widths[i] > sample_error * estimates[i])
+            converged = false;
+        }
+      }
+      std::chrono::duration<double> elapsed =
+          std::chrono::steady_clock::now() - start;
+      if (exact || (sample_error > 0 && found && converged) ||
+          (sample_seconds > 0 && elapsed.count() >= sample_seconds))
+        break;
+      batch = num_samples;
+    }
+
+    std::cout << "\tsampled " << num_samples << " of " << num_roots
+              << " single-edge embeddings\n";
+    for (int i = 0; i < npatterns; i++) {
+      accumulators[i].reset();
+      accumulators[i] += std::llround(estimates[i]);
+      std::cout << "\tpattern " << i << ": " << std::llround(estimates[i])
+                << " +- " << std::llround(half_widths[i])
+                << " (95% confidence)\n";
+    }
+  }
+
 private:
   unsigned num_blocks;
+  bool use_dfs; // extend depth-first instead of level by level
+  double sample_error   = 0;
+  double sample_seconds = 0;
   StrQpMapFreq qp_map; // quick patterns map for counting the frequency
   StrCgMapFreq cg_map; // canonical graph map for couting the frequency
   LocalStrQpMapFreq qp_localmaps; // quick patterns local map for each thread
@@ -0,0 +1,103 @@
+#ifndef BITMAP_GRAPH_H
+#define BITMAP_GRAPH_H
+/**
+ * Local subgraph for clique listing on a DAG (an oriented graph with sorted
+ * adjacency lists). The out-neighbors of a root vertex are relabeled
+ * 0 .. n-1 and the subgraph they induce is kept as one adjacency bitmap row
+ * per local vertex. The cliques that contain the root as their first vertex
+ * are then listed with word-wise AND and popcount on the rows instead of
+ * intersecting adjacency lists of the whole graph at every level.
+ */
+
+#include <vector>
+
+#include "galois/SetIntersection.h"
+#include "pangolin/gtypes.h"
+
+class BitmapGraph {
+public:
+  BitmapGraph() : num_vertices(0), num_words(0) {}
+  ~BitmapGraph() {}
+
+  //! Builds the subgraph induced by the out-neighbors of root in dag
+  void build(PangolinGraph& dag, GNode root) {
+    auto begin   = dag.edge_begin(root);
+    num_vertices = std::distance(begin, dag.edge_end(root));
+    num_words    = (num_vertices + 63) / 64;
+    rows.assign(size_t(num_vertices) * num_words, 0);
+    const uint32_t* vertices = dag.getEdgeDstPtr(begin);
+    buffer.resize(num_vertices);
+    for (unsigned i = 0; i < num_vertices; i++) {
+      auto u   = vertices[i];
+      auto ube = dag.edge_begin(u);
+      size_t num_common =
+          galois::intersection::collect(dag.getEdgeDstPtr(ube),
+                                        std::distance(ube, dag.edge_end(u)),
+                                        vertices, num_vertices, buffer.data());
+      // both lists are sorted, so the local IDs are found with one scan
+      uint64_t* row = &rows[size_t(i) * num_words];
+      unsigned j    = 0;
+      for (size_t c = 0; c < num_common; c++) {
+        while (vertices[j] != buffer[c])
+          j++;
+        row[j / 64] |= uint64_t(1) << (j % 64);
+      }
+    }
+  }
+
+  //! Number of k-cliques of the local subgraph, i.e. the (k+1)-cliques of the
+  //! DAG whose first vertex is the root
+  Ulong count_cliques(unsigned k) {
+    if (k == 0)
+      return 1;
+    if (k > num_vertices)
+      return 0;
+    candidates.resize(size_t(k) * num_words);
+    uint64_t* all = candidates.data();
+    for (unsigned w = 0; w < num_words; w++)
+      all[w] = ~uint64_t(0);
+    if (num_vertices % 64)
+      all[num_words - 1] = (uint64_t(1) << (num_vertices % 64)) - 1;
+    return count(k, all);
+  }
+
+  unsigned size() const { return num_vertices; }
+
+private:
+  unsigned num_vertices;
+  unsigned num_words;
+  std::vector<uint64_t> rows;       // num_vertices rows of num_words words
+  std::vector<uint64_t> candidates; // one candidate set per remaining level
+  std::vector<uint32_t> buffer;
+
+  // counts the k-cliques among the vertices in cand; the candidate sets of the
+  // deeper levels follow cand in the same buffer
+  Ulong count(unsigned k, uint64_t* cand) {
+    if (k == 1)
+      return popcount(cand);
+    uint64_t* next = cand + num_words;
+    Ulong num      = 0;
+    for (unsigned w = 0; w < num_words; w++) {
+      for (uint64_t bits = cand[w]; bits; bits &= bits - 1) {
+        unsigned v           = w * 64 + __builtin_ctzll(bits);
+        const uint64_t* row  = &rows[size_t(v) * num_words];
+        unsigned num_members = 0;
+        for (unsigned i = 0; i < num_words; i++) {
+          next[i] = cand[i] & row[i];
+          num_members += __builtin_popcountll(next[i]);
+        }
+        if (num_members >= k - 1)
+          num += count(k - 1, next);
+      }
+    }
+    return num;
+  }
+  Ulong popcount(const uint64_t* set) const {
+    Ulong num = 0;
+    for (unsigned w = 0; w < num_words; w++)
+      num += __builtin_popcountll(set[w]);
+    return num;
+  }
+};
+
+#endif // BITMAP_GRAPH_H
@@ -0,0 +1,101 @@
+#ifndef LABEL_INDEX_H
+#define LABEL_INDEX_H
+/**
+ * Label-partitioned adjacency of a labeled graph. The neighbors of every
+ * vertex are grouped by label into runs (sorted by label, and by ID within a
+ * run) and every run records its label, so that a miner that only wants
+ * neighbors of some labels can skip the runs of the other labels instead of
+ * checking neighbors one by one.
+ */
+
+#include "pangolin/scan.h"
+
+class LabelIndex {
+public:
+  LabelIndex() : max_label(0) {}
+  ~LabelIndex() {}
+  bool empty() const { return run_offsets.empty(); }
+  void clear() {
+    neighbors.clear();
+    run_offsets.clear();
+    runs.clear();
+  }
+
+  void build(PangolinGraph& g) {
+    size_t num_vertices = g.size();
+    neighbors.resize(g.sizeEdges());
+    std::vector<IndexT> num_runs(num_vertices, 0);
+    galois::GReduceMax<uint32_t> label_max;
+    galois::do_all(
+        galois::iterate(g.begin(), g.end()),
+        [&](const GNode& v) {
+          label_max.update(g.getData(v));
+          IndexT begin = *g.edge_begin(v);
+          IndexT end   = *g.edge_end(v);
+          for (auto e : g.edges(v))
+            neighbors[*e] = g.getEdgeDst(e);
+          std::sort(neighbors.begin() + begin, neighbors.begin() + end,
+                    [&](VertexId a, VertexId b) {
+                      auto la = g.getData(a);
+                      auto lb = g.getData(b);
+                      return la < lb || (la == lb && a < b);
+                    });
+          for (IndexT i = begin; i < end; i++)
+            if (i == begin ||
+                g.getData(neighbors[i]) != g.getData(neighbors[i - 1]))
+              num_runs[v]++;
+        },
+        galois::steal(), galois::loopname("LabelIndexSort"));
+    max_label   = label_max.reduce();
+    run_offsets = PrefixSum(num_runs);
+    // the sentinel run closes the last run of the last vertex with neighbors
+    runs.resize(run_offsets[num_vertices] + 1);
+    runs.back() = Run{0, (IndexT)g.sizeEdges()};
+    galois::do_all(
+        galois::iterate(g.begin(), g.end()),
+        [&](const GNode& v) {
+          IndexT r     = run_offsets[v];
+          IndexT begin = *g.edge_begin(v);
+          IndexT end   = *g.edge_end(v);
+          for (IndexT i = begin; i < end; i++) {
+            auto label = g.getData(neighbors[i]);
+            if (i == begin || label != g.getData(neighbors[i - 1]))
+              runs[r++] = Run{label, i};
+          }
+        },
+        galois::loopname("LabelIndexRuns"));
+  }
+
+  //! Runs of the neighbors of v are [run_begin(v), run_end(v))
+  IndexT run_begin(VertexId v) const { return run_offsets[v]; }
+  IndexT run_end(VertexId v) const { return run_offsets[v + 1]; }
+  uint32_t get_label(IndexT r) const { return runs[r].label; }
+  //! Neighbors in run r; a run ends where the next one begins, since the runs
+  //! of consecutive vertices are contiguous
+  const VertexId* begin(IndexT r) const {
+    return neighbors.data() + runs[r].begin;
+  }
+  const VertexId* end(IndexT r) const {
+    return neighbors.data() + runs[r + 1].begin;
+  }
+  //! All the neighbors of v, grouped by label
+  const VertexId* neighbors_begin(VertexId v) const {
+    return neighbors.data() + runs[run_offsets[v]].begin;
+  }
+  const VertexId* neighbors_end(VertexId v) const {
+    return neighbors.data() + runs[run_offsets[v + 1]].begin;
+  }
+  uint32_t get_max_label() const { return max_label; }
+
+private:
+  struct Run {
+    uint32_t label;
+    IndexT begin; // first neighbor of the run
+  };
+  std::vector<VertexId> neighbors; // same offsets as the edges of the graph
+  std::vector<IndexT> run_offsets;
+  std::vector<Run> runs;
+  uint32_t max_label;
+};
+
+#endif // LABEL_INDEX_H
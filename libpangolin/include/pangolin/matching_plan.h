@@ -0,0 +1,383 @@
+#ifndef MATCHING_PLAN_H
+#define MATCHING_PLAN_H
+/**
+ * Search plans for listing the embeddings of an arbitrary small connected
+ * pattern (query) graph. A MatchingPlan fixes
+ *  - a matching order: every pattern vertex after the first is adjacent to
+ *    an earlier one, most-constrained (most earlier neighbors) first;
+ *  - symmetry-breaking restrictions (emb[a] < emb[b]) derived from the
+ *    pattern's automorphism group, so every subgraph is found exactly once;
+ *  - the set-intersection schedule of every level: the candidates of level
+ *    i are the common neighbors of the earlier levels it is adjacent to.
+ *
+ * PlanExecutor runs a plan as nested loops over a symmetric data graph with
+ * sorted adjacency lists. Patterns of up to 6 vertices use a loop nest
+ * unrolled at compile time; larger ones are interpreted level by level.
+ */
+
+#include <algorithm>
+#include <ostream>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "galois/SetIntersection.h"
+#include "pangolin/gtypes.h"
+#include "pangolin/quick_pattern.h"
+#include "pangolin/canonical_graph.h"
+
+class MatchingPlan {
+public:
+  //! Largest supported pattern
+  static constexpr unsigned MAX_SIZE = 8;
+
+  //! Constraints on the vertex matched at one level (entries are levels)
+  struct Level {
+    std::vector<unsigned> connected;    // adjacent: intersect neighborhoods
+    std::vector<unsigned> disconnected; // distinct (and non-adjacent if
+                                        // induced)
+    std::vector<unsigned> greater_than; // emb[level] > emb[j]
+    std::vector<unsigned> less_than;    // emb[level] < emb[j]
+  };
+
+  /**
+   * @param n number of pattern vertices
+   * @param edges undirected pattern edges over vertices 0 .. n-1
+   * @param induced if true, match vertex-induced subgraphs instead of
+   * edge-induced ones
+   */
+  MatchingPlan(unsigned n,
+               const std::vector<std::pair<unsigned, unsigned>>& edges,
+               bool induced = false)
+      : nv(n), is_induced_(induced) {
+    init(edges);
+  }
+
+  //! Builds the plan of a pattern read with util::read_graph
+  MatchingPlan(PangolinGraph& pattern, bool induced = false)
+      : nv(pattern.size()), is_induced_(induced) {
+    std::vector<std::pair<unsigned, unsigned>> edges;
+    for (auto u : pattern)
+      for (auto e : pattern.edges(u)) {
+        unsigned v = pattern.getEdgeDst(e);
+        if (u < v)
+          edges.push_back(std::make_pair(u, v));
+      }
+    init(edges);
+  }
+
+  unsigned size() const { return nv; }
+  bool is_induced() const { return is_induced_; }
+  //! order[i] is the pattern vertex matched at level i
+  const std::vector<unsigned>& get_order() const { return order; }
+  const Level& get_level(unsigned level) const { return levels[level]; }
+  size_t num_automorphisms() const { return automorphisms.size(); }
+
+  void print(std::ostream& os) const {
+    os << "matching order:";
+    for (auto u : order)
+      os << " " << u;
+    os << "\nautomorphisms: " << automorphisms.size() << "\n";
+    for (unsigned i = 1; i < nv; i++) {
+      os << "level " << i << ": intersect";
+      for (auto j : levels[i].connected)
+        os << " N(" << j << ")";
+      for (auto j : levels[i].greater_than)
+        os << ", > " << j;
+      for (auto j : levels[i].less_than)
+        os << ", < " << j;
+      os << "\n";
+    }
+  }
+
+private:
+  unsigned nv;
+  bool is_induced_;
+  std::vector<std::vector<bool>> adj;
+  std::vector<unsigned> order;
+  std::vector<Level> levels;
+  std::vector<std::vector<unsigned>> automorphisms;
+
+  void init(const std::vector<std::pair<unsigned, unsigned>>& edges) {
+    if (nv < 2 || nv > MAX_SIZE)
+      GALOIS_DIE("pattern must have 2 to ", MAX_SIZE, " vertices");
+    adj.assign(nv, std::vector<bool>(nv, false));
+    for (auto& edge : edges) {
+      if (edge.first >= nv || edge.second >= nv || edge.first == edge.second)
+        GALOIS_DIE("invalid pattern edge ", edge.first, " ", edge.second);
+      adj[edge.first][edge.second] = true;
+      adj[edge.second][edge.first] = true;
+    }
+    compute_order();
+    compute_automorphisms();
+    compute_levels();
+  }
+
+  unsigned degree(unsigned u) const {
+    return std::count(adj[u].begin(), adj[u].end(), true);
+  }
+
+  // greedy: start from a max-degree vertex, then always take the vertex
+  // with the most matched neighbors (ties: higher degree, lower id)
+  void compute_order() {
+    std::vector<bool> matched(nv, false);
+    for (unsigned i = 0; i < nv; i++) {
+      unsigned best = nv, best_conn = 0, best_deg = 0;
+      for (unsigned u = 0; u < nv; u++) {
+        if (matched[u])
+          continue;
+        unsigned conn = 0;
+        for (auto v : order)
+          conn += adj[u][v];
+        if (i > 0 && conn == 0)
+          continue;
+        unsigned deg = degree(u);
+        if (best == nv || conn > best_conn ||
+            (conn == best_conn && deg > best_deg)) {
+          best      = u;
+          best_conn = conn;
+          best_deg  = deg;
+        }
+      }
+      if (best == nv)
+        GALOIS_DIE("pattern must be connected");
+      matched[best] = true;
+      order.push_back(best);
+    }
+  }
+
+  static void add_generator(void* param, const unsigned n,
+                            const unsigned* aut) {
+    auto* generators = static_cast<std::vector<std::vector<unsigned>>*>(param);
+    generators->push_back(std::vector<unsigned>(aut, aut + n));
+  }
+
+  // bliss gives generators of the group; patterns are tiny, so close them
+  // into the full group
+  void compute_automorphisms() {
+    bliss::Graph bg(nv);
+    for (unsigned u = 0; u < nv; u++)
+      for (unsigned v = u + 1; v < nv; v++)
+        if (adj[u][v])
+          bg.add_edge(u, v, std::make_pair(0u, 0u));
+    std::vector<std::vector<unsigned>> generators;
+    bliss::Stats stats;
+    bg.find_automorphisms(stats, add_generator, &generators);
+
+    std::vector<unsigned> identity(nv);
+    for (unsigned u = 0; u < nv; u++)
+      identity[u] = u;
+    std::set<std::vector<unsigned>> group{identity};
+    std::vector<std::vector<unsigned>> frontier{identity};
+    while (!frontier.empty()) {
+      auto g = frontier.back();
+      frontier.pop_back();
+      for (auto& s : generators) {
+        std::vector<unsigned> h(nv);
+        for (unsigned u = 0; u < nv; u++)
+          h[u] = s[g[u]];
+        if (group.insert(h).second)
+          frontier.push_back(h);
+      }
+    }
+    automorphisms.assign(group.begin(), group.end());
+  }
+
+  // symmetry breaking: following the matching order, vertex u must get the
+  // smallest data vertex of its orbit under the automorphisms that fix the
+  // vertices before it
+  void compute_levels() {
+    std::vector<unsigned> level_of(nv);
+    for (unsigned i = 0; i < nv; i++)
+      level_of[order[i]] = i;
+    levels.assign(nv, Level());
+    for (unsigned i = 1; i < nv; i++)
+      for (unsigned j = 0; j < i; j++) {
+        if (adj[order[i]][order[j]])
+          levels[i].connected.push_back(j);
+        else
+          levels[i].disconnected.push_back(j);
+      }
+
+    auto stabilizer = automorphisms;
+    for (auto u : order) {
+      if (stabilizer.size() == 1)
+        break;
+      std::set<unsigned> orbit;
+      for (auto& g : stabilizer)
+        orbit.insert(g[u]);
+      for (auto w : orbit) {
+        if (w == u)
+          continue;
+        if (level_of[u] < level_of[w])
+          levels[level_of[w]].greater_than.push_back(level_of[u]);
+        else
+          levels[level_of[u]].less_than.push_back(level_of[w]);
+      }
+      stabilizer.erase(
+          std::remove_if(stabilizer.begin(), stabilizer.end(),
+                         [&](const std::vector<unsigned>& g) {
+                           return g[u] != u;
+                         }),
+          stabilizer.end());
+    }
+  }
+};
+
+class PlanExecutor {
+public:
+  PlanExecutor(PangolinGraph& g, const MatchingPlan& p) : graph(g), plan(p) {}
+
+  //! Counts the subgraphs of the data graph that match the pattern (each
+  //! exactly once); one task per data vertex matched at level 0
+  Ulong count() {
+    size_t max_degree = 0;
+    for (auto v : graph)
+      max_degree = std::max(max_degree, degree(v));
+    galois::on_each([&](unsigned, unsigned) {
+      auto& buffers = *local_buffers.getLocal();
+      buffers.resize(2 * plan.size());
+      for (auto& buffer : buffers)
+        buffer.resize(max_degree);
+    });
+
+    UlongAccu total;
+    galois::do_all(
+        galois::iterate(graph.begin(), graph.end()),
+        [&](const GNode& v) {
+          auto& buffers = *local_buffers.getLocal();
+          VertexId emb[MatchingPlan::MAX_SIZE];
+          emb[0] = v;
+          switch (plan.size()) {
+          case 3:
+            total += extend_fixed<3, 1>(emb, buffers);
+            break;
+          case 4:
+            total += extend_fixed<4, 1>(emb, buffers);
+            break;
+          case 5:
+            total += extend_fixed<5, 1>(emb, buffers);
+            break;
+          case 6:
+            total += extend_fixed<6, 1>(emb, buffers);
+            break;
+          default:
+            total += extend(1, emb, buffers);
+          }
+        },
+        galois::chunk_size<1>(), galois::steal(),
+        galois::loopname("PlanMatching"));
+    return total.reduce();
+  }
+
+private:
+  typedef std::vector<std::vector<VertexId>> Buffers;
+
+  PangolinGraph& graph;
+  const MatchingPlan& plan;
+  galois::substrate::PerThreadStorage<Buffers> local_buffers;
+
+  size_t degree(VertexId v) {
+    return *graph.edge_end(v) - *graph.edge_begin(v);
+  }
+  const VertexId* neighbors(VertexId v) {
+    return graph.getEdgeDstPtr(graph.edge_begin(v));
+  }
+  bool is_connected(VertexId a, VertexId b) {
+    if (degree(a) > degree(b))
+      std::swap(a, b);
+    return std::binary_search(neighbors(a), neighbors(a) + degree(a), b);
+  }
+
+  // sets [begin, end) to the sorted candidates of level: the common
+  // neighbors of the connected levels (smallest neighborhood first) within
+  // the symmetry-breaking bounds
+  void candidates(unsigned level, const VertexId* emb, Buffers& buffers,
+                  const VertexId*& begin, const VertexId*& end) {
+    auto& lv = plan.get_level(level);
+    unsigned sets[MatchingPlan::MAX_SIZE];
+    unsigned num_sets = lv.connected.size();
+    std::copy(lv.connected.begin(), lv.connected.end(), sets);
+    for (unsigned a = 1; a < num_sets; a++)
+      for (unsigned b = a;
+           b > 0 && degree(emb[sets[b]]) < degree(emb[sets[b - 1]]); b--)
+        std::swap(sets[b], sets[b - 1]);
+    const VertexId* set = neighbors(emb[sets[0]]);
+    size_t size         = degree(emb[sets[0]]);
+    for (unsigned k = 1; k < num_sets && size > 0; k++) {
+      VertexId* out = buffers[2 * level + (k & 1)].data();
+      size = galois::intersection::collect(set, size, neighbors(emb[sets[k]]),
+                                           degree(emb[sets[k]]), out);
+      set  = out;
+    }
+    begin = set;
+    end   = set + size;
+    for (auto j : lv.greater_than)
+      begin = std::upper_bound(begin, end, emb[j]);
+    for (auto j : lv.less_than)
+      end = std::lower_bound(begin, end, emb[j]);
+    if (end < begin)
+      end = begin;
+  }
+
+  bool is_admissible(unsigned level, const VertexId* emb, VertexId v) {
+    for (auto j : plan.get_level(level).disconnected)
+      if (v == emb[j] || (plan.is_induced() && is_connected(emb[j], v)))
+        return false;
+    return true;
+  }
+
+  Ulong count_last(unsigned level, const VertexId* emb, Buffers& buffers) {
+    const VertexId *begin, *end;
+    candidates(level, emb, buffers, begin, end);
+    auto& disconnected = plan.get_level(level).disconnected;
+    if (!plan.is_induced()) {
+      // only distinctness to check: drop the matched vertices in range
+      Ulong num = end - begin;
+      for (auto j : disconnected)
+        num -= std::binary_search(begin, end, emb[j]);
+      return num;
+    }
+    Ulong num = 0;
+    for (auto it = begin; it != end; ++it)
+      num += is_admissible(level, emb, *it);
+    return num;
+  }
+
+  // interpreted loop nest
+  Ulong extend(unsigned level, VertexId* emb, Buffers& buffers) {
+    if (level + 1 == plan.size())
+      return count_last(level, emb, buffers);
+    const VertexId *begin, *end;
+    candidates(level, emb, buffers, begin, end);
+    Ulong num = 0;
+    for (auto it = begin; it != end; ++it) {
+      if (!is_admissible(level, emb, *it))
+        continue;
+      emb[level] = *it;
+      num += extend(level + 1, emb, buffers);
+    }
+    return num;
+  }
+
+  // the same loop nest unrolled for a pattern of size K
+  template <unsigned K, unsigned L>
+  Ulong extend_fixed(VertexId* emb, Buffers& buffers) {
+    if constexpr (L + 1 == K) {
+      return count_last(L, emb, buffers);
+    } else {
+      const VertexId *begin, *end;
+      candidates(L, emb, buffers, begin, end);
+      Ulong num = 0;
+      for (auto it = begin; it != end; ++it) {
+        if (!is_admissible(L, emb, *it))
+          continue;
+        emb[L] = *it;
+        num += extend_fixed<K, L + 1>(emb, buffers);
+      }
+      return num;
+    }
+  }
+};
+
+#endif // MATCHING_PLAN_H
@@ -0,0 +1,74 @@
+#ifndef PATTERN_MAP_H
+#define PATTERN_MAP_H
+#include "pangolin/gtypes.h"
+
+// Hash map of patterns that all threads can update at the same time. Keys
+// are spread over shards by their hash and every shard has its own lock, so
+// threads only wait for each other when their patterns land in the same
+// shard. Values are never moved once inserted (until clear), so pointers
+// returned by find/insert stay valid while other threads keep inserting.
+template <typename KeyTy, typename ValueTy>
+class PatternMap {
+  typedef std::unordered_map<KeyTy, ValueTy> MapTy;
+  struct Shard {
+    galois::substrate::SimpleLock lock;
+    MapTy map;
+  };
+
+public:
+  PatternMap(unsigned num_shards = 1024) : shards(num_shards) {}
+  ~PatternMap() {}
+  // returns the value of key, or nullptr if key is not in the map
+  ValueTy* find(const KeyTy& key) {
+    Shard& shard = get_shard(key);
+    shard.lock.lock();
+    auto it       = shard.map.find(key);
+    ValueTy* item = it == shard.map.end() ? nullptr : &it->second;
+    shard.lock.unlock();
+    return item;
+  }
+  // inserts (key, value) unless key is already in the map; returns the value
+  // kept in the map and whether it was inserted
+  std::pair<ValueTy*, bool> insert(const KeyTy& key, const ValueTy& value) {
+    Shard& shard = get_shard(key);
+    shard.lock.lock();
+    auto res = shard.map.emplace(key, value);
+    shard.lock.unlock();
+    return std::make_pair(&res.first->second, res.second);
+  }
+  // calls fn(value, inserted) while holding the lock of the shard of key; the
+  // value is default-constructed if key was not in the map
+  template <typename FnTy>
+  void update(const KeyTy& key, FnTy fn) {
+    Shard& shard = get_shard(key);
+    shard.lock.lock();
+    auto res = shard.map.emplace(key, ValueTy());
+    fn(res.first->second, res.second);
+    shard.lock.unlock();
+  }
+  // the following must not run concurrently with updates
+  template <typename FnTy>
+  void for_each(FnTy fn) {
+    for (auto& shard : shards)
+      for (auto& element : shard.map)
+        fn(element.first, element.second);
+  }
+  size_t size() const {
+    size_t num = 0;
+    for (auto& shard : shards)
+      num += shard.map.size();
+    return num;
+  }
+  void clear() {
+    for (auto& shard : shards)
+      shard.map.clear();
+  }
+
+private:
+  std::vector<Shard> shards;
+  Shard& get_shard(const KeyTy& key) {
+    return shards[std::hash<KeyTy>()(key) % shards.size()];
+  }
+};
+
+#endif // PATTERN_MAP_H
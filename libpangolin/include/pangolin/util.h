@@ -4,6 +4,8 @@
 #include "pangolin/scan.h"
 #include "pangolin/mgraph.h"
 #include "pangolin/res_man.h"
+#include "galois/AtomicHelpers.h"
+#include "galois/ParallelSTL.h"
 
 namespace util {
 
@@ -138,10 +140,206 @@ unsigned orientation(PangolinGraph& og, PangolinGraph& g) {
   return max_degree;
 }
 
+// degeneracy (k-core) ordering by parallel peeling, in the same way as the
+// k-core app: every round removes all the remaining vertices whose degree is
+// at most k, and k is raised to the smallest remaining degree once a round
+// leaves none to remove. Vertices are numbered in removal order (by old ID
+// within a round), so orienting each edge towards the larger new ID gives
+// every vertex at most k out-neighbors, i.e. the DAG max out-degree is the
+// degeneracy of the graph
+std::vector<IndexT> CoreRanking(PangolinGraph& og) {
+  galois::StatTimer Tcore("CoreRanking");
+  Tcore.start();
+  size_t num_vertices = og.size();
+  std::vector<std::atomic<uint32_t>> degrees(num_vertices);
+  std::vector<BYTE> removed(num_vertices, 0);
+  std::vector<IndexT> new_ids(num_vertices);
+  galois::do_all(
+      galois::iterate(og.begin(), og.end()),
+      [&](const auto& src) {
+        degrees[src] = std::distance(og.edge_begin(src), og.edge_end(src));
+      },
+      galois::loopname("getCoreDegrees"));
+
+  galois::InsertBag<GNode>* alive   = new galois::InsertBag<GNode>;
+  galois::InsertBag<GNode>* remains = new galois::InsertBag<GNode>;
+  galois::InsertBag<GNode> next;
+  galois::do_all(
+      galois::iterate(og.begin(), og.end()),
+      [&](const auto& src) { alive->push(src); }, galois::no_stats());
+  unsigned k           = 0;
+  IndexT num_removed   = 0;
+  std::vector<GNode> frontier;
+  while (num_removed < num_vertices) {
+    if (next.empty()) {
+      // raise k and collect the vertices to peel; removed vertices are
+      // dropped from the alive list on the way
+      galois::GReduceMin<unsigned> min_degree;
+      remains->clear();
+      galois::do_all(
+          galois::iterate(*alive),
+          [&](const GNode& v) {
+            if (!removed[v]) {
+              min_degree.update(degrees[v]);
+              remains->push(v);
+            }
+          },
+          galois::loopname("CoreMinDegree"));
+      std::swap(alive, remains);
+      k = std::max(k, min_degree.reduce());
+      galois::do_all(
+          galois::iterate(*alive),
+          [&](const GNode& v) {
+            if (degrees[v] <= k)
+              next.push(v);
+          },
+          galois::loopname("CoreFrontier"));
+    }
+    frontier.assign(next.begin(), next.end());
+    next.clear();
+    galois::ParallelSTL::sort(frontier.begin(), frontier.end());
+    galois::do_all(
+        galois::iterate((size_t)0, frontier.size()),
+        [&](const size_t& i) {
+          new_ids[frontier[i]] = num_removed + i;
+          removed[frontier[i]] = 1;
+        },
+        galois::no_stats());
+    num_removed += frontier.size();
+    galois::do_all(
+        galois::iterate(frontier),
+        [&](const GNode& v) {
+          for (auto e : og.edges(v)) {
+            auto dst = og.getEdgeDst(e);
+            if (removed[dst])
+              continue;
+            // exactly one thread sees the degree go from k+1 to k
+            if (galois::atomicSubtract(degrees[dst], 1u) == k + 1)
+              next.push(dst);
+          }
+        },
+        galois::steal(), galois::loopname("CorePeeling"));
+  }
+  delete alive;
+  delete remains;
+  galois::gPrint("Degeneracy: ", k, "\n");
+  Tcore.stop();
+  return new_ids;
+}
+
+// relabel vertices by the degeneracy ordering and orient each edge towards
+// the vertex peeled later; the oriented CSR is built in parallel in the order
+// of the new IDs. Returns the max out-degree of the DAG
+unsigned CoreOrientation(PangolinGraph& og, PangolinGraph& g) {
+  galois::StatTimer Tdag("DAG");
+  Tdag.start();
+  size_t num_vertices         = og.size();
+  std::vector<IndexT> new_ids = CoreRanking(og);
+  std::vector<IndexT> old_ids(num_vertices);
+  galois::do_all(
+      galois::iterate(og.begin(), og.end()),
+      [&](const auto& src) { old_ids[new_ids[src]] = src; },
+      galois::no_stats());
+
+  std::vector<IndexT> new_degrees(num_vertices, 0);
+  galois::do_all(
+      galois::iterate((size_t)0, num_vertices),
+      [&](const size_t& v) {
+        auto src = old_ids[v];
+        for (auto e : og.edges(src))
+          if (new_ids[og.getEdgeDst(e)] > v)
+            new_degrees[v]++;
+      },
+      galois::loopname("getNewDegrees"));
+  unsigned max_degree =
+      *(std::max_element(new_degrees.begin(), new_degrees.end()));
+  std::vector<IndexT> offsets = PrefixSum(new_degrees);
+  assert(offsets[num_vertices] == og.sizeEdges() / 2);
+
+  g.allocateFrom(num_vertices, offsets[num_vertices]);
+  g.constructNodes();
+  galois::do_all(
+      galois::iterate((size_t)0, num_vertices),
+      [&](const size_t& v) {
+        g.getData(v)   = 0;
+        auto row_begin = offsets[v];
+        g.fixEndEdge(v, row_begin + new_degrees[v]);
+        IndexT offset = 0;
+        for (auto e : og.edges(old_ids[v])) {
+          IndexT dst = new_ids[og.getEdgeDst(e)];
+          if (dst > v)
+            g.constructEdge(row_begin + offset++, dst, 0);
+        }
+        assert(offset == new_degrees[v]);
+      },
+      galois::steal(), galois::loopname("ConstructNewGraph"));
+  g.sortAllEdgesByDst();
+  Tdag.stop();
+  galois::gPrint("DAG max out-degree: ", max_degree, "\n");
+  return max_degree;
+}
+
+// write the topology of g as a version 1 .gr file without edge data
+void write_gr(PangolinGraph& g, std::string filename) {
+  std::ofstream outfile(filename, std::ios::binary);
+  if (!outfile)
+    GALOIS_DIE("failed to open ", filename, " for writing");
+  uint64_t header[4] = {1, 0, g.size(), g.sizeEdges()};
+  outfile.write(reinterpret_cast<char*>(header), sizeof(header));
+  for (GNode n : g) {
+    uint64_t row_end = *g.edge_end(n);
+    outfile.write(reinterpret_cast<char*>(&row_end), sizeof(row_end));
+  }
+  for (GNode n : g) {
+    for (auto e : g.edges(n)) {
+      uint32_t dst = g.getEdgeDst(e);
+      outfile.write(reinterpret_cast<char*>(&dst), sizeof(dst));
+    }
+  }
+  if (g.sizeEdges() % 2) {
+    uint32_t padding = 0;
+    outfile.write(reinterpret_cast<char*>(&padding), sizeof(padding));
+  }
+}
+
 // relabel is needed when we use DAG as input graph, and it is disabled when we
 // use symmetrized graph
+// dag_order selects how edges are oriented when need_dag is set: "degree"
+// orients them towards the higher-degree endpoint, "core" relabels vertices
+// by degeneracy order first (see CoreOrientation); a core-ordered DAG is read
+// from dag_cache if that file exists, and written to it otherwise
 unsigned read_graph(PangolinGraph& graph, std::string filetype,
-                    std::string filename, bool need_dag = false) {
+                    std::string filename, bool need_dag = false,
+                    std::string dag_order = "degree",
+                    std::string dag_cache = "") {
+  bool core_dag = need_dag && dag_order == "core";
+  if (need_dag && !core_dag && dag_order != "degree")
+    GALOIS_DIE("unknown DAG ordering ", dag_order, " (use degree or core)");
+  if (core_dag && !dag_cache.empty() && std::ifstream(dag_cache).good()) {
+    galois::gPrint("Reading core-ordered DAG from ", dag_cache, "\n");
+    galois::graphs::readGraph(graph, dag_cache);
+    std::vector<unsigned> degrees(graph.size());
+    galois::do_all(
+        galois::iterate(graph.begin(), graph.end()),
+        [&](const auto& vid) {
+          graph.getData(vid) = 0;
+          degrees[vid] =
+              std::distance(graph.edge_begin(vid), graph.edge_end(vid));
+        },
+        galois::loopname("computeMaxDegree"));
+    galois::gPrint("Input graph: num_vertices ", graph.size(), " num_edges ",
+                   graph.sizeEdges(), "\n");
+    return *(std::max_element(degrees.begin(), degrees.end()));
+  }
+  if (core_dag) {
+    PangolinGraph g_temp;
+    read_graph(g_temp, filetype, filename, false);
+    unsigned max_degree = CoreOrientation(g_temp, graph);
+    if (!dag_cache.empty())
+      write_gr(graph, dag_cache);
+    return max_degree;
+  }
+
   MGraph mgraph(need_dag);
   unsigned max_degree = 0;
   if (filetype == "txt") {
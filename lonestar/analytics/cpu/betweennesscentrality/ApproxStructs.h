@@ -0,0 +1,256 @@
+#ifndef GALOIS_BC_APPROX
+#define GALOIS_BC_APPROX
+
+#include "MultiSourceStructs.h"
+#include "galois/LargeArray.h"
+#include "galois/Reduction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Estimates of BC from the dependencies of nodes on random sources, along
+ * with error bounds that hold for all nodes at once.
+ *
+ * The dependency of a node on a source is at most N - 2 in a graph of N
+ * nodes, so it is scaled by 1 / (N - 2) to fall in [0, 1]. The mean of the
+ * scaled dependencies on sources picked uniformly at random then estimates
+ * the BC of the node divided by N (N - 2). The error of that estimate is
+ * bounded with the empirical Bernstein bound of Maurer and Pontil, so nodes
+ * that few sources depend on, which are most of them, get tight bounds
+ * early. A check is allowed to fail with probability delta / 2, split evenly
+ * between nodes, between all the checks that may take place and between the
+ * two sides of the bound, since estimates may be off in either direction.
+ *
+ * Past maxSamples() sources, Hoeffding's bound with the other delta / 2
+ * guarantees an error of at most epsilon whatever the dependencies, so
+ * sampling stops there.
+ */
+class ApproxBCEstimates {
+  MultiSourceGraph& graph;
+  double epsilon;
+  double scale;
+  size_t m_maxSamples;
+  double logTerm;
+
+  // sums of the scaled dependencies of each node and of their squares
+  galois::LargeArray<double> sum;
+  galois::LargeArray<double> sumSquares;
+
+public:
+  ApproxBCEstimates(MultiSourceGraph& g, double epsilon, double delta,
+                    size_t batchSize)
+      : graph(g), epsilon(epsilon) {
+    double numNodes = graph.size();
+    scale           = graph.size() > 2 ? 1 / (numNodes - 2) : 1;
+    m_maxSamples    = std::ceil(std::log(4 * numNodes / delta) /
+                             (2 * epsilon * epsilon));
+    // a check after each batch, with delta / 2 over two sides
+    double numChecks = std::ceil(double(m_maxSamples) / batchSize);
+    logTerm          = std::log(8 * numNodes * numChecks / delta);
+
+    sum.allocateInterleaved(graph.size());
+    sumSquares.allocateInterleaved(graph.size());
+    galois::do_all(
+        galois::iterate(graph),
+        [&](MultiSourceGNode n) {
+          sum[n]        = 0;
+          sumSquares[n] = 0;
+        },
+        galois::no_stats());
+  }
+
+  size_t maxSamples() const { return m_maxSamples; }
+
+  //! Samples before the bound of a node with no variance is below epsilon
+  size_t minSamples() const {
+    return std::ceil(1 + 7 * logTerm / (3 * epsilon));
+  }
+
+  //! Adds the dependency of n on a sampled source
+  void add(MultiSourceGNode n, float dep) {
+    double x = dep * scale;
+    sum[n] += x;
+    sumSquares[n] += x * x;
+  }
+
+  //! Estimate of the BC of n divided by N (N - 2)
+  double estimate(MultiSourceGNode n, size_t numSamples) const {
+    return sum[n] / numSamples;
+  }
+
+  //! Bound on the error of estimate(n, numSamples), for numSamples > 1
+  double error(MultiSourceGNode n, size_t numSamples) const {
+    double k        = numSamples;
+    double mean     = sum[n] / k;
+    double variance =
+        std::max(0.0, (sumSquares[n] - k * mean * mean) / (k - 1));
+    return std::sqrt(2 * variance * logTerm / k) + 7 * logTerm / (3 * (k - 1));
+  }
+
+  double maxError(size_t numSamples) const {
+    galois::GReduceMax<double> maxError;
+    galois::do_all(
+        galois::iterate(graph),
+        [&](MultiSourceGNode n) { maxError.update(error(n, numSamples)); },
+        galois::no_stats(), galois::loopname("ApproxMaxError"));
+    return maxError.reduce();
+  }
+
+  /**
+   * Whether the k nodes with the highest estimates are known to have the k
+   * highest BCs, i.e. each of their lower bounds is above the upper bounds
+   * of all other nodes.
+   */
+  bool topKSeparated(size_t k, size_t numSamples) const {
+    if (k >= graph.size())
+      return true;
+    std::vector<MultiSourceGNode> order(graph.begin(), graph.end());
+    std::nth_element(order.begin(), order.begin() + k, order.end(),
+                     [&](MultiSourceGNode a, MultiSourceGNode b) {
+                       return sum[a] > sum[b];
+                     });
+
+    galois::GReduceMin<double> minLower;
+    galois::GReduceMax<double> maxUpper;
+    galois::do_all(
+        galois::iterate(size_t(0), order.size()),
+        [&](size_t i) {
+          MultiSourceGNode n = order[i];
+          double est         = estimate(n, numSamples);
+          double err         = error(n, numSamples);
+          if (i < k)
+            minLower.update(est - err);
+          else
+            maxUpper.update(est + err);
+        },
+        galois::no_stats(), galois::loopname("ApproxTopK"));
+    return minLower.reduce() > maxUpper.reduce();
+  }
+
+  //! Sets the BC of each node to its estimate, on the scale of exact BC
+  void writeBC(size_t numSamples) {
+    double numNodes = graph.size();
+    galois::do_all(
+        galois::iterate(graph),
+        [&](MultiSourceGNode n) {
+          graph.getData(n) = estimate(n, numSamples) * numNodes / scale;
+        },
+        galois::no_stats());
+  }
+};
+
+//! Exact BC with all nodes as sources
+template <typename BC>
+void runAllSources(MultiSourceGraph& graph, BC& bc) {
+  std::vector<MultiSourceGNode> batch;
+  for (size_t i = 0; i < graph.size(); i += BC::BATCH_SIZE) {
+    batch.clear();
+    for (size_t s = i; s < std::min(graph.size(), i + BC::BATCH_SIZE); ++s)
+      batch.push_back(s);
+    bc.run(batch);
+  }
+  galois::runtime::reportStat_Single(REGION_NAME, "Samples", graph.size());
+}
+
+template <unsigned Words>
+void runApproxBC(MultiSourceGraph& graph) {
+  using BC = MultiSourceBC<Words>;
+
+  galois::StatTimer initTime("TimerInitialize", REGION_NAME);
+  initTime.start();
+  BC bc(graph);
+  ApproxBCEstimates estimates(graph, approxEpsilon, approxDelta,
+                              BC::BATCH_SIZE);
+  initTime.stop();
+
+  galois::StatTimer execTime("Timer_0");
+  execTime.start();
+
+  // sampling as many sources as there are nodes costs as much as exact BC
+  if (std::min(estimates.minSamples(), estimates.maxSamples()) >=
+      graph.size()) {
+    galois::gInfo("Computing exact BC: the bounds need at least ",
+                  std::min(estimates.minSamples(), estimates.maxSamples()),
+                  " samples for ", graph.size(), " nodes");
+    runAllSources(graph, bc);
+    execTime.stop();
+    return;
+  }
+
+  std::mt19937_64 gen(seed);
+  std::uniform_int_distribution<MultiSourceGNode> pick(0, graph.size() - 1);
+  std::vector<MultiSourceGNode> batch;
+  size_t limit      = std::min<size_t>(estimates.maxSamples(), graph.size());
+  size_t numSamples = 0;
+  double maxError   = 1;
+  bool done         = false;
+  while (!done && numSamples < limit) {
+    batch.clear();
+    while (batch.size() < BC::BATCH_SIZE && numSamples + batch.size() < limit)
+      batch.push_back(pick(gen));
+    bc.run(batch, [&](MultiSourceGNode n, float dep) {
+      estimates.add(n, dep);
+    });
+    numSamples += batch.size();
+
+    maxError = estimates.maxError(numSamples);
+    done     = maxError <= approxEpsilon;
+    if (!done && approxTopK &&
+        estimates.topKSeparated(approxTopK, numSamples)) {
+      galois::gInfo("Top ", approxTopK, " nodes found");
+      done = true;
+    }
+  }
+
+  if (!done && numSamples < estimates.maxSamples()) {
+    galois::gInfo("Computing exact BC: bounds not met after ", numSamples,
+                  " samples, which are discarded");
+    runAllSources(graph, bc);
+    execTime.stop();
+    return;
+  }
+  if (!done)
+    maxError = std::min<double>(maxError, approxEpsilon);
+
+  estimates.writeBC(numSamples);
+  execTime.stop();
+
+  galois::gInfo("Sampled ", numSamples, " sources out of at most ",
+                estimates.maxSamples(), "; error of normalized BC at most ",
+                maxError, " with probability ", 1 - approxDelta);
+  galois::runtime::reportStat_Single(REGION_NAME, "Samples", numSamples);
+  galois::runtime::reportStat_Single(REGION_NAME, "MaxSamples",
+                                     estimates.maxSamples());
+}
+
+void doApproxBC() {
+  galois::reportPageAlloc("MemAllocPre");
+
+  galois::StatTimer graphConstructTimer("TimerConstructGraph", "BFS");
+  graphConstructTimer.start();
+  MultiSourceGraph graph;
+  galois::graphs::readGraph(graph, inputFile);
+  graphConstructTimer.stop();
+  galois::gInfo("Graph construction complete");
+
+  if (!(approxEpsilon > 0 && approxEpsilon < 1) ||
+      !(approxDelta > 0 && approxDelta < 1))
+    GALOIS_DIE("epsilon and delta must be between 0 and 1");
+
+  galois::gInfo("Beginning main computation");
+  withBatchWords(
+      [&](auto words) { runApproxBC<decltype(words)::value>(graph); });
+
+  galois::reportPageAlloc("MemAllocPost");
+
+  MultiSourceSanity(graph);
+
+  if (output)
+    MultiSourceOutput(graph);
+}
+#endif
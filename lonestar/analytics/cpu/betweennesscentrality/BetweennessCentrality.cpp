@@ -25,9 +25,10 @@
 
 constexpr static const char* const REGION_NAME = "BC";
 
-enum Algo { Level = 0, Async, Outer, AutoAlgo };
+enum Algo { Level = 0, Async, Outer, MultiSource, Approx, AutoAlgo };
 
-const char* const ALGO_NAMES[] = {"Level", "Async", "Outer", "Auto"};
+const char* const ALGO_NAMES[] = {"Level",  "Async", "Outer", "MultiSource",
+                                  "Approx", "Auto"};
 
 const uint32_t infinity = std::numeric_limits<uint32_t>::max() / 4;
 
@@ -72,10 +73,42 @@ static cll::opt<bool>
     output("output", cll::desc("Output BC (Level/Async) (default: false)"),
            cll::init(false));
 
+static cll::opt<unsigned int>
+    batchSize("batchSize",
+              cll::desc("MultiSource: number of sources in a batch, one of "
+                        "64, 128, 256 or 512 (default 64)"),
+              cll::init(64));
+
+static cll::opt<double> approxEpsilon(
+    "epsilon",
+    cll::desc("Approx: maximum error of BC normalized by N(N-2), where N is "
+              "the number of nodes (default 0.01)"),
+    cll::init(0.01));
+
+static cll::opt<double>
+    approxDelta("delta",
+                cll::desc("Approx: probability that the error is larger "
+                          "than epsilon (default 0.1)"),
+                cll::init(0.1));
+
+static cll::opt<unsigned int>
+    approxTopK("topK",
+               cll::desc("Approx: also stop once the K nodes of highest BC "
+                         "are known (default 0: off)"),
+               cll::init(0));
+
+static cll::opt<unsigned int>
+    seed("seed", cll::desc("Approx: seed for picking sources (default 0)"),
+         cll::init(0));
+
 static cll::opt<Algo> algo(
     "algo", cll::desc("Choose an algorithm (default value AutoAlgo):"),
     cll::values(clEnumVal(Level, "Level"), clEnumVal(Async, "Async"),
                 clEnumVal(Outer, "Outer"),
+                clEnumVal(MultiSource, "MultiSource: Level on batches of "
+                                       "sources at once"),
+                clEnumVal(Approx, "Approx: MultiSource on random sources "
+                                  "until BC is within epsilon"),
                 clEnumVal(AutoAlgo,
                           "Auto: choose among the algorithms automatically")),
     cll::init(AutoAlgo));
@@ -96,6 +129,8 @@ static const char* desc = "Computes betwenness centrality in an unweighted "
 #include "LevelStructs.h"
 #include "AsyncStructs.h"
 #include "OuterStructs.h"
+#include "MultiSourceStructs.h"
+#include "ApproxStructs.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -137,6 +172,16 @@ int main(int argc, char** argv) {
     galois::gInfo("Running outer BC");
     doOuterBC();
     break;
+  case MultiSource:
+    // see MultiSourceStructs.h
+    galois::gInfo("Running multi-source BC");
+    doMultiSourceBC();
+    break;
+  case Approx:
+    // see ApproxStructs.h
+    galois::gInfo("Running approximate BC");
+    doApproxBC();
+    break;
   default:
     GALOIS_DIE("Unknown BC algorithm type");
   }
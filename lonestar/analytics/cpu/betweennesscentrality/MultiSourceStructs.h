@@ -0,0 +1,296 @@
+#ifndef GALOIS_BC_MULTISOURCE
+#define GALOIS_BC_MULTISOURCE
+
+#include "galois/AtomicHelpers.h"
+#include "galois/LargeArray.h"
+#include "galois/MultiSourceBFS.h"
+#include "galois/Reduction.h"
+#include "galois/graphs/LCGraph.h"
+
+#include <fstream>
+#include <iterator>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using MultiSourceGraph =
+    galois::graphs::LC_CSR_Graph<float, void>::with_no_lockable<
+        true>::type::with_numa_alloc<true>::type;
+using MultiSourceGNode = MultiSourceGraph::GraphNode;
+
+/**
+ * Brandes BC for a batch of sources at a time on top of galois::
+ * MultiSourceBFS. The forward phase counts shortest paths of all sources
+ * of the batch in the same BFS, and the backward phase goes over its levels
+ * in reverse, so that a node is read once per level rather than once per
+ * source.
+ *
+ * Path counts and dependencies are kept per node and source of the batch,
+ * which takes 12 bytes per node and source.
+ */
+template <unsigned Words>
+class MultiSourceBC {
+  using BFS     = galois::MultiSourceBFS<MultiSourceGraph, Words>;
+  using Sources = typename BFS::Sources;
+  using Visit   = typename BFS::Visit;
+
+public:
+  static constexpr unsigned BATCH_SIZE = BFS::MAX_SOURCES;
+
+private:
+  MultiSourceGraph& graph;
+  BFS bfs;
+  // number of shortest paths and dependency of node n for source s are at
+  // n * BATCH_SIZE + s
+  galois::LargeArray<std::atomic<double>> numShortestPaths;
+  galois::LargeArray<float> dependency;
+  //! Sources for which a node is at the level after the one being done
+  galois::LargeArray<Sources> succSources;
+
+  size_t at(MultiSourceGNode n, unsigned s) const {
+    return size_t(n) * BATCH_SIZE + s;
+  }
+
+  void forward(const std::vector<MultiSourceGNode>& batch) {
+    for (unsigned s = 0; s < batch.size(); ++s)
+      numShortestPaths[at(batch[s], s)] = 1;
+
+    bfs.run(batch, [&](MultiSourceGNode src, MultiSourceGNode dst,
+                       const Sources& fresh) {
+      fresh.forEach([&](unsigned s) {
+        galois::atomicAdd(numShortestPaths[at(dst, s)],
+                          numShortestPaths[at(src, s)].load());
+      });
+    });
+  }
+
+  void setSuccSources(size_t level, bool set) {
+    galois::do_all(
+        galois::iterate(bfs.level(level)),
+        [&](const Visit& v) {
+          if (set)
+            succSources[v.node] = v.sources;
+          else
+            succSources[v.node].clear();
+        },
+        galois::steal(), galois::no_stats());
+  }
+
+  template <typename AddFn>
+  void backward(const AddFn& addDependency) {
+    // the last level has no successors and the first is the sources
+    if (bfs.numLevels() < 3)
+      return;
+    for (size_t level = bfs.numLevels() - 2; level > 0; --level) {
+      setSuccSources(level + 1, true);
+
+      galois::do_all(
+          galois::iterate(bfs.level(level)),
+          [&](const Visit& v) {
+            for (auto e : graph.edges(v.node)) {
+              MultiSourceGNode dest = graph.getEdgeDst(e);
+              // sources for which dest is a successor of v
+              Sources succ = v.sources & succSources[dest];
+              succ.forEach([&](unsigned s) {
+                float contrib = ((float)1 + dependency[at(dest, s)]) /
+                                numShortestPaths[at(dest, s)];
+                float& dep = dependency[at(v.node, s)];
+                dep        = dep + contrib;
+              });
+            }
+
+            v.sources.forEach([&](unsigned s) {
+              dependency[at(v.node, s)] *= numShortestPaths[at(v.node, s)];
+              addDependency(v.node, dependency[at(v.node, s)]);
+            });
+          },
+          galois::steal(), galois::chunk_size<LEVEL_CHUNK_SIZE>(),
+          galois::no_stats(), galois::loopname("Brandes"));
+
+      setSuccSources(level + 1, false);
+    }
+  }
+
+  //! Clears the entries of the batch, which only nodes it reached have
+  void clear() {
+    for (size_t level = 0; level < bfs.numLevels(); ++level) {
+      galois::do_all(
+          galois::iterate(bfs.level(level)),
+          [&](const Visit& v) {
+            v.sources.forEach([&](unsigned s) {
+              numShortestPaths[at(v.node, s)] = 0;
+              dependency[at(v.node, s)]       = 0;
+            });
+          },
+          galois::steal(), galois::no_stats());
+    }
+  }
+
+public:
+  explicit MultiSourceBC(MultiSourceGraph& g) : graph(g), bfs(g) {
+    numShortestPaths.allocateInterleaved(graph.size() * BATCH_SIZE);
+    dependency.allocateInterleaved(graph.size() * BATCH_SIZE);
+    succSources.allocateInterleaved(graph.size());
+    galois::do_all(
+        galois::iterate(graph),
+        [&](MultiSourceGNode n) {
+          for (unsigned s = 0; s < BATCH_SIZE; ++s) {
+            numShortestPaths[at(n, s)] = 0;
+            dependency[at(n, s)]       = 0;
+          }
+          succSources[n].clear();
+          graph.getData(n) = 0;
+        },
+        galois::no_stats(), galois::loopname("InitializeGraph"));
+  }
+
+  /**
+   * Computes the dependencies of nodes on up to BATCH_SIZE sources and
+   * calls addDependency(n, dependency) on each non-zero one, except those of
+   * sources on themselves. Calls for the same node are never concurrent.
+   */
+  template <typename AddFn>
+  void run(const std::vector<MultiSourceGNode>& batch,
+           const AddFn& addDependency) {
+    assert(batch.size() <= BATCH_SIZE);
+    forward(batch);
+    backward(addDependency);
+    clear();
+  }
+
+  //! Adds the dependencies of up to BATCH_SIZE sources to the BC of nodes
+  void run(const std::vector<MultiSourceGNode>& batch) {
+    run(batch,
+        [&](MultiSourceGNode n, float dep) { graph.getData(n) += dep; });
+  }
+};
+
+/**
+ * Get some sanity numbers (max, min, sum of BC)
+ *
+ * @param graph MultiSourceGraph to sanity check
+ */
+void MultiSourceSanity(MultiSourceGraph& graph) {
+  galois::GReduceMax<float> accumMax;
+  galois::GReduceMin<float> accumMin;
+  galois::GAccumulator<float> accumSum;
+
+  galois::do_all(
+      galois::iterate(graph),
+      [&](MultiSourceGNode n) {
+        float bc = graph.getData(n);
+        accumMax.update(bc);
+        accumMin.update(bc);
+        accumSum += bc;
+      },
+      galois::no_stats(), galois::loopname("MultiSourceSanity"));
+
+  galois::gPrint("Max BC is ", accumMax.reduce(), "\n");
+  galois::gPrint("Min BC is ", accumMin.reduce(), "\n");
+  galois::gPrint("BC sum is ", accumSum.reduce(), "\n");
+}
+
+//! Prints the BC of each node
+void MultiSourceOutput(MultiSourceGraph& graph) {
+  char* v_out = (char*)malloc(40);
+  for (auto ii = graph.begin(); ii != graph.end(); ++ii) {
+    // outputs betweenness centrality
+    sprintf(v_out, "%u %.9f\n", (*ii), graph.getData(*ii));
+    galois::gPrint(v_out);
+  }
+  free(v_out);
+}
+
+/**
+ * Calls fn with a std::integral_constant of the number of words of a batch
+ * of -batchSize sources.
+ */
+template <typename Fn>
+void withBatchWords(const Fn& fn) {
+  switch (batchSize) {
+  case 64:
+    fn(std::integral_constant<unsigned, 1>());
+    break;
+  case 128:
+    fn(std::integral_constant<unsigned, 2>());
+    break;
+  case 256:
+    fn(std::integral_constant<unsigned, 4>());
+    break;
+  case 512:
+    fn(std::integral_constant<unsigned, 8>());
+    break;
+  default:
+    GALOIS_DIE("batch size must be 64, 128, 256 or 512");
+  }
+}
+
+template <unsigned Words>
+void runMultiSourceBC(MultiSourceGraph& graph,
+                      const std::vector<MultiSourceGNode>& sources) {
+  using BC = MultiSourceBC<Words>;
+  galois::gInfo("Batches of ", BC::BATCH_SIZE, " sources");
+
+  galois::StatTimer initTime("TimerInitialize", REGION_NAME);
+  initTime.start();
+  BC bc(graph);
+  initTime.stop();
+
+  galois::StatTimer execTime("Timer_0");
+  execTime.start();
+  for (size_t i = 0; i < sources.size(); i += BC::BATCH_SIZE) {
+    size_t end = std::min(sources.size(), i + BC::BATCH_SIZE);
+    bc.run(std::vector<MultiSourceGNode>(sources.begin() + i,
+                                         sources.begin() + end));
+  }
+  execTime.stop();
+
+  galois::runtime::reportStat_Single(
+      REGION_NAME, "Batches",
+      (sources.size() + BC::BATCH_SIZE - 1) / BC::BATCH_SIZE);
+}
+
+void doMultiSourceBC() {
+  galois::reportPageAlloc("MemAllocPre");
+
+  galois::StatTimer graphConstructTimer("TimerConstructGraph", "BFS");
+  graphConstructTimer.start();
+  MultiSourceGraph graph;
+  galois::graphs::readGraph(graph, inputFile);
+  graphConstructTimer.stop();
+  galois::gInfo("Graph construction complete");
+
+  // same choice of sources as Level
+  std::vector<MultiSourceGNode> sources;
+  if (singleSourceBC) {
+    sources.push_back(startSource);
+  } else {
+    std::vector<uint64_t> sourceVector;
+    if (sourcesToUse != "") {
+      std::ifstream sourceFile(sourcesToUse);
+      sourceVector.assign(std::istream_iterator<uint64_t>{sourceFile},
+                          std::istream_iterator<uint64_t>{});
+    }
+
+    uint64_t loop_end = numOfSources ? numOfSources : graph.size();
+    if (sourceVector.size() != 0) {
+      loop_end = std::min<uint64_t>(loop_end, sourceVector.size());
+      sources.assign(sourceVector.begin(), sourceVector.begin() + loop_end);
+    } else {
+      for (uint64_t i = 0; i < loop_end; i++)
+        sources.push_back(i);
+    }
+  }
+
+  galois::gInfo("Beginning main computation");
+  withBatchWords([&](auto words) {
+    runMultiSourceBC<decltype(words)::value>(graph, sources);
+  });
+
+  galois::reportPageAlloc("MemAllocPost");
+
+  MultiSourceSanity(graph);
+
+  if (output)
+    MultiSourceOutput(graph);
+}
+#endif
@@ -20,10 +20,12 @@
 #include "galois/Galois.h"
 #include "galois/AtomicHelpers.h"
 #include "galois/Bag.h"
+#include "galois/EdgeTiles.h"
 #include "galois/ParallelSTL.h"
 #include "galois/Reduction.h"
 #include "galois/Timer.h"
 #include "galois/UnionFind.h"
+#include "galois/UpdateCombiner.h"
 #include "galois/graphs/LCGraph.h"
 #include "galois/graphs/OCGraph.h"
 #include "galois/graphs/TypeTraits.h"
@@ -110,10 +112,25 @@ static cll::opt<OutputEdgeType> writeEdgeType(
 static cll::opt<uint32_t>
     EDGE_TILE_SIZE("edgeTileSize",
                    cll::desc("(For Edgetiled algos) Size of edge tiles "
-                             "(default 512)"),
+                             "(default 512; 0 picks it from the degrees of "
+                             "the graph)"),
                    // cll::cat(ParamCat),
-                   cll::init(512)); // 512 -> 64
+                   cll::init(512));
+static cll::opt<bool>
+    prefetch("prefetch",
+             cll::desc("(For LabelProp) Prefetch the data of neighbors a few "
+                       "nodes ahead (default false)"),
+             // cll::cat(ParamCat),
+             cll::init(false));
+static cll::opt<bool>
+    combine("combine",
+            cll::desc("(For LabelProp) Combine the labels sent to the same "
+                      "node in a round before applying them (default false)"),
+            // cll::cat(ParamCat),
+            cll::init(false));
 static const int CHUNK_SIZE = 1;
+//! How many nodes ahead LabelProp prefetches the data of neighbors
+static const unsigned PREFETCH_DISTANCE = 8;
 //! parameter for the Vertex Neighbor Sampling step of Afforest algorithm
 static cll::opt<uint32_t> NEIGHBOR_SAMPLES(
     "vns",
@@ -203,28 +220,51 @@ struct LabelPropAlgo {
   }
 
   void operator()(Graph& graph) {
+    auto relax = [&](GNode dst, component_type label) {
+      galois::atomicMin(graph.getData(dst).comp_current, label);
+    };
+    auto combiner = galois::make_update_combiner<component_type>(
+        graph.size(), galois::gmin<component_type>(), relax);
+
     galois::GReduceLogicalOr changed;
     do {
       changed.reset();
-      galois::do_all(
-          galois::iterate(graph),
-          [&](const GNode& src) {
-            LNode& sdata = graph.getData(src, galois::MethodFlag::UNPROTECTED);
-            if (sdata.comp_old > sdata.comp_current) {
-              sdata.comp_old = sdata.comp_current;
-
-              changed.update(true);
-
-              for (auto e : graph.edges(src, galois::MethodFlag::UNPROTECTED)) {
-                GNode dst              = graph.getEdgeDst(e);
-                auto& ddata            = graph.getData(dst);
-                unsigned int label_new = sdata.comp_current;
-                galois::atomicMin(ddata.comp_current, label_new);
-              }
-            }
-          },
-          galois::disable_conflict_detection(), galois::steal(),
-          galois::loopname("LabelPropAlgo"));
+      auto propagate = [&](const GNode& src) {
+        LNode& sdata = graph.getData(src, galois::MethodFlag::UNPROTECTED);
+        if (sdata.comp_old > sdata.comp_current) {
+          sdata.comp_old = sdata.comp_current;
+
+          changed.update(true);
+
+          for (auto e : graph.edges(src, galois::MethodFlag::UNPROTECTED)) {
+            GNode dst              = graph.getEdgeDst(e);
+            unsigned int label_new = sdata.comp_current;
+            if (combine)
+              combiner.push(dst, label_new);
+            else
+              relax(dst, label_new);
+          }
+        }
+      };
+      if (prefetch) {
+        // Only nodes whose label changed touch their neighbors
+        galois::do_all(
+            galois::iterate(graph), propagate,
+            galois::interleave<PREFETCH_DISTANCE>([&](const GNode& src) {
+              LNode& sdata =
+                  graph.getData(src, galois::MethodFlag::UNPROTECTED);
+              if (sdata.comp_old > sdata.comp_current)
+                graph.prefetchNeighborData<1>(src);
+            }),
+            galois::disable_conflict_detection(), galois::steal(),
+            galois::loopname("LabelPropAlgo"));
+      } else {
+        galois::do_all(galois::iterate(graph), propagate,
+                       galois::disable_conflict_detection(), galois::steal(),
+                       galois::loopname("LabelPropAlgo"));
+      }
+      if (combine)
+        combiner.flush();
     } while (changed.reduce());
   }
 };
@@ -523,32 +563,21 @@ struct BlockedAsyncAlgo {
 struct EdgeTiledAsyncAlgo {
   using Graph =
       galois::graphs::LC_CSR_Graph<Node, void>::with_no_lockable<true>::type;
-  using GNode = Graph::GraphNode;
+  using GNode    = Graph::GraphNode;
+  using EdgeTile = galois::EdgeTile<Graph>;
 
   template <typename G>
   void readGraph(G& graph) {
     galois::graphs::readGraph(graph, inputFile);
   }
 
-  struct EdgeTile {
-    // Node* sData;
-    GNode src;
-    Graph::edge_iterator beg;
-    Graph::edge_iterator end;
-  };
-
-  /*struct EdgeTileMaker {
-      EdgeTile operator() (Node* sdata, Graph::edge_iterator beg,
-  Graph::edge_iterator end) const{ return EdgeTile{sdata, beg, end};
-      }
-  };*/
-
   void operator()(Graph& graph) {
     galois::GAccumulator<size_t> emptyMerges;
 
     galois::InsertBag<EdgeTile> works;
-
-    std::cout << "INFO: Using edge tile size of " << EDGE_TILE_SIZE
+    size_t tileSize =
+        EDGE_TILE_SIZE ? EDGE_TILE_SIZE : galois::edgeTileSize(graph);
+    std::cout << "INFO: Using edge tile size of " << tileSize
               << " and chunk size of " << CHUNK_SIZE << "\n";
     std::cout << "WARNING: Performance varies considerably due to parameter.\n";
     std::cout
@@ -557,31 +586,18 @@ struct EdgeTiledAsyncAlgo {
     galois::do_all(
         galois::iterate(graph),
         [&](const GNode& src) {
-          // Node& sdata=graph.getData(src,
-          // galois::MethodFlag::UNPROTECTED);
-          auto beg = graph.edge_begin(src, galois::MethodFlag::UNPROTECTED);
-          const auto end = graph.edge_end(src, galois::MethodFlag::UNPROTECTED);
-
-          assert(beg <= end);
-          if ((end - beg) > EDGE_TILE_SIZE) {
-            for (; beg + EDGE_TILE_SIZE < end;) {
-              auto ne = beg + EDGE_TILE_SIZE;
-              assert(ne < end);
-              works.push_back(EdgeTile{src, beg, ne});
-              beg = ne;
-            }
-          }
-
-          if ((end - beg) > 0) {
-            works.push_back(EdgeTile{src, beg, end});
-          }
+          galois::splitEdgeTiles(
+              graph.edge_begin(src, galois::MethodFlag::UNPROTECTED),
+              graph.edge_end(src, galois::MethodFlag::UNPROTECTED), tileSize,
+              [&](auto beg, auto end) {
+                works.push_back(EdgeTile{src, beg, end});
+              });
         },
         galois::loopname("CC-EdgeTiledAsyncInit"), galois::steal());
 
     galois::do_all(
         galois::iterate(works),
         [&](const EdgeTile& tile) {
-          // Node& sdata = *(tile.sData);
           GNode src   = tile.src;
           Node& sdata = graph.getData(src, galois::MethodFlag::UNPROTECTED);
 
@@ -939,11 +955,7 @@ struct EdgeTiledAfforestAlgo {
   using GNode          = Graph::GraphNode;
   using component_type = NodeData::component_type;
 
-  struct EdgeTile {
-    GNode src;
-    Graph::edge_iterator beg;
-    Graph::edge_iterator end;
-  };
+  using EdgeTile = galois::EdgeTile<Graph>;
 
   template <typename G>
   void readGraph(G& graph) {
@@ -983,7 +995,9 @@ struct EdgeTiledAfforestAlgo {
     StatTimer_Sampling.stop();
 
     galois::InsertBag<EdgeTile> works;
-    std::cout << "INFO: Using edge tile size of " << EDGE_TILE_SIZE
+    size_t tileSize =
+        EDGE_TILE_SIZE ? EDGE_TILE_SIZE : galois::edgeTileSize(graph);
+    std::cout << "INFO: Using edge tile size of " << tileSize
               << " and chunk size of " << CHUNK_SIZE << "\n";
     galois::do_all(
         galois::iterate(graph),
@@ -994,17 +1008,13 @@ struct EdgeTiledAfforestAlgo {
           auto beg = graph.edge_begin(src, galois::MethodFlag::UNPROTECTED);
           const auto end = graph.edge_end(src, galois::MethodFlag::UNPROTECTED);
 
-          for (std::advance(beg, NEIGHBOR_SAMPLES.getValue());
-               beg + EDGE_TILE_SIZE < end;) {
-            auto ne = beg + EDGE_TILE_SIZE;
-            assert(ne < end);
-            works.push_back(EdgeTile{src, beg, ne});
-            beg = ne;
-          }
+          std::advance(beg, NEIGHBOR_SAMPLES.getValue());
+          if (beg >= end)
+            return;
 
-          if ((end - beg) > 0) {
-            works.push_back(EdgeTile{src, beg, end});
-          }
+          galois::splitEdgeTiles(beg, end, tileSize, [&](auto b, auto e) {
+            works.push_back(EdgeTile{src, b, e});
+          });
         },
         galois::loopname("EdgetiledAfforest-LCS-Tiling"), galois::steal());
 
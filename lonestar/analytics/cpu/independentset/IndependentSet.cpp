@@ -19,6 +19,7 @@
 
 #include "galois/Galois.h"
 #include "galois/Bag.h"
+#include "galois/EdgeTiles.h"
 #include "galois/ParallelSTL.h"
 #include "galois/Reduction.h"
 #include "galois/Timer.h"
@@ -436,7 +437,7 @@ struct EdgeTiledPrioAlgo {
     galois::GReduceLogicalOr unmatched;
     galois::substrate::PerThreadStorage<std::mt19937*> generator;
     galois::InsertBag<EdgeTile> works;
-    const int EDGE_TILE_SIZE = 64;
+    constexpr size_t EDGE_TILE_SIZE = 64;
     galois::do_all(
         galois::iterate(graph),
         [&](const GNode& src) {
@@ -465,18 +466,10 @@ struct EdgeTiledPrioAlgo {
           unsigned char val = (res + res) | 0x03;
 
           nodedata.flag = val;
-          assert(beg <= end);
-          if ((end - beg) > EDGE_TILE_SIZE) {
-            for (; beg + EDGE_TILE_SIZE < end;) {
-              auto ne = beg + EDGE_TILE_SIZE;
-              assert(ne < end);
-              works.push_back(EdgeTile{src, beg, ne, false});
-              beg = ne;
-            }
-          }
-          if ((end - beg) > 0) {
-            works.push_back(EdgeTile{src, beg, end, false});
-          }
+          galois::splitEdgeTiles(beg, end, EDGE_TILE_SIZE,
+                                 [&](auto b, auto e) {
+                                   works.push_back(EdgeTile{src, b, e, false});
+                                 });
         },
         galois::loopname("init-prio"), galois::steal());
 
@@ -43,7 +43,15 @@ static cll::opt<bool>
                     cll::desc("Specify that the input graph is transposed"),
                     cll::init(false));
 
+static cll::opt<bool>
+    prefetch("prefetch",
+             cll::desc("Prefetch the data of in-neighbors a few nodes ahead "
+                       "(default true)"),
+             cll::init(true));
+
 constexpr static const unsigned CHUNK_SIZE = 32;
+//! How many nodes ahead to prefetch the data of in-neighbors
+constexpr static const unsigned PREFETCH_DISTANCE = 8;
 
 struct LNode {
   PRTy value;
@@ -155,22 +163,34 @@ void computePRResidual(Graph& graph, DeltaArray& delta,
         },
         galois::no_stats(), galois::loopname("PageRank_delta"));
 
-    galois::do_all(
-        galois::iterate(graph),
-        [&](const GNode& src) {
-          float sum = 0;
-          for (auto nbr : graph.edges(src)) {
-            GNode dst = graph.getEdgeDst(nbr);
-            if (delta[dst] > 0) {
-              sum += delta[dst];
+    auto pull = [&](const GNode& src) {
+      float sum = 0;
+      for (auto nbr : graph.edges(src)) {
+        GNode dst = graph.getEdgeDst(nbr);
+        if (delta[dst] > 0) {
+          sum += delta[dst];
+        }
+      }
+      if (sum > 0) {
+        residual[src] = sum;
+      }
+    };
+    if (prefetch) {
+      galois::do_all(
+          galois::iterate(graph), pull,
+          galois::interleave<PREFETCH_DISTANCE>([&](const GNode& src) {
+            for (auto nbr :
+                 graph.edges(src, galois::MethodFlag::UNPROTECTED)) {
+              __builtin_prefetch(&delta[graph.getEdgeDst(nbr)]);
             }
-          }
-          if (sum > 0) {
-            residual[src] = sum;
-          }
-        },
-        galois::steal(), galois::chunk_size<CHUNK_SIZE>(), galois::no_stats(),
-        galois::loopname("PageRank"));
+          }),
+          galois::steal(), galois::chunk_size<CHUNK_SIZE>(), galois::no_stats(),
+          galois::loopname("PageRank"));
+    } else {
+      galois::do_all(galois::iterate(graph), pull, galois::steal(),
+                     galois::chunk_size<CHUNK_SIZE>(), galois::no_stats(),
+                     galois::loopname("PageRank"));
+    }
 
 #if DEBUG
     std::cout << "iteration: " << iterations << "\n";
@@ -199,37 +219,44 @@ void computePRTopological(Graph& graph) {
 
   float base_score = (1.0f - ALPHA) / graph.size();
   while (true) {
-    galois::do_all(
-        galois::iterate(graph),
-        [&](const GNode& src) {
-          constexpr const galois::MethodFlag flag =
-              galois::MethodFlag::UNPROTECTED;
-
-          LNode& sdata = graph.getData(src, flag);
-          float sum    = 0.0;
-
-          for (auto jj = graph.edge_begin(src, flag),
-                    ej = graph.edge_end(src, flag);
-               jj != ej; ++jj) {
-            GNode dst = graph.getEdgeDst(jj);
-
-            LNode& ddata = graph.getData(dst, flag);
-            sum += ddata.value / ddata.nout;
-          }
-
-          //! New value of pagerank after computing contributions from
-          //! incoming edges in the original graph.
-          float value = sum * ALPHA + base_score;
-          //! Find the delta in new and old pagerank values.
-          float diff = std::fabs(value - sdata.value);
-
-          //! Do not update pagerank before the diff is computed since
-          //! there is a data dependence on the pagerank value.
-          sdata.value = value;
-          accum += diff;
-        },
-        galois::no_stats(), galois::steal(), galois::chunk_size<CHUNK_SIZE>(),
-        galois::loopname("PageRank"));
+    auto pull = [&](const GNode& src) {
+      constexpr const galois::MethodFlag flag = galois::MethodFlag::UNPROTECTED;
+
+      LNode& sdata = graph.getData(src, flag);
+      float sum    = 0.0;
+
+      for (auto jj = graph.edge_begin(src, flag),
+                ej = graph.edge_end(src, flag);
+           jj != ej; ++jj) {
+        GNode dst = graph.getEdgeDst(jj);
+
+        LNode& ddata = graph.getData(dst, flag);
+        sum += ddata.value / ddata.nout;
+      }
+
+      //! New value of pagerank after computing contributions from
+      //! incoming edges in the original graph.
+      float value = sum * ALPHA + base_score;
+      //! Find the delta in new and old pagerank values.
+      float diff = std::fabs(value - sdata.value);
+
+      //! Do not update pagerank before the diff is computed since
+      //! there is a data dependence on the pagerank value.
+      sdata.value = value;
+      accum += diff;
+    };
+    if (prefetch) {
+      galois::do_all(
+          galois::iterate(graph), pull,
+          galois::interleave<PREFETCH_DISTANCE>(
+              [&](const GNode& src) { graph.prefetchNeighborData(src); }),
+          galois::no_stats(), galois::steal(), galois::chunk_size<CHUNK_SIZE>(),
+          galois::loopname("PageRank"));
+    } else {
+      galois::do_all(galois::iterate(graph), pull, galois::no_stats(),
+                     galois::steal(), galois::chunk_size<CHUNK_SIZE>(),
+                     galois::loopname("PageRank"));
+    }
 
 #if DEBUG
     std::cout << "iteration: " << iteration << " max delta: " << delta << "\n";
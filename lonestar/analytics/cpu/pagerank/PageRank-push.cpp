@@ -20,8 +20,10 @@
 #include "Lonestar/BoilerPlate.h"
 #include "PageRank-constants.h"
 #include "galois/Bag.h"
+#include "galois/EdgeTiles.h"
 #include "galois/Galois.h"
 #include "galois/Timer.h"
+#include "galois/UpdateCombiner.h"
 #include "galois/graphs/LCGraph.h"
 #include "galois/graphs/TypeTraits.h"
 
@@ -46,6 +48,12 @@ static cll::opt<Algo> algo("algo", cll::desc("Choose an algorithm:"),
                                        clEnumVal(Sync, "Sync")),
                            cll::init(Async));
 
+static cll::opt<bool>
+    combine("combine",
+            cll::desc("Sync only: combine the residual updates of a round to "
+                      "the same node before applying them (default true)"),
+            cll::init(true));
+
 struct LNode {
   PRTy value;
   std::atomic<PRTy> residual;
@@ -107,7 +115,7 @@ void syncPageRank(Graph& graph) {
     Graph::edge_iterator end;
   };
 
-  constexpr ptrdiff_t EDGE_TILE_SIZE = 128;
+  constexpr size_t EDGE_TILE_SIZE = 128;
 
   galois::InsertBag<Update> updates;
   galois::InsertBag<GNode> activeNodes;
@@ -116,6 +124,19 @@ void syncPageRank(Graph& graph) {
       galois::iterate(graph), [&](const GNode& src) { activeNodes.push(src); },
       galois::no_stats());
 
+  auto apply = [&](GNode dst, PRTy delta) {
+    LNode& ddata = graph.getData(dst, galois::MethodFlag::UNPROTECTED);
+    auto old     = atomicAdd(ddata.residual, delta);
+    //! If fabs(old) is greater than tolerance, then it would already have
+    //! been processed in the previous do_all loop.
+    if ((old <= tolerance) && (old + delta >= tolerance)) {
+      activeNodes.push(dst);
+    }
+  };
+  //! Residuals pushed to the same node are summed before being applied.
+  auto combiner = galois::make_update_combiner<PRTy>(graph.size(),
+                                                     std::plus<PRTy>(), apply);
+
   size_t iter = 0;
   for (; !activeNodes.empty() && iter < maxIterations; ++iter) {
     galois::do_all(
@@ -134,23 +155,12 @@ void syncPageRank(Graph& graph) {
                                          graph.edge_end(src, flag));
             PRTy delta   = oldResidual * ALPHA / src_nout;
 
-            auto beg       = graph.edge_begin(src, flag);
-            const auto end = graph.edge_end(src, flag);
-
-            assert(beg <= end);
-
             //! Edge tiling for large outdegree nodes.
-            if ((end - beg) > EDGE_TILE_SIZE) {
-              for (; beg + EDGE_TILE_SIZE < end;) {
-                auto ne = beg + EDGE_TILE_SIZE;
-                updates.push(Update{delta, beg, ne});
-                beg = ne;
-              }
-            }
-
-            if ((end - beg) > 0) {
-              updates.push(Update{delta, beg, end});
-            }
+            galois::splitEdgeTiles(graph.edge_begin(src, flag),
+                                   graph.edge_end(src, flag), EDGE_TILE_SIZE,
+                                   [&](auto beg, auto end) {
+                                     updates.push(Update{delta, beg, end});
+                                   });
           }
         },
         galois::steal(), galois::chunk_size<CHUNK_SIZE>(),
@@ -158,26 +168,29 @@ void syncPageRank(Graph& graph) {
 
     activeNodes.clear();
 
-    galois::do_all(
-        galois::iterate(updates),
-        [&](const Update& up) {
-          constexpr const galois::MethodFlag flag =
-              galois::MethodFlag::UNPROTECTED;
-          //! For each out-going neighbors.
-          for (auto jj = up.beg; jj != up.end; ++jj) {
-            GNode dst    = graph.getEdgeDst(jj);
-            LNode& ddata = graph.getData(dst, flag);
-            auto old     = atomicAdd(ddata.residual, up.delta);
-            //! If fabs(old) is greater than tolerance, then it would
-            //! already have been processed in the previous do_all
-            //! loop.
-            if ((old <= tolerance) && (old + up.delta >= tolerance)) {
-              activeNodes.push(dst);
+    if (combine) {
+      galois::do_all(
+          galois::iterate(updates),
+          [&](const Update& up) {
+            for (auto jj = up.beg; jj != up.end; ++jj) {
+              combiner.push(graph.getEdgeDst(jj), up.delta);
             }
-          }
-        },
-        galois::steal(), galois::chunk_size<CHUNK_SIZE>(),
-        galois::loopname("PushResidualSync"), galois::no_stats());
+          },
+          galois::steal(), galois::chunk_size<CHUNK_SIZE>(),
+          galois::loopname("PushResidualSync"), galois::no_stats());
+      combiner.flush();
+    } else {
+      galois::do_all(
+          galois::iterate(updates),
+          [&](const Update& up) {
+            //! For each out-going neighbors.
+            for (auto jj = up.beg; jj != up.end; ++jj) {
+              apply(graph.getEdgeDst(jj), up.delta);
+            }
+          },
+          galois::steal(), galois::chunk_size<CHUNK_SIZE>(),
+          galois::loopname("PushResidualSync"), galois::no_stats());
+    }
 
     updates.clear();
   }
@@ -40,17 +40,20 @@ static const char* name = "Boruvka's Minimum Spanning Tree Algorithm";
 static const char* desc = "Computes the minimum spanning forest of a graph";
 static const char* url  = "mst";
 
-enum Algo { parallel, exp_parallel };
+enum Algo { parallel, exp_parallel, kruskal };
 
 static cll::opt<std::string>
     inputFilename(cll::Positional, cll::desc("<input file>"), cll::Required);
 static cll::opt<Algo>
     algo("algo", cll::desc("Choose an algorithm (default value parallel):"),
-         cll::values(clEnumVal(parallel, "Parallel")), cll::init(parallel));
+         cll::values(clEnumVal(parallel, "Parallel"),
+                     clEnumVal(kruskal, "Kruskal on the ordered executor")),
+         cll::init(parallel));
 
 typedef int EdgeData;
 
-struct Node : public galois::UnionFindNode<Node> {
+struct Node : public galois::UnionFindNode<Node>,
+              public galois::runtime::Lockable {
   std::atomic<EdgeData*> lightest;
   Node() : galois::UnionFindNode<Node>(const_cast<Node*>(this)) {}
 };
@@ -77,7 +80,7 @@ struct Edge {
  * Boruvka's algorithm. Implemented bulk-synchronously in order to avoid the
  * need to merge edge lists.
  */
-template <bool useExp>
+template <Algo algoType>
 struct ParallelAlgo {
   struct WorkItem {
     Edge edge;
@@ -267,11 +270,60 @@ struct ParallelAlgo {
 
   void processExp() { GALOIS_DIE("not supported"); }
 
+  /**
+   * Kruskal's algorithm: edges are added in weight order unless they close a
+   * cycle. An edge between two components needs the representatives of both;
+   * an edge within a component stays so and needs nothing.
+   */
+  void processOrdered() {
+    galois::InsertBag<Edge> edges;
+
+    galois::do_all(
+        galois::iterate(graph),
+        [&](const GNode& src) {
+          for (auto ii : graph.edges(src, galois::MethodFlag::UNPROTECTED)) {
+            GNode dst = graph.getEdgeDst(ii);
+            if (src < dst)
+              edges.push(Edge(src, dst, &graph.getEdgeData(ii)));
+          }
+        },
+        galois::steal(), galois::loopname("CollectEdges"));
+
+    auto lighter = [](const Edge& a, const Edge& b) {
+      return *a.weight < *b.weight;
+    };
+
+    auto nhood = [this](const Edge& e) {
+      Node* srep = graph.getData(e.src, galois::MethodFlag::UNPROTECTED).find();
+      Node* drep = graph.getData(e.dst, galois::MethodFlag::UNPROTECTED).find();
+      if (srep != drep) {
+        galois::runtime::acquire(srep, galois::MethodFlag::WRITE);
+        galois::runtime::acquire(drep, galois::MethodFlag::WRITE);
+      }
+    };
+
+    auto link = [this](const Edge& e, galois::UserContext<Edge>&) {
+      Node& sdata = graph.getData(e.src, galois::MethodFlag::UNPROTECTED);
+      Node& ddata = graph.getData(e.dst, galois::MethodFlag::UNPROTECTED);
+      if (sdata.merge(&ddata))
+        mst.push(e);
+    };
+
+    galois::for_each_ordered(edges.begin(), edges.end(), lighter, nhood, link,
+                             "Kruskal");
+  }
+
   void operator()() {
-    if (useExp) {
+    switch (algoType) {
+    case exp_parallel:
       processExp();
-    } else {
+      break;
+    case kruskal:
+      processOrdered();
+      break;
+    default:
       process();
+      break;
     }
   }
 
@@ -425,10 +477,13 @@ int main(int argc, char** argv) {
 
   switch (algo) {
   case parallel:
-    run<ParallelAlgo<false>>();
+    run<ParallelAlgo<parallel>>();
     break;
   case exp_parallel:
-    run<ParallelAlgo<true>>();
+    run<ParallelAlgo<exp_parallel>>();
+    break;
+  case kruskal:
+    run<ParallelAlgo<kruskal>>();
     break;
   default:
     std::cerr << "Unknown algo: " << algo << "\n";
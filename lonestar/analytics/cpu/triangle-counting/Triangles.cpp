@@ -21,6 +21,7 @@
 #include "galois/Bag.h"
 #include "galois/ParallelSTL.h"
 #include "galois/Reduction.h"
+#include "galois/SetIntersection.h"
 #include "galois/Timer.h"
 #include "galois/graphs/LCGraph.h"
 #include "galois/graphs/BufferedGraph.h"
@@ -95,27 +96,15 @@ Iterator lowerBound(Iterator first, Iterator last, Compare comp) {
 }
 
 /**
- * std::set_intersection over edge_iterators.
+ * Counts the common destinations of two sorted edge ranges.
  */
 template <typename G>
 size_t countEqual(G& g, typename G::edge_iterator aa,
                   typename G::edge_iterator ea, typename G::edge_iterator bb,
                   typename G::edge_iterator eb) {
-  size_t retval = 0;
-  while (aa != ea && bb != eb) {
-    typename G::GraphNode a = g.getEdgeDst(aa);
-    typename G::GraphNode b = g.getEdgeDst(bb);
-    if (a < b) {
-      ++aa;
-    } else if (b < a) {
-      ++bb;
-    } else {
-      retval += 1;
-      ++aa;
-      ++bb;
-    }
-  }
-  return retval;
+  return galois::intersection::count(g.getEdgeDstPtr(aa),
+                                     std::distance(aa, ea),
+                                     g.getEdgeDstPtr(bb), std::distance(bb, eb));
 }
 
 template <typename G>
@@ -242,23 +231,21 @@ void nodeIteratingAlgo(Graph& graph) {
 void orderedCountFunc(Graph& graph, GNode n,
                       galois::GAccumulator<size_t>& numTriangles) {
   size_t numTriangles_local = 0;
+  const GNode* nNbrs =
+      graph.getEdgeDstPtr(graph.edge_begin(n, galois::MethodFlag::UNPROTECTED));
+  size_t nDegree = graph.getDegree(n);
+
   for (auto it_v : graph.edges(n)) {
     auto v = graph.getEdgeDst(it_v);
     if (v > n)
       break;
-    Graph::edge_iterator it_n =
-        graph.edge_begin(n, galois::MethodFlag::UNPROTECTED);
-
-    for (auto it_vv : graph.edges(v)) {
-      auto vv = graph.getEdgeDst(it_vv);
-      if (vv > v)
-        break;
-      while (graph.getEdgeDst(it_n) < vv)
-        it_n++;
-      if (vv == graph.getEdgeDst(it_n)) {
-        numTriangles_local += 1;
-      }
-    }
+    // neighbors of v that are not larger than v
+    const GNode* vNbrs = graph.getEdgeDstPtr(
+        graph.edge_begin(v, galois::MethodFlag::UNPROTECTED));
+    size_t vLower =
+        std::upper_bound(vNbrs, vNbrs + graph.getDegree(v), v) - vNbrs;
+    numTriangles_local +=
+        galois::intersection::count(vNbrs, vLower, nNbrs, nDegree);
   }
   numTriangles += numTriangles_local;
 }
@@ -217,6 +217,9 @@ struct BFS {
     else
       priority = 0;
     DGTerminatorDetector dga;
+    if constexpr (async) {
+      dga.setStalenessBound(asyncStaleness);
+    }
     DGAccumulatorTy work_edges;
 
     do {
@@ -183,6 +183,9 @@ struct ConnectedComp {
 
     unsigned _num_iterations = 1;
     DGTerminatorDetector dga;
+    if constexpr (async) {
+      dga.setStalenessBound(asyncStaleness);
+    }
 
     const auto& nodesWithEdges = _graph.allNodesWithEdgesRange();
 
@@ -215,6 +215,9 @@ struct SSSP {
     else
       priority = 0;
     DGTerminatorDetector dga;
+    if constexpr (async) {
+      dga.setStalenessBound(asyncStaleness);
+    }
     DGAccumulatorTy work_edges;
 
     do {
@@ -42,11 +42,12 @@ enum PARTITIONING_SCHEME {
   CART_VCUT,     //!< cartesian vertex cut
   CART_VCUT_IEC, //!< cartesian vertex cut using iec
   // CEC,                   //!< custom edge cut
-  GINGER_O, //!< Ginger, outgoing
-  GINGER_I, //!< Ginger, incoming
-  FENNEL_O, //!< Fennel, oec
-  FENNEL_I, //!< Fennel, iec
-  SUGAR_O   //!< Sugar, oec
+  GINGER_O,    //!< Ginger, outgoing
+  GINGER_I,    //!< Ginger, incoming
+  FENNEL_O,    //!< Fennel, oec
+  FENNEL_I,    //!< Fennel, iec
+  SUGAR_O,     //!< Sugar, oec
+  MULTILEVEL_O //!< Multi-level, oec
 };
 
 /**
@@ -81,6 +82,8 @@ inline const char* EnumToString(PARTITIONING_SCHEME e) {
     return "fennel-iec";
   case SUGAR_O:
     return "sugar-oec";
+  case MULTILEVEL_O:
+    return "multilevel-oec";
   default:
     GALOIS_DIE("unsupported partition scheme: ", e);
   }
@@ -109,6 +112,8 @@ extern cll::opt<std::string> localGraphFileName;
 extern cll::opt<bool> saveLocalGraph;
 //! file specifying blocking of masters
 extern cll::opt<std::string> mastersFile;
+//! max edges resident at once on a host while streaming partitioning input
+extern cll::opt<uint64_t> partitionStreamChunk;
 
 // @todo command line argument for read balancing across hosts
 
@@ -120,6 +125,29 @@ template <typename NodeData, typename EdgeData>
 using DistGraphPtr =
     std::unique_ptr<galois::graphs::DistGraph<NodeData, EdgeData>>;
 
+/**
+ * Partitions the input graph specified on the command line with CuSP.
+ *
+ * @tparam PartitionPolicy partitioning policy to use
+ * @tparam NodeData node data to store in graph
+ * @tparam EdgeData edge data to store in graph
+ * @param inputType format (CSR or CSC) of the graph to read
+ * @param outputType format (CSR or CSC) of the partitions to create
+ * @param symmetric true if the input graph is symmetric
+ * @param masterBlockFile file specifying blocking of masters
+ * @returns a pointer to a newly allocated DistGraph
+ */
+template <typename PartitionPolicy, typename NodeData, typename EdgeData>
+DistGraphPtr<NodeData, EdgeData>
+cuspPartitionInput(galois::CUSP_GRAPH_TYPE inputType,
+                   galois::CUSP_GRAPH_TYPE outputType, bool symmetric,
+                   std::string masterBlockFile = "") {
+  return galois::cuspPartitionGraph<PartitionPolicy, NodeData, EdgeData>(
+      inputFile, inputType, outputType, symmetric, inputFileTranspose,
+      masterBlockFile, true, 100, galois::graphs::BALANCED_EDGES_OF_MASTERS, 0,
+      0, partitionStreamChunk);
+}
+
 /**
  * Loads a symmetric graph file (i.e. directed graph with edges in both
  * directions)
@@ -142,20 +170,17 @@ constructSymmetricGraph(std::vector<unsigned>& GALOIS_UNUSED(scaleFactor)) {
   switch (partitionScheme) {
   case OEC:
   case IEC:
-    return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true, inputFileTranspose,
-        mastersFile);
+    return cuspPartitionInput<NoCommunication, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true, mastersFile);
   case HOVC:
   case HIVC:
-    return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return cuspPartitionInput<GenericHVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
 
   case CART_VCUT:
   case CART_VCUT_IEC:
-    return galois::cuspPartitionGraph<GenericCVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return cuspPartitionInput<GenericCVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
 
     // case CEC:
     //  return new Graph_customEdgeCut(inputFile, "", net.ID, net.Num,
@@ -163,20 +188,21 @@ constructSymmetricGraph(std::vector<unsigned>& GALOIS_UNUSED(scaleFactor)) {
 
   case GINGER_O:
   case GINGER_I:
-    return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return cuspPartitionInput<GingerP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
 
   case FENNEL_O:
   case FENNEL_I:
-    return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return cuspPartitionInput<FennelP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
 
   case SUGAR_O:
-    return galois::cuspPartitionGraph<SugarP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return cuspPartitionInput<SugarP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
+
+  case MULTILEVEL_O:
+    return cuspPartitionInput<MultilevelP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
   default:
     GALOIS_DIE("partition scheme specified is invalid: ", partitionScheme);
     return DistGraphPtr<NodeData, EdgeData>(nullptr);
@@ -203,50 +229,43 @@ constructGraph(std::vector<unsigned>& GALOIS_UNUSED(scaleFactor)) {
   // 1 host = no concept of cut; just load from edgeCut, no transpose
   auto& net = galois::runtime::getSystemNetworkInterface();
   if (net.Num == 1) {
-    return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return cuspPartitionInput<NoCommunication, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
   }
 
   switch (partitionScheme) {
   case OEC:
-    return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose, mastersFile);
+    return cuspPartitionInput<NoCommunication, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false, mastersFile);
   case IEC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose, mastersFile);
+      return cuspPartitionInput<NoCommunication, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false, mastersFile);
     } else {
       GALOIS_DIE("incoming edge cut requires transpose graph");
       break;
     }
 
   case HOVC:
-    return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return cuspPartitionInput<GenericHVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
   case HIVC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose);
+      return cuspPartitionInput<GenericHVC, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false);
     } else {
       GALOIS_DIE("incoming hybrid cut requires transpose graph");
       break;
     }
 
   case CART_VCUT:
-    return galois::cuspPartitionGraph<GenericCVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return cuspPartitionInput<GenericCVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
 
   case CART_VCUT_IEC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GenericCVC, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose);
+      return cuspPartitionInput<GenericCVC, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false);
     } else {
       GALOIS_DIE("cvc incoming cut requires transpose graph");
       break;
@@ -257,37 +276,36 @@ constructGraph(std::vector<unsigned>& GALOIS_UNUSED(scaleFactor)) {
     //                                 scaleFactor, vertexIDMapFileName, false);
 
   case GINGER_O:
-    return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return cuspPartitionInput<GingerP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
   case GINGER_I:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose);
+      return cuspPartitionInput<GingerP, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false);
     } else {
       GALOIS_DIE("Ginger requires transpose graph");
       break;
     }
 
   case FENNEL_O:
-    return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return cuspPartitionInput<FennelP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
   case FENNEL_I:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose);
+      return cuspPartitionInput<FennelP, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false);
     } else {
       GALOIS_DIE("Fennel requires transpose graph");
       break;
     }
 
   case SUGAR_O:
-    return galois::cuspPartitionGraph<SugarP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return cuspPartitionInput<SugarP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
+
+  case MULTILEVEL_O:
+    return cuspPartitionInput<MultilevelP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
 
   default:
     GALOIS_DIE("partition scheme specified is invalid: ", partitionScheme);
@@ -317,96 +335,86 @@ DistGraphPtr<NodeData, EdgeData> constructGraph(std::vector<unsigned>&) {
   // 1 host = no concept of cut; just load from edgeCut
   if (net.Num == 1) {
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return cuspPartitionInput<NoCommunication, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false);
     } else {
       fprintf(stderr, "WARNING: Loading transpose graph through in-memory "
                       "transpose to iterate over in-edges: pass in transpose "
                       "graph with -graphTranspose to avoid unnecessary "
                       "overhead.\n");
-      return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return cuspPartitionInput<NoCommunication, NodeData, EdgeData>(
+          galois::CUSP_CSR, galois::CUSP_CSC, false);
     }
   }
 
   switch (partitionScheme) {
   case OEC:
-    return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose, mastersFile);
+    return cuspPartitionInput<NoCommunication, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false, mastersFile);
   case IEC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose, mastersFile);
+      return cuspPartitionInput<NoCommunication, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false, mastersFile);
     } else {
       GALOIS_DIE("iec requires transpose graph");
       break;
     }
 
   case HOVC:
-    return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return cuspPartitionInput<GenericHVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
   case HIVC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return cuspPartitionInput<GenericHVC, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false);
     } else {
       GALOIS_DIE("hivc requires transpose graph");
       break;
     }
 
   case CART_VCUT:
-    return galois::cuspPartitionGraph<GenericCVCColumnFlip, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return cuspPartitionInput<GenericCVCColumnFlip, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
   case CART_VCUT_IEC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GenericCVCColumnFlip, NodeData,
-                                        EdgeData>(inputFile, galois::CUSP_CSC,
-                                                  galois::CUSP_CSC, false,
-                                                  inputFileTranspose);
+      return cuspPartitionInput<GenericCVCColumnFlip, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false);
     } else {
       GALOIS_DIE("cvc requires transpose graph");
       break;
     }
 
   case GINGER_O:
-    return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return cuspPartitionInput<GingerP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
   case GINGER_I:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return cuspPartitionInput<GingerP, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false);
     } else {
       GALOIS_DIE("Ginger requires transpose graph");
       break;
     }
 
   case FENNEL_O:
-    return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return cuspPartitionInput<FennelP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
   case FENNEL_I:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return cuspPartitionInput<FennelP, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false);
     } else {
       GALOIS_DIE("Fennel requires transpose graph");
       break;
     }
 
   case SUGAR_O:
-    return galois::cuspPartitionGraph<SugarColumnFlipP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return cuspPartitionInput<SugarColumnFlipP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
+
+  case MULTILEVEL_O:
+    return cuspPartitionInput<MultilevelP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
 
   default:
     GALOIS_DIE("partition scheme specified is invalid: ", partitionScheme);
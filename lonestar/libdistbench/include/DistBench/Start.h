@@ -45,6 +45,12 @@ extern cll::opt<std::string> statFile;
 extern cll::opt<bool> partitionAgnostic;
 //! Set method for metadata sends
 extern cll::opt<DataCommMode> commMetadata;
+//! Hosts per group when routing sync messages through a two-level hierarchy
+extern cll::opt<unsigned> commGroupSize;
+//! If set, hosts agree on who has updates before a sync and skip empty sends
+extern cll::opt<bool> elideEmptySyncs;
+//! Max rounds a host may run ahead of the slowest host in async execution
+extern cll::opt<unsigned> asyncStaleness;
 //! Where to write output if output is set
 extern cll::opt<std::string> outputLocation;
 extern cll::opt<bool> output;
@@ -237,7 +243,8 @@ distGraphInitialization() {
   const auto& net = galois::runtime::getSystemNetworkInterface();
   s = std::make_unique<Substrate>(*g, net.ID, net.Num, g->isTransposed(),
                                   g->cartesianGrid(), partitionAgnostic,
-                                  commMetadata);
+                                  commMetadata, commGroupSize,
+                                  elideEmptySyncs);
 
 // marshal graph to GPU as necessary
 #ifdef GALOIS_ENABLE_GPU
@@ -282,7 +289,8 @@ symmetricDistGraphInitialization() {
   const auto& net = galois::runtime::getSystemNetworkInterface();
   s = std::make_unique<Substrate>(*g, net.ID, net.Num, g->isTransposed(),
                                   g->cartesianGrid(), partitionAgnostic,
-                                  commMetadata);
+                                  commMetadata, commGroupSize,
+                                  elideEmptySyncs);
 
 // marshal graph to GPU as necessary
 #ifdef GALOIS_ENABLE_GPU
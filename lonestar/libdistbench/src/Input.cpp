@@ -57,7 +57,9 @@ cll::opt<PARTITIONING_SCHEME> partitionScheme(
         clEnumValN(FENNEL_I, "fennel-i",
                    "fennel, incoming edge cut, using CuSP"),
         clEnumValN(SUGAR_O, "sugar-o",
-                   "fennel, incoming edge cut, using CuSP")),
+                   "fennel, incoming edge cut, using CuSP"),
+        clEnumValN(MULTILEVEL_O, "multilevel-o",
+                   "multi-level, outgoing edge cut, using CuSP")),
     cll::init(OEC));
 
 cll::opt<bool> readFromFile("readFromFile",
@@ -80,3 +82,10 @@ cll::opt<bool> saveLocalGraph("saveLocalGraph",
 cll::opt<std::string> mastersFile("mastersFile",
                                   cll::desc("File specifying masters blocking"),
                                   cll::init(""), cll::Hidden);
+
+cll::opt<uint64_t> partitionStreamChunk(
+    "partitionStreamChunk",
+    cll::desc("Max number of edges a host keeps in memory at once while "
+              "streaming its part of the input during partitioning (0 reads "
+              "the host's whole edge range up front)"),
+    cll::init(0));
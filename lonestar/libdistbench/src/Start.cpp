@@ -54,6 +54,28 @@ cll::opt<DataCommMode> commMetadata(
                            "non-updated values)")),
     cll::init(noData), cll::Hidden);
 
+cll::opt<unsigned> commGroupSize(
+    "commGroupSize",
+    cll::desc("Number of consecutive hosts (e.g., hosts on the same machine) "
+              "grouped together to route sync messages through a two-level "
+              "hierarchy: messages are bundled within a group first, then "
+              "sent once per group to other groups (default 0 sends directly "
+              "to every host)"),
+    cll::init(0));
+
+cll::opt<bool> elideEmptySyncs(
+    "elideEmptySyncs",
+    cll::desc("Before each sync, hosts agree on which hosts have updates for "
+              "which and skip empty messages (helps rounds where few proxies "
+              "change)"),
+    cll::init(false));
+
+cll::opt<unsigned> asyncStaleness(
+    "asyncStaleness",
+    cll::desc("Max number of rounds a host may run ahead of the slowest host "
+              "in asynchronous (BASP) execution (default 0 is unbounded)"),
+    cll::init(0));
+
 cll::opt<std::string> outputLocation(
     "outputLocation",
     cll::desc("Location (directory) to write results to when output is true"));
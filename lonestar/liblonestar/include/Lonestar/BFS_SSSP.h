@@ -22,6 +22,8 @@
 #include <iostream>
 #include <cstdlib>
 
+#include "galois/EdgeTiles.h"
+
 template <typename Graph, typename _DistLabel, bool USE_EDGE_WT,
           ptrdiff_t EDGE_TILE_SIZE = 256>
 struct BFS_SSSP {
@@ -80,20 +82,8 @@ struct BFS_SSSP {
 
   template <typename WL, typename TileMaker>
   static void pushEdgeTiles(WL& wl, EI beg, const EI end, const TileMaker& f) {
-    assert(beg <= end);
-
-    if ((end - beg) > EDGE_TILE_SIZE) {
-      for (; beg + EDGE_TILE_SIZE < end;) {
-        auto ne = beg + EDGE_TILE_SIZE;
-        assert(ne < end);
-        wl.push(f(beg, ne));
-        beg = ne;
-      }
-    }
-
-    if ((end - beg) > 0) {
-      wl.push(f(beg, end));
-    }
+    galois::splitEdgeTiles(beg, end, EDGE_TILE_SIZE,
+                           [&](EI b, EI e) { wl.push(f(b, e)); });
   }
 
   template <typename WL, typename TileMaker>
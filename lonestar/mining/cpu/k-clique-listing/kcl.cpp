@@ -1,5 +1,6 @@
 #include "MiningBench/Start.h"
 #include "pangolin/BfsMining/vertex_miner.h"
+#include "pangolin/bitmap_graph.h"
 
 const char* name = "Kcl";
 const char* desc = "Listing cliques of size k in a graph using BFS extension";
@@ -23,14 +24,39 @@ class AppMiner : public VertexMiner<SimpleElement, BaseEmbedding, MyAPI, true> {
 public:
   AppMiner(unsigned ms, int nt)
       : VertexMiner<SimpleElement, BaseEmbedding, MyAPI, true>(ms, nt,
-                                                               nblocks) {
+                                                               nblocks, dfs) {
     if (ms <= 2) {
       printf("ERROR: command line argument k must be 3 or greater\n");
       exit(1);
     }
     set_num_patterns(1);
+    set_sampling(approx, approx_time);
   }
   ~AppMiner() {}
+  void solver() {
+    if (bitmap && !is_sampling())
+      bitmap_solver();
+    else
+      VertexMiner<SimpleElement, BaseEmbedding, MyAPI, true>::solver();
+  }
+  // vertex parallel: every vertex lists the cliques it starts in a bitmap of
+  // the subgraph induced by its out-neighbors
+  void bitmap_solver() {
+    galois::substrate::PerThreadStorage<BitmapGraph> local_graphs;
+    galois::do_all(
+        galois::iterate(this->graph.begin(), this->graph.end()),
+        [&](const GNode& v) {
+          BitmapGraph* local_graph = local_graphs.getLocal();
+          if (std::distance(this->graph.edge_begin(v),
+                            this->graph.edge_end(v)) < this->max_size - 1)
+            return;
+          local_graph->build(this->graph, v);
+          this->accumulators[0] +=
+              local_graph->count_cliques(this->max_size - 1);
+        },
+        galois::chunk_size<CHUNK_SIZE>(), galois::steal(),
+        galois::loopname("Bitmap-cliques"));
+  }
   void print_output() {
     std::cout << "\n\ttotal_num_cliques = " << get_total_count() << "\n";
   }
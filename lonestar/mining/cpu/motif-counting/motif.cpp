@@ -23,12 +23,13 @@ class AppMiner : public VertexMiner<SimpleElement, VertexEmbedding, MyAPI,
 public:
   AppMiner(unsigned ms, int nt)
       : VertexMiner<SimpleElement, VertexEmbedding, MyAPI, false, false, true>(
-            ms, nt, nblocks) {
+            ms, nt, nblocks, dfs) {
     if (ms <= 2) {
       printf("ERROR: command line argument k must be 3 or greater\n");
       exit(1);
     }
     set_num_patterns(num_patterns[k - 3]);
+    set_sampling(approx, approx_time);
   }
   ~AppMiner() {}
   void print_output() { printout_motifs(); }
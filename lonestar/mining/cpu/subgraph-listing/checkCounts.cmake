@@ -0,0 +1,25 @@
+# Runs APP and REFERENCE with the same ARGS and fails unless both list the
+# same number of subgraphs.
+#
+#   cmake -DAPP=<exe> -DREFERENCE=<exe> "-DARGS=<arg;...>" -P checkCounts.cmake
+
+function(count_subgraphs exe result)
+  execute_process(COMMAND ${exe} ${ARGS}
+    OUTPUT_VARIABLE output RESULT_VARIABLE status)
+  if (NOT status EQUAL 0)
+    message(FATAL_ERROR "${exe} failed (${status}):\n${output}")
+  endif()
+  string(REGEX MATCH "total_num_subgraphs = ([0-9]+)" match "${output}")
+  if (NOT match)
+    message(FATAL_ERROR "${exe} printed no subgraph count:\n${output}")
+  endif()
+  set(${result} ${CMAKE_MATCH_1} PARENT_SCOPE)
+endfunction()
+
+count_subgraphs(${APP} app_count)
+count_subgraphs(${REFERENCE} reference_count)
+if (NOT app_count EQUAL reference_count)
+  message(FATAL_ERROR
+    "${APP} lists ${app_count} subgraphs, ${REFERENCE} lists ${reference_count}")
+endif()
+message(STATUS "Both list ${app_count} subgraphs")
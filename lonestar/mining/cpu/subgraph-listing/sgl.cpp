@@ -0,0 +1,53 @@
+#include "MiningBench/Start.h"
+#include "pangolin/util.h"
+#include "pangolin/res_man.h"
+#include "pangolin/matching_plan.h"
+
+const char* name = "Sgl";
+const char* desc = "Listing the subgraphs of an arbitrary pattern in a graph "
+                   "using a matching plan compiled from the pattern";
+const char* url  = nullptr;
+
+static cll::opt<std::string>
+    pattern_filetype("pft", cll::desc("<pattern filetype: txt,adj,mtx,gr>"),
+                     cll::init("txt"));
+static cll::opt<bool>
+    induced("induced",
+            cll::desc("list vertex-induced instead of edge-induced subgraphs"),
+            cll::init(false));
+
+int main(int argc, char** argv) {
+  galois::SharedMemSys G;
+  LonestarMineStart(argc, argv, name, desc, url);
+  if (pattern_filename == "")
+    GALOIS_DIE("need specify pattern file name using -p");
+
+  galois::StatTimer totalTime("TimerTotal");
+  totalTime.start();
+
+  PangolinGraph graph, pattern;
+  galois::StatTimer Tinitial("GraphReadingTime");
+  Tinitial.start();
+  util::read_graph(graph, filetype, inputFile);
+  util::read_graph(pattern, pattern_filetype, pattern_filename);
+  Tinitial.stop();
+
+  MatchingPlan plan(pattern, induced);
+  if (show)
+    plan.print(std::cout);
+
+  ResourceManager rm;
+  PlanExecutor executor(graph, plan);
+  for (unsigned nt = 0; nt < num_trials; nt++) {
+    galois::StatTimer execTime("Timer_0");
+    execTime.start();
+    Ulong total = executor.count();
+    execTime.stop();
+    std::cout << "\n\ttotal_num_subgraphs = " << total << "\n";
+  }
+  std::cout << "\n\t" << rm.get_peak_memory() << "\n\n";
+
+  totalTime.stop();
+
+  return 0;
+}
@@ -41,8 +41,10 @@ class AppMiner
     : public VertexMiner<SimpleElement, BaseEmbedding, MyAPI, 0, 1, 0, 1> {
 public:
   AppMiner(unsigned ms, int nt)
-      : VertexMiner<SimpleElement, BaseEmbedding, MyAPI, 0, 1, 0, 1>(ms, nt,
-                                                                     nblocks) {}
+      : VertexMiner<SimpleElement, BaseEmbedding, MyAPI, 0, 1, 0, 1>(
+            ms, nt, nblocks, dfs) {
+    set_num_patterns(1);
+  }
   ~AppMiner() {}
   void print_output() {
     std::cout << "\n\ttotal_num_subgraphs = " << get_total_count() << "\n";
@@ -31,6 +31,7 @@ public:
       exit(1);
     }
     set_num_patterns(1);
+    set_sampling(approx, approx_time);
   }
   ~AppMiner() {}
   void print_output() {
@@ -4,8 +4,14 @@
 namespace cll = llvm::cl;
 extern cll::opt<std::string> inputFile;
 extern cll::opt<std::string> filetype;
+extern cll::opt<std::string> dag_order;
+extern cll::opt<std::string> dag_cache;
 extern cll::opt<unsigned> num_trials;
 extern cll::opt<unsigned> nblocks;
+extern cll::opt<bool> dfs;
+extern cll::opt<bool> bitmap;
+extern cll::opt<double> approx;
+extern cll::opt<double> approx_time;
 extern cll::opt<std::string> pattern_filename;
 extern cll::opt<std::string> morder_filename;
 extern cll::opt<unsigned> fv;
@@ -10,12 +10,43 @@
 namespace cll = llvm::cl;
 cll::opt<std::string> filetype("ft", cll::desc("<filetype: txt,adj,mtx,gr>"),
                                cll::init("gr"));
+cll::opt<std::string>
+    dag_order("dag_order",
+              cll::desc("<DAG ordering for apps that orient the input: "
+                        "degree,core> (core relabels by degeneracy order)"),
+              cll::init("degree"));
+cll::opt<std::string>
+    dag_cache("dag_cache",
+              cll::desc("<filename: core-ordered DAG, read if it exists, "
+                        "written otherwise>"),
+              cll::init(""));
 cll::opt<unsigned> num_trials("n",
                               cll::desc("perform n trials (default value 1)"),
                               cll::init(1));
 cll::opt<unsigned>
     nblocks("b", cll::desc("edge blocking to b blocks (default value 1)"),
             cll::init(1));
+cll::opt<bool>
+    dfs("dfs",
+        cll::desc("extend each single-edge embedding depth-first instead of "
+                  "materializing every level (uses far less memory)"),
+        cll::init(false));
+cll::opt<bool>
+    bitmap("bitmap",
+           cll::desc("list cliques in a bitmap of each vertex's "
+                     "out-neighborhood (for k-clique listing)"),
+           cll::init(false));
+cll::opt<double>
+    approx("approx",
+           cll::desc("estimate counts by sampling until the 95% confidence "
+                     "interval is within this relative error, e.g. 0.01 "
+                     "(default value 0: exact)"),
+           cll::init(0));
+cll::opt<double>
+    approx_time("approx_time",
+                cll::desc("estimate counts by sampling for at most this many "
+                          "seconds (default value 0: no limit)"),
+                cll::init(0));
 cll::opt<std::string>
     pattern_filename("p",
                      cll::desc("<pattern graph filename: symmetrized graph>"),